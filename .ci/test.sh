@@ -63,7 +63,17 @@ PLUGINS=(
     "zeddemux"
     "zeddatamux"
     "zeddatacsvsink"
+    "zeddatacolumnarsink"
+    "zeddatashmsink"
     "zedodoverlay"
+    "zeddepthenc"
+    "zeddepthdec"
+    "zeddepthpack"
+    "zeddepthunpack"
+    "zeddepthfilter"
+    "zeddepthdecimate"
+    "zedpointcloud"
+    "zedheightmap"
 )
 
 # Timeout values (seconds)
@@ -315,7 +325,7 @@ test_plugin_properties() {
     print_subheader "Plugin Properties Tests"
     
     # zedsrc properties
-    local zedsrc_props=("camera-resolution" "camera-fps" "stream-type" "depth-mode" "od-enabled" "bt-enabled")
+    local zedsrc_props=("camera-resolution" "camera-fps" "stream-type" "depth-mode" "od-enabled" "bt-enabled" "timing-meta" "sensors-batch-size")
     for prop in "${zedsrc_props[@]}"; do
         if gst-inspect-1.0 zedsrc 2>&1 | grep -q "$prop"; then
             test_pass "zedsrc has property '$prop'"
@@ -345,7 +355,7 @@ test_plugin_properties() {
     done
     
     # zeddatacsvsink properties
-    local csvsink_props=("location" "append")
+    local csvsink_props=("location" "append" "max-size-bytes" "max-duration")
     for prop in "${csvsink_props[@]}"; do
         if gst-inspect-1.0 zeddatacsvsink 2>&1 | grep -q "$prop"; then
             test_pass "zeddatacsvsink has property '$prop'"
@@ -353,6 +363,26 @@ test_plugin_properties() {
             test_fail "zeddatacsvsink has property '$prop'"
         fi
     done
+    
+    # zedodoverlay properties
+    local overlay_props=("overlay-mode" "allow-missing-meta" "render-threads" "anti-aliasing")
+    for prop in "${overlay_props[@]}"; do
+        if gst-inspect-1.0 zedodoverlay 2>&1 | grep -q "$prop"; then
+            test_pass "zedodoverlay has property '$prop'"
+        else
+            test_fail "zedodoverlay has property '$prop'"
+        fi
+    done
+    
+    # zeddatashmsink properties
+    local shmsink_props=("shm-name" "num-slots" "max-record-size" "unlink")
+    for prop in "${shmsink_props[@]}"; do
+        if gst-inspect-1.0 zeddatashmsink 2>&1 | grep -q "$prop"; then
+            test_pass "zeddatashmsink has property '$prop'"
+        else
+            test_fail "zeddatashmsink has property '$prop'"
+        fi
+    done
 }
 
 test_plugin_factory() {
@@ -392,7 +422,7 @@ test_zedsrc_enums() {
     done
     
     # Test stream-type enum values
-    local stream_types=("Left image" "Right image" "Stereo couple" "Depth image")
+    local stream_types=("Left image" "Right image" "Stereo couple" "Depth image" "Depth map" "Confidence map")
     for stype in "${stream_types[@]}"; do
         if gst-inspect-1.0 zedsrc 2>&1 | grep -q "$stype"; then
             test_pass "zedsrc has stream-type '$stype'"
@@ -500,6 +530,20 @@ test_element_pads() {
         test_fail "zedsrc has SRC pad template"
     fi
     
+    if gst-inspect-1.0 zedsrc 2>&1 | grep -q "application/x-zed-sensors"; then
+        test_pass "zedsrc has sensors request pad template"
+    else
+        test_fail "zedsrc has sensors request pad template"
+    fi
+    
+    for pad in right depth data; do
+        if gst-inspect-1.0 zedsrc 2>&1 | grep -q "SRC template: '$pad'"; then
+            test_pass "zedsrc has $pad request pad template"
+        else
+            test_fail "zedsrc has $pad request pad template"
+        fi
+    done
+    
     # Check zeddemux has sink and src pads
     if gst-inspect-1.0 zeddemux 2>&1 | grep -q "SINK template"; then
         test_pass "zeddemux has SINK pad template"
@@ -519,6 +563,134 @@ test_element_pads() {
     else
         test_fail "zedodoverlay has SINK pad template"
     fi
+    
+    # Frames without GstZedSrcMeta are forwarded untouched when allowed
+    if timeout $FAST_PIPELINE_TIMEOUT gst-launch-1.0 videotestsrc num-buffers=30 ! video/x-raw,format=BGRA ! \
+        zedodoverlay allow-missing-meta=true ! fakesink > /dev/null 2>&1; then
+        test_pass "zedodoverlay allow-missing-meta=true on a stream without metadata"
+    else
+        test_fail "zedodoverlay allow-missing-meta=true on a stream without metadata"
+    fi
+}
+
+test_depth_elements() {
+    print_subheader "Depth Elements Tests"
+    
+    # Synthetic GRAY16 stream, no camera needed
+    local src="videotestsrc num-buffers=30 pattern=gradient ! video/x-raw,format=GRAY16_LE,width=672,height=376"
+    
+    if timeout $FAST_PIPELINE_TIMEOUT gst-launch-1.0 $src ! zeddepthenc ! zeddepthdec ! fakesink > /dev/null 2>&1; then
+        test_pass "zeddepthenc ! zeddepthdec round trip"
+    else
+        test_fail "zeddepthenc ! zeddepthdec round trip"
+    fi
+    
+    # Byte-exact round trip on depth maps with invalid (zero) runs and random jumps between pixels
+    # and rows, the cases RVL is built for: every row starts with a zero run of random length
+    local raw_in="/tmp/zed_depth_in_$$.raw"
+    local raw_out="/tmp/zed_depth_out_$$.raw"
+    if gst-inspect-1.0 rawvideoparse > /dev/null 2>&1; then
+        : > "$raw_in"
+        local row zeros
+        for row in $(seq 1 $((240 * 10))); do
+            zeros=$(( (RANDOM % 321) * 2 ))
+            { head -c $zeros /dev/zero; head -c $((640 - zeros)) /dev/urandom; } >> "$raw_in"
+        done
+        if timeout $FAST_PIPELINE_TIMEOUT gst-launch-1.0 filesrc location="$raw_in" ! \
+            rawvideoparse format=gray16-le width=320 height=240 framerate=30/1 ! \
+            zeddepthenc ! zeddepthdec ! filesink location="$raw_out" > /dev/null 2>&1 && \
+            cmp -s "$raw_in" "$raw_out"; then
+            test_pass "zeddepthenc ! zeddepthdec byte-exact round trip"
+        else
+            test_fail "zeddepthenc ! zeddepthdec byte-exact round trip"
+        fi
+        rm -f "$raw_in" "$raw_out"
+    else
+        skip_test "zeddepthenc ! zeddepthdec byte-exact round trip" "rawvideoparse not available"
+    fi
+    
+    if timeout $FAST_PIPELINE_TIMEOUT gst-launch-1.0 $src ! zeddepthpack packing=HUE ! zeddepthunpack ! fakesink > /dev/null 2>&1; then
+        test_pass "zeddepthpack ! zeddepthunpack HUE round trip"
+    else
+        test_fail "zeddepthpack ! zeddepthunpack HUE round trip"
+    fi
+    
+    if timeout $FAST_PIPELINE_TIMEOUT gst-launch-1.0 $src ! zeddepthpack packing=DUAL_PLANE ! videoconvert ! video/x-raw,format=I420 ! zeddepthunpack ! fakesink > /dev/null 2>&1; then
+        test_pass "zeddepthpack ! zeddepthunpack DUAL_PLANE round trip"
+    else
+        test_fail "zeddepthpack ! zeddepthunpack DUAL_PLANE round trip"
+    fi
+    
+    if timeout $FAST_PIPELINE_TIMEOUT gst-launch-1.0 $src ! zeddepthfilter spatial-iterations=2 threads=2 ! fakesink > /dev/null 2>&1; then
+        test_pass "zeddepthfilter with 2 threads"
+    else
+        test_fail "zeddepthfilter with 2 threads"
+    fi
+    
+    if timeout $FAST_PIPELINE_TIMEOUT gst-launch-1.0 $src ! zeddepthdecimate factor=8 pooling=MEDIAN ! video/x-raw,width=84,height=47 ! fakesink > /dev/null 2>&1; then
+        test_pass "zeddepthdecimate by 8"
+    else
+        test_fail "zeddepthdecimate by 8"
+    fi
+    
+    if timeout $FAST_PIPELINE_TIMEOUT gst-launch-1.0 $src ! zedpointcloud fx=350 fy=350 voxel-size=0.05 threads=2 ! fakesink > /dev/null 2>&1; then
+        test_pass "zedpointcloud with voxel grid"
+    else
+        test_fail "zedpointcloud with voxel grid"
+    fi
+    
+    if timeout $FAST_PIPELINE_TIMEOUT gst-launch-1.0 $src ! zedheightmap fx=350 fy=350 output-rate=5 ! fakesink > /dev/null 2>&1; then
+        test_pass "zedheightmap"
+    else
+        test_fail "zedheightmap"
+    fi
+}
+
+test_zed_tracer() {
+    print_subheader "ZED Tracer Tests"
+    
+    if ! gst-inspect-1.0 zedtracer > /dev/null 2>&1; then
+        test_fail "Tracer 'zedtracer' is registered"
+        return
+    fi
+    test_pass "Tracer 'zedtracer' is registered"
+    
+    # Synthetic pipeline: the queue and the sink are tracked without a camera
+    local output
+    output=$(GST_TRACERS="zedtracer(period=100)" GST_DEBUG="GST_TRACER:7" \
+        timeout $FAST_PIPELINE_TIMEOUT gst-launch-1.0 videotestsrc num-buffers=100 is-live=true ! \
+        queue ! fakesink 2>&1)
+    if echo "$output" | grep -q "zed-element"; then
+        test_pass "zedtracer logs element statistics"
+    else
+        test_fail "zedtracer logs element statistics" "$(echo "$output" | tail -5)"
+    fi
+}
+
+test_zed_bench() {
+    print_subheader "ZED Benchmark Tests"
+    
+    if ! command -v gst-zed-bench > /dev/null 2>&1; then
+        skip_test "gst-zed-bench runs on synthetic streams" "gst-zed-bench not installed"
+        return
+    fi
+    
+    local output
+    output=$(timeout $FAST_PIPELINE_TIMEOUT gst-zed-bench -n 30 -r vga -o 0,16 -s 2 2>&1)
+    if echo "$output" | grep -q "\"fps\""; then
+        test_pass "gst-zed-bench runs on synthetic streams"
+    else
+        test_fail "gst-zed-bench runs on synthetic streams" "$(echo "$output" | tail -5)"
+    fi
+    
+    if command -v gst-zed-microbench > /dev/null 2>&1; then
+        output=$(timeout $FAST_PIPELINE_TIMEOUT gst-zed-microbench -t 10 -n 1 -k meta_ 2>&1)
+        if echo "$output" | grep -q "ns_per_op"; then
+            test_pass "gst-zed-microbench runs the metadata cases"
+        else
+            test_fail "gst-zed-microbench runs the metadata cases" "$(echo "$output" | tail -5)"
+        fi
+    fi
 }
 
 test_hardware_basic() {
@@ -609,6 +781,26 @@ test_hardware_streaming() {
             test_fail "Stream type 4 (left+depth)"
             [ "$VERBOSE" = true ] && echo "$output" | grep -i "error\|fail" | head -3
         fi
+        
+        sleep $CAMERA_RESET_DELAY
+        
+        output=$(timeout "$timeout_val" gst-launch-1.0 zedsrc stream-type=9 depth-mode=1 num-buffers=$num_buffers ! fakesink 2>&1)
+        if [ $? -eq 0 ]; then
+            test_pass "Stream type 9 (depth float)"
+        else
+            test_fail "Stream type 9 (depth float)"
+            [ "$VERBOSE" = true ] && echo "$output" | grep -i "error\|fail" | head -3
+        fi
+        
+        sleep $CAMERA_RESET_DELAY
+        
+        output=$(timeout "$timeout_val" gst-launch-1.0 zedsrc stream-type=10 depth-mode=1 num-buffers=$num_buffers ! fakesink 2>&1)
+        if [ $? -eq 0 ]; then
+            test_pass "Stream type 10 (confidence float)"
+        else
+            test_fail "Stream type 10 (confidence float)"
+            [ "$VERBOSE" = true ] && echo "$output" | grep -i "error\|fail" | head -3
+        fi
     fi
     
     # Test RAW_NV12 stream types (6, 7) - only available on Jetson with GMSL cameras
@@ -699,6 +891,18 @@ test_hardware_demux() {
     fi
     
     sleep $CAMERA_RESET_DELAY
+    
+    # Same views on the zedsrc request pads, without composite frames
+    output=$(timeout "$timeout_val" gst-launch-1.0 zedsrc name=zed stream-type=0 depth-mode=1 num-buffers=$num_buffers \
+        zed.src ! queue ! fakesink zed.right ! queue ! fakesink zed.depth ! queue ! fakesink zed.data ! queue ! fakesink 2>&1)
+    if [ $? -eq 0 ]; then
+        test_pass "zedsrc right/depth/data request pads"
+    else
+        test_fail "zedsrc right/depth/data request pads"
+        [ "$VERBOSE" = true ] && echo "$output" | grep -i "error\|fail" | head -3
+    fi
+    
+    sleep $CAMERA_RESET_DELAY
 }
 
 test_hardware_od() {
@@ -956,6 +1160,19 @@ test_buffer_metadata() {
     fi
     
     sleep $CAMERA_RESET_DELAY
+    
+    # High rate sensors pad: must end with the video stream
+    output=$(timeout "$timeout_val" gst-launch-1.0 zedsrc name=zed num-buffers=$num_buffers \
+        zed.sensors ! queue ! fakesink zed. ! queue ! fakesink 2>&1)
+    
+    if [ $? -eq 0 ]; then
+        test_pass "High rate sensors pad"
+    else
+        test_fail "High rate sensors pad"
+        [ "$VERBOSE" = true ] && echo "$output" | grep -i "error" | head -3
+    fi
+    
+    sleep $CAMERA_RESET_DELAY
 }
 
 test_datamux() {
@@ -2885,6 +3102,9 @@ main() {
     test_zedsrc_enums
     test_zedsrc_nv12
     test_element_pads
+    test_depth_elements
+    test_zed_tracer
+    test_zed_bench
     test_zedxone
     test_zedxone_nv12
     
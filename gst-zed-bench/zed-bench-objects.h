@@ -0,0 +1,84 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef ZED_BENCH_OBJECTS_H
+#define ZED_BENCH_OBJECTS_H
+
+#include <string.h>
+
+#include "gst-zed-meta/gstzedmeta.h"
+
+/* Fill `obj` with a synthetic detected object. Objects are laid out on a 16x16 grid covering the
+ * `width` x `height` frame, skeletons use the BODY_34 format.
+ */
+static inline void zed_bench_fill_object(ZedObjectData &obj, gint id, guint width, guint height,
+                                         gboolean skeleton) {
+    memset(&obj, 0, sizeof(obj));
+
+    const guint cols = 16;
+    guint box_w = MAX(width / cols, 8);
+    guint box_h = MAX(height / cols, 8);
+    guint x = (id % cols) * box_w;
+    guint y = ((id / cols) % cols) * box_h;
+
+    obj.id = id;
+    obj.label = skeleton ? OBJECT_CLASS::PERSON : (OBJECT_CLASS) (id % (int) OBJECT_CLASS::LAST);
+    obj.sublabel = OBJECT_SUBCLASS::PERSON;
+    obj.tracking_state = OBJECT_TRACKING_STATE::OK;
+    obj.action_state = OBJECT_ACTION_STATE::MOVING;
+    obj.confidence = 50.0f + (id % 50);
+
+    obj.position[0] = 0.1f * id;
+    obj.position[1] = 0.0f;
+    obj.position[2] = 2.0f + 0.01f * id;
+    obj.velocity[0] = 0.5f;
+
+    obj.bounding_box_2d[0][0] = x;
+    obj.bounding_box_2d[0][1] = y;
+    obj.bounding_box_2d[1][0] = x + box_w - 1;
+    obj.bounding_box_2d[1][1] = y;
+    obj.bounding_box_2d[2][0] = x + box_w - 1;
+    obj.bounding_box_2d[2][1] = y + box_h - 1;
+    obj.bounding_box_2d[3][0] = x;
+    obj.bounding_box_2d[3][1] = y + box_h - 1;
+
+    obj.dimensions[0] = 0.5f;
+    obj.dimensions[1] = 1.8f;
+    obj.dimensions[2] = 0.3f;
+
+    obj.skeletons_avail = skeleton;
+    if (skeleton) {
+        obj.skel_format = 34;
+        for (int k = 0; k < obj.skel_format; k++) {
+            obj.keypoint_2d[k][0] = x + (gfloat) box_w * (k % 6) / 6.0f;
+            obj.keypoint_2d[k][1] = y + (gfloat) box_h * k / obj.skel_format;
+            obj.keypoint_3d[k][0] = obj.position[0];
+            obj.keypoint_3d[k][1] = obj.position[1] + 0.05f * k;
+            obj.keypoint_3d[k][2] = obj.position[2];
+        }
+        for (int c = 0; c < 4; c++) {
+            obj.head_bounding_box_2d[c][0] = x + (c == 1 || c == 2 ? box_w / 4 : 0);
+            obj.head_bounding_box_2d[c][1] = y + (c >= 2 ? box_h / 4 : 0);
+        }
+    }
+}
+
+#endif   // ZED_BENCH_OBJECTS_H
@@ -0,0 +1,417 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+// Synthetic benchmark of the ZED GStreamer elements.
+//
+// A `videotestsrc` stream, with the same caps of a `zedsrc` Left/Right stream, is decorated with a
+// GstZedSrcMeta holding a configurable number of detected objects and skeletons, then processed by
+// `zeddemux`, `zeddatamux`, `zedodoverlay` and `zeddatacsvsink`. No camera and no ZED SDK runtime
+// are required, so the benchmark can run on any Linux CI machine.
+//
+// The results (throughput, latency percentiles, CPU time and peak RSS) are printed in JSON format.
+
+#include <glib/gstdio.h>
+#include <gst/gst.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gst-zed-meta/gstzedmeta.h"
+#include "zed-bench-objects.h"
+
+#define DEFAULT_FRAMES 300
+#define DEFAULT_RESOLUTION "hd720"
+#define DEFAULT_OBJECTS "0,16,256"
+#define DEFAULT_SKELETONS 0
+
+static gint frames = DEFAULT_FRAMES;
+static gchar *resolution = (gchar *) DEFAULT_RESOLUTION;
+static gchar *objects = (gchar *) DEFAULT_OBJECTS;
+static gint skeletons = DEFAULT_SKELETONS;
+static gboolean no_overlay = FALSE;
+static gboolean no_csv = FALSE;
+static gchar *output = NULL;
+
+static GOptionEntry entries[] = {
+    {"frames", 'n', 0, G_OPTION_ARG_INT, &frames,
+     "Number of frames of each run (default: 300)", "N"},
+    {"resolution", 'r', 0, G_OPTION_ARG_STRING, &resolution,
+     "Frame size: vga, hd720, hd1080 or hd2k (default: " DEFAULT_RESOLUTION ")", "RES"},
+    {"objects", 'o', 0, G_OPTION_ARG_STRING, &objects,
+     "Comma separated list of detected object counts, one run each (default: " DEFAULT_OBJECTS
+     ")",
+     "LIST"},
+    {"skeletons", 's', 0, G_OPTION_ARG_INT, &skeletons,
+     "Number of skeletons added to each frame (default: 0)", "N"},
+    {"no-overlay", 0, 0, G_OPTION_ARG_NONE, &no_overlay, "Do not use the zedodoverlay element",
+     NULL},
+    {"no-csv", 0, 0, G_OPTION_ARG_NONE, &no_csv, "Do not use the zeddatacsvsink element", NULL},
+    {"output", 'f', 0, G_OPTION_ARG_FILENAME, &output,
+     "Write the JSON results to FILE instead of the standard output", "FILE"},
+    {NULL}};
+
+struct BenchRun {
+    guint obj_count;
+    guint skel_count;
+    guint width;
+    guint height;
+
+    // Monotonic time [us] of the injection of the metadata, indexed by frame ID
+    std::vector<gint64> inject_time;
+    std::vector<gint64> latencies;
+    gint64 first_inject;
+    gint64 last_output;
+    guint64 out_frames;
+
+    std::vector<ZedObjectData> od_objects;
+    std::vector<ZedObjectData> bt_objects;
+};
+
+// ----> Synthetic metadata
+static GstPadProbeReturn inject_meta(GstPad *pad, GstPadProbeInfo *info, gpointer user_data) {
+    BenchRun *run = static_cast<BenchRun *>(user_data);
+
+    GstBuffer *buf = gst_buffer_make_writable(GST_PAD_PROBE_INFO_BUFFER(info));
+    guint64 frame_id = GST_BUFFER_OFFSET(buf);
+
+    ZedInfo zinfo;
+    zinfo.cam_model = 1;     // ZED 2
+    zinfo.stream_type = 2;   // Left/Right
+    zinfo.grab_single_frame_width = run->width;
+    zinfo.grab_single_frame_height = run->height;
+
+    ZedPose pose;
+    memset(&pose, 0, sizeof(pose));
+    pose.pose_avail = TRUE;
+    pose.pos[2] = 0.01f * frame_id;
+
+    ZedSensors sens;
+    memset(&sens, 0, sizeof(sens));
+    sens.sens_avail = TRUE;
+    sens.imu.imu_avail = TRUE;
+    sens.imu.acc[2] = 9.81f;
+
+    gint64 now = g_get_monotonic_time();
+    gst_buffer_add_zed_src_meta_full(buf, zinfo, pose, sens, run->obj_count + run->skel_count > 0,
+                                     run->obj_count, run->od_objects.data(), run->skel_count,
+                                     run->bt_objects.data(), frame_id);
+
+    if (frame_id < run->inject_time.size()) {
+        run->inject_time[frame_id] = now;
+    }
+    if (run->first_inject == 0) {
+        run->first_inject = now;
+    }
+
+    GST_PAD_PROBE_INFO_DATA(info) = buf;
+    return GST_PAD_PROBE_OK;
+}
+// <---- Synthetic metadata
+
+static void sink_handoff(GstElement *sink, GstBuffer *buf, GstPad *pad, gpointer user_data) {
+    BenchRun *run = static_cast<BenchRun *>(user_data);
+    gint64 now = g_get_monotonic_time();
+
+    run->out_frames++;
+    run->last_output = now;
+
+    GstZedSrcMeta *meta = (GstZedSrcMeta *) gst_buffer_get_meta(buf, GST_ZED_SRC_META_API_TYPE);
+    if (meta && meta->frame_id < run->inject_time.size() && run->inject_time[meta->frame_id] > 0) {
+        run->latencies.push_back(now - run->inject_time[meta->frame_id]);
+    }
+}
+
+static gboolean get_frame_size(const gchar *res, guint &width, guint &height) {
+    if (g_strcmp0(res, "vga") == 0) {
+        width = 672;
+        height = 376;
+    } else if (g_strcmp0(res, "hd720") == 0) {
+        width = 1280;
+        height = 720;
+    } else if (g_strcmp0(res, "hd1080") == 0) {
+        width = 1920;
+        height = 1080;
+    } else if (g_strcmp0(res, "hd2k") == 0) {
+        width = 2208;
+        height = 1242;
+    } else {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static double percentile(const std::vector<gint64> &sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t idx = (size_t) std::ceil(p / 100.0 * sorted.size());
+    idx = std::min(std::max(idx, (size_t) 1), sorted.size()) - 1;
+    return sorted[idx] / 1000.0;
+}
+
+static double cpu_time(const struct rusage &ru) {
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 + ru.ru_stime.tv_sec +
+           ru.ru_stime.tv_usec / 1e6;
+}
+
+static std::string build_pipeline(const BenchRun &run, const std::string &csv_path) {
+    std::ostringstream p;
+    // Left/Right stream, as produced by `zedsrc stream-type=2`
+    p << "videotestsrc num-buffers=" << frames << " pattern=ball is-live=false"
+      << " ! video/x-raw,format=BGRA,width=" << run.width << ",height=" << run.height * 2
+      << ",framerate=15/1 ! identity name=inject"
+      << " ! zeddemux name=demux is-depth=false stream-data=true"
+      << " demux.src_aux ! queue ! fakesink sync=false async=false"
+      << " demux.src_left ! queue ! mux.sink_video"
+      << " demux.src_data ! tee name=data"
+      << " data. ! queue ! mux.sink_data";
+    if (!no_csv) {
+        p << " data. ! queue ! zeddatacsvsink location=\"" << csv_path << "\"";
+    }
+    p << " zeddatamux name=mux ! queue";
+    if (!no_overlay) {
+        p << " ! zedodoverlay";
+    }
+    p << " ! fakesink name=bench_sink sync=false signal-handoffs=true";
+    return p.str();
+}
+
+static gboolean run_bench(BenchRun &run, std::ostream &out, gboolean first) {
+    gchar *csv_path = g_build_filename(g_get_tmp_dir(), "zed-bench.csv", NULL);
+    std::string desc = build_pipeline(run, csv_path);
+
+    GError *error = NULL;
+    GstElement *pipeline = gst_parse_launch(desc.c_str(), &error);
+    if (!pipeline || error) {
+        g_printerr("ERROR - pipeline could not be constructed: %s\n",
+                   error ? error->message : "unknown error");
+        g_clear_error(&error);
+        if (pipeline) {
+            gst_object_unref(pipeline);
+        }
+        g_free(csv_path);
+        return FALSE;
+    }
+
+    run.inject_time.assign(frames, 0);
+    run.latencies.clear();
+    run.latencies.reserve(frames);
+    run.first_inject = 0;
+    run.last_output = 0;
+    run.out_frames = 0;
+
+    run.od_objects.resize(run.obj_count);
+    for (guint i = 0; i < run.obj_count; i++) {
+        zed_bench_fill_object(run.od_objects[i], i, run.width, run.height, FALSE);
+    }
+    run.bt_objects.resize(run.skel_count);
+    for (guint i = 0; i < run.skel_count; i++) {
+        zed_bench_fill_object(run.bt_objects[i], run.obj_count + i, run.width, run.height, TRUE);
+    }
+
+    GstElement *inject = gst_bin_get_by_name(GST_BIN(pipeline), "inject");
+    GstPad *inject_pad = gst_element_get_static_pad(inject, "src");
+    gst_pad_add_probe(inject_pad, GST_PAD_PROBE_TYPE_BUFFER, inject_meta, &run, NULL);
+    gst_object_unref(inject_pad);
+    gst_object_unref(inject);
+
+    GstElement *sink = gst_bin_get_by_name(GST_BIN(pipeline), "bench_sink");
+    g_signal_connect(sink, "handoff", G_CALLBACK(sink_handoff), &run);
+    gst_object_unref(sink);
+
+    struct rusage ru_start, ru_end;
+    getrusage(RUSAGE_SELF, &ru_start);
+
+    gst_element_set_state(pipeline, GST_STATE_PLAYING);
+
+    GstBus *bus = gst_element_get_bus(pipeline);
+    GstMessage *msg = gst_bus_timed_pop_filtered(bus, GST_CLOCK_TIME_NONE,
+                                                 (GstMessageType) (GST_MESSAGE_EOS |
+                                                                   GST_MESSAGE_ERROR));
+    gboolean ok = TRUE;
+    if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_ERROR) {
+        GError *err = NULL;
+        gchar *dbg = NULL;
+        gst_message_parse_error(msg, &err, &dbg);
+        g_printerr("ERROR - %s: %s\n", GST_OBJECT_NAME(msg->src), err->message);
+        if (dbg) {
+            g_printerr("%s\n", dbg);
+        }
+        g_clear_error(&err);
+        g_free(dbg);
+        ok = FALSE;
+    }
+    gst_message_unref(msg);
+    gst_object_unref(bus);
+
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    getrusage(RUSAGE_SELF, &ru_end);
+    gst_object_unref(pipeline);
+
+    g_remove(csv_path);
+    g_free(csv_path);
+
+    if (!ok) {
+        return FALSE;
+    }
+
+    // ----> Results
+    std::sort(run.latencies.begin(), run.latencies.end());
+    double wall = (run.last_output - run.first_inject) / 1e6;
+    double fps = wall > 0.0 ? run.out_frames / wall : 0.0;
+    double cpu = cpu_time(ru_end) - cpu_time(ru_start);
+
+    if (!first) {
+        out << ",\n";
+    }
+    out << "    {\"name\": \"" << resolution << "_obj" << run.obj_count << "_skel" << run.skel_count
+        << "\", \"width\": " << run.width << ", \"height\": " << run.height
+        << ", \"objects\": " << run.obj_count << ", \"skeletons\": " << run.skel_count
+        << ", \"frames\": " << run.out_frames << ", \"fps\": " << fps
+        << ", \"latency_ms\": {\"p50\": " << percentile(run.latencies, 50)
+        << ", \"p90\": " << percentile(run.latencies, 90)
+        << ", \"p99\": " << percentile(run.latencies, 99)
+        << ", \"max\": " << percentile(run.latencies, 100) << "}"
+        << ", \"cpu_time_s\": " << cpu
+        << ", \"cpu_percent\": " << (wall > 0.0 ? 100.0 * cpu / wall : 0.0)
+        << ", \"peak_rss_mb\": " << ru_end.ru_maxrss / 1024.0 << "}";
+    // <---- Results
+
+    return TRUE;
+}
+
+static gboolean check_element(const gchar *name) {
+    GstElementFactory *factory = gst_element_factory_find(name);
+    if (!factory) {
+        return FALSE;
+    }
+    gst_object_unref(factory);
+    return TRUE;
+}
+
+int main(int argc, char *argv[]) {
+    GOptionContext *optctx;
+    GError *error = NULL;
+
+    optctx = g_option_context_new("- ZED GStreamer elements synthetic benchmark\n\n"
+                                  "Example: gst-zed-bench -r hd1080 -o 0,16,256 -s 4");
+    g_option_context_add_main_entries(optctx, entries, NULL);
+    g_option_context_add_group(optctx, gst_init_get_option_group());
+    if (!g_option_context_parse(optctx, &argc, &argv, &error)) {
+        g_printerr("Error parsing options: %s\n", error->message);
+        g_option_context_free(optctx);
+        g_clear_error(&error);
+        exit(EXIT_FAILURE);
+    }
+    g_option_context_free(optctx);
+
+    guint width, height;
+    if (!get_frame_size(resolution, width, height)) {
+        g_printerr("ERROR - unknown resolution '%s'\n", resolution);
+        return EXIT_FAILURE;
+    }
+    if (frames <= 0 || skeletons < 0) {
+        g_printerr("ERROR - the number of frames must be positive\n");
+        return EXIT_FAILURE;
+    }
+
+    // ----> Check the elements
+    const gchar *required[] = {"zeddemux", "zeddatamux", "fakesink", "videotestsrc"};
+    for (const gchar *name : required) {
+        if (!check_element(name)) {
+            g_printerr("ERROR - element '%s' not found, check GST_PLUGIN_PATH\n", name);
+            return EXIT_FAILURE;
+        }
+    }
+    if (!no_overlay && !check_element("zedodoverlay")) {
+        g_printerr("WARNING - element 'zedodoverlay' not found, the overlay is disabled\n");
+        no_overlay = TRUE;
+    }
+    if (!no_csv && !check_element("zeddatacsvsink")) {
+        g_printerr("WARNING - element 'zeddatacsvsink' not found, the CSV sink is disabled\n");
+        no_csv = TRUE;
+    }
+    // <---- Check the elements
+
+    std::vector<guint> obj_counts;
+    gchar **tokens = g_strsplit(objects, ",", -1);
+    for (gchar **t = tokens; *t; t++) {
+        gchar *end = NULL;
+        guint64 val = g_ascii_strtoull(*t, &end, 10);
+        if (end == *t || *end != '\0') {
+            g_printerr("ERROR - invalid object count '%s'\n", *t);
+            g_strfreev(tokens);
+            return EXIT_FAILURE;
+        }
+        obj_counts.push_back((guint) val);
+    }
+    g_strfreev(tokens);
+
+    std::ofstream out_file;
+    if (output) {
+        out_file.open(output);
+        if (!out_file.is_open()) {
+            g_printerr("ERROR - cannot open '%s'\n", output);
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream &out = output ? out_file : std::cout;
+
+    GDateTime *now = g_date_time_new_now_local();
+    gchar *timestamp = g_date_time_format(now, "%Y-%m-%dT%H:%M:%S%:z");
+    g_date_time_unref(now);
+
+    out << "{\n";
+    out << "  \"timestamp\": \"" << timestamp << "\",\n";
+    gchar *version = gst_version_string();
+    out << "  \"gstreamer\": \"" << version << "\",\n";
+    out << "  \"overlay\": " << (no_overlay ? "false" : "true") << ",\n";
+    out << "  \"csv\": " << (no_csv ? "false" : "true") << ",\n";
+    out << "  \"benchmarks\": [\n";
+    g_free(timestamp);
+    g_free(version);
+
+    int ret = EXIT_SUCCESS;
+    gboolean first = TRUE;
+    for (guint count : obj_counts) {
+        BenchRun run;
+        run.obj_count = count;
+        run.skel_count = skeletons;
+        run.width = width;
+        run.height = height;
+        if (!run_bench(run, out, first)) {
+            ret = EXIT_FAILURE;
+            break;
+        }
+        first = FALSE;
+    }
+
+    out << "\n  ]\n}\n";
+    return ret;
+}
@@ -0,0 +1,442 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+// Microbenchmarks of the hot paths of the ZED GStreamer elements.
+//
+// Every case runs a single operation in a loop and reports its average duration:
+//  * `meta_add`, `meta_copy`, `meta_scale`: GstZedSrcMeta creation and transform functions
+//  * `demux_narrow_depth`: 32 to 16 bits depth conversion of `zeddemux`
+//  * `demux_chain`, `csvsink_render`, `overlay`: buffers pushed directly into a single element,
+//    whose pads are linked to dummy pads, without any other element or thread in between
+//
+// The results are printed in JSON format.
+
+#include <glib/gstdio.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gst-zed-demux/gstzeddemux.h"
+#include "gst-zed-meta/gstzedmeta.h"
+#include "zed-bench-objects.h"
+
+#define DEFAULT_MIN_TIME_MS 200
+#define DEFAULT_REPETITIONS 5
+
+static gint min_time_ms = DEFAULT_MIN_TIME_MS;
+static gint repetitions = DEFAULT_REPETITIONS;
+static gchar *filter = NULL;
+static gchar *output = NULL;
+
+static GOptionEntry entries[] = {
+    {"min-time", 't', 0, G_OPTION_ARG_INT, &min_time_ms,
+     "Minimum duration of each repetition [ms] (default: 200)", "MS"},
+    {"repetitions", 'n', 0, G_OPTION_ARG_INT, &repetitions,
+     "Number of repetitions of each case (default: 5)", "N"},
+    {"filter", 'k', 0, G_OPTION_ARG_STRING, &filter,
+     "Run only the cases whose name contains STRING", "STRING"},
+    {"output", 'f', 0, G_OPTION_ARG_FILENAME, &output,
+     "Write the JSON results to FILE instead of the standard output", "FILE"},
+    {NULL}};
+
+struct FrameSize {
+    const gchar *name;
+    guint width;
+    guint height;
+    gboolean zed_stereo;   // available as a `zedsrc` composite stream
+};
+
+static const FrameSize frame_sizes[] = {{"vga", 672, 376, TRUE},
+                                        {"hd720", 1280, 720, TRUE},
+                                        {"hd1080", 1920, 1080, TRUE},
+                                        {"hd2k", 2208, 1242, TRUE},
+                                        {"4k", 3840, 2160, FALSE}};
+
+static const guint object_counts[] = {0, 16, 256};
+
+// ----> Harness
+static std::ostream *out = &std::cout;
+static gboolean first_result = TRUE;
+
+static double now_ns() { return g_get_monotonic_time() * 1000.0; }
+
+/* Run `op` in batches until each repetition lasts at least `min_time_ms`, then report the
+ * median and the minimum of the average duration of one call.
+ */
+static void measure(const std::string &name, const std::function<void()> &op) {
+    if (filter && name.find(filter) == std::string::npos) {
+        return;
+    }
+
+    // Warm up caches and lazily initialized state, then calibrate the batch size
+    op();
+    guint64 iters = 1;
+    double min_ns = min_time_ms * 1e6;
+    for (;;) {
+        double start = now_ns();
+        for (guint64 i = 0; i < iters; i++) {
+            op();
+        }
+        double elapsed = now_ns() - start;
+        if (elapsed >= min_ns || iters >= (G_GUINT64_CONSTANT(1) << 40)) {
+            break;
+        }
+        iters = elapsed > 0.0 ? MAX(iters * 2, (guint64) (iters * min_ns / elapsed * 1.1))
+                              : iters * 10;
+    }
+
+    std::vector<double> results;
+    for (gint r = 0; r < repetitions; r++) {
+        double start = now_ns();
+        for (guint64 i = 0; i < iters; i++) {
+            op();
+        }
+        results.push_back((now_ns() - start) / iters);
+    }
+    std::sort(results.begin(), results.end());
+
+    if (!first_result) {
+        *out << ",\n";
+    }
+    first_result = FALSE;
+    *out << "    {\"name\": \"" << name << "\", \"iterations\": " << iters
+         << ", \"ns_per_op\": " << results[results.size() / 2]
+         << ", \"ns_per_op_min\": " << results[0] << "}";
+    out->flush();
+}
+
+struct ElementHarness {
+    GstElement *element;
+    GstPad *srcpad;                   // linked to the sink pad of the element
+    std::vector<GstPad *> sinkpads;   // linked to the source pads of the element
+};
+
+static GstFlowReturn harness_chain(GstPad *pad, GstObject *parent, GstBuffer *buf) {
+    gst_buffer_unref(buf);
+    return GST_FLOW_OK;
+}
+
+static gboolean harness_event(GstPad *pad, GstObject *parent, GstEvent *event) {
+    gst_event_unref(event);
+    return TRUE;
+}
+
+/* Instantiate `factory` and link all its pads to dummy pads. Returns FALSE if the element is
+ * not available.
+ */
+static gboolean harness_create(ElementHarness &h, const gchar *factory) {
+    h.element = gst_element_factory_make(factory, NULL);
+    if (!h.element) {
+        g_printerr("WARNING - element '%s' not found, its cases are skipped\n", factory);
+        return FALSE;
+    }
+    gst_object_ref_sink(h.element);
+
+    GstIterator *it = gst_element_iterate_src_pads(h.element);
+    GValue item = G_VALUE_INIT;
+    while (gst_iterator_next(it, &item) == GST_ITERATOR_OK) {
+        GstPad *elem_src = GST_PAD(g_value_get_object(&item));
+        GstPad *sink = gst_pad_new(NULL, GST_PAD_SINK);
+        gst_pad_set_chain_function(sink, harness_chain);
+        gst_pad_set_event_function(sink, harness_event);
+        gst_pad_set_active(sink, TRUE);
+        gst_pad_link(elem_src, sink);
+        h.sinkpads.push_back(sink);
+        g_value_reset(&item);
+    }
+    g_value_unset(&item);
+    gst_iterator_free(it);
+
+    h.srcpad = gst_pad_new(NULL, GST_PAD_SRC);
+    gst_pad_set_active(h.srcpad, TRUE);
+    GstPad *elem_sink = gst_element_get_static_pad(h.element, "sink");
+    gst_pad_link(h.srcpad, elem_sink);
+    gst_object_unref(elem_sink);
+
+    return TRUE;
+}
+
+/* Set the element to PLAYING and push the stream-start, caps and segment events */
+static void harness_start(ElementHarness &h, GstCaps *caps) {
+    gst_element_set_state(h.element, GST_STATE_PLAYING);
+
+    GstSegment segment;
+    gst_segment_init(&segment, GST_FORMAT_TIME);
+    gst_pad_push_event(h.srcpad, gst_event_new_stream_start("zed-microbench"));
+    gst_pad_push_event(h.srcpad, gst_event_new_caps(caps));
+    gst_pad_push_event(h.srcpad, gst_event_new_segment(&segment));
+    gst_caps_unref(caps);
+}
+
+static void harness_teardown(ElementHarness &h) {
+    gst_pad_push_event(h.srcpad, gst_event_new_eos());
+    gst_element_set_state(h.element, GST_STATE_NULL);
+    gst_object_unref(h.srcpad);
+    for (GstPad *pad : h.sinkpads) {
+        gst_object_unref(pad);
+    }
+    h.sinkpads.clear();
+    gst_object_unref(h.element);
+}
+
+static GstCaps *bgra_caps(guint width, guint height) {
+    return gst_caps_new_simple("video/x-raw", "format", G_TYPE_STRING, "BGRA", "width",
+                               G_TYPE_INT, width, "height", G_TYPE_INT, height, "framerate",
+                               GST_TYPE_FRACTION, 15, 1, NULL);
+}
+// <---- Harness
+
+// ----> Synthetic metadata
+static GstZedSrcMeta *add_meta(GstBuffer *buf, guint width, guint height, guint od_count,
+                               guint bt_count) {
+    std::vector<ZedObjectData> od(od_count);
+    for (guint i = 0; i < od_count; i++) {
+        zed_bench_fill_object(od[i], i, width, height, FALSE);
+    }
+    std::vector<ZedObjectData> bt(bt_count);
+    for (guint i = 0; i < bt_count; i++) {
+        zed_bench_fill_object(bt[i], od_count + i, width, height, TRUE);
+    }
+
+    ZedInfo info;
+    info.cam_model = 1;     // ZED 2
+    info.stream_type = 0;   // Left
+    info.grab_single_frame_width = width;
+    info.grab_single_frame_height = height;
+
+    ZedPose pose;
+    memset(&pose, 0, sizeof(pose));
+    pose.pose_avail = TRUE;
+
+    ZedSensors sens;
+    memset(&sens, 0, sizeof(sens));
+    sens.sens_avail = TRUE;
+    sens.imu.imu_avail = TRUE;
+
+    return gst_buffer_add_zed_src_meta_full(buf, info, pose, sens, od_count + bt_count > 0,
+                                            od_count, od.data(), bt_count, bt.data(), 1);
+}
+// <---- Synthetic metadata
+
+// ----> Cases
+static void bench_meta() {
+    for (guint count : object_counts) {
+        std::string suffix = "/objects=" + std::to_string(count);
+
+        GstBuffer *src = gst_buffer_new();
+        GstZedSrcMeta *src_meta = add_meta(src, 1280, 720, count, 0);
+
+        // Creation and release, all the objects are copied
+        GstBuffer *buf = gst_buffer_new();
+        measure("meta_add" + suffix, [&]() {
+            GstZedSrcMeta *meta = gst_buffer_add_zed_src_meta_full(
+                buf, src_meta->info, src_meta->pose, src_meta->sens, src_meta->od_enabled,
+                src_meta->od_count, gst_zed_src_meta_od_objects(src_meta), src_meta->bt_count,
+                gst_zed_src_meta_bt_objects(src_meta), src_meta->frame_id);
+            gst_buffer_remove_meta(buf, (GstMeta *) meta);
+        });
+        gst_buffer_unref(buf);
+
+        // Copy transform, as applied by `gst_buffer_copy`
+        measure("meta_copy" + suffix, [&]() { gst_buffer_unref(gst_buffer_copy(src)); });
+
+        // Scale transform from HD720 to VGA, as applied by `videoscale`
+        GstVideoInfo in_info, out_info;
+        gst_video_info_set_format(&in_info, GST_VIDEO_FORMAT_BGRA, 1280, 720);
+        gst_video_info_set_format(&out_info, GST_VIDEO_FORMAT_BGRA, 672, 376);
+        GstVideoMetaTransform trans = {&in_info, &out_info};
+        GQuark scale = gst_video_meta_transform_scale_get_quark();
+        const GstMetaInfo *info = GST_ZED_SRC_META_INFO;
+
+        GstBuffer *dest = gst_buffer_new();
+        measure("meta_scale" + suffix, [&]() {
+            info->transform_func(dest, (GstMeta *) src_meta, src, scale, &trans);
+            GstMeta *meta = gst_buffer_get_meta(dest, GST_ZED_SRC_META_API_TYPE);
+            gst_buffer_remove_meta(dest, meta);
+        });
+        gst_buffer_unref(dest);
+
+        gst_buffer_unref(src);
+    }
+}
+
+static void bench_demux() {
+    for (const FrameSize &fs : frame_sizes) {
+        gsize pixels = (gsize) fs.width * fs.height;
+        std::vector<guint32> in(pixels, 1500);
+        std::vector<guint16> narrow(pixels);
+        measure(std::string("demux_narrow_depth/") + fs.name,
+                [&]() { gst_zeddemux_narrow_depth(in.data(), narrow.data(), pixels); });
+
+        if (!fs.zed_stereo) {
+            continue;
+        }
+
+        ElementHarness h;
+        if (!harness_create(h, "zeddemux")) {
+            return;
+        }
+        g_object_set(h.element, "is-depth", TRUE, "stream-data", TRUE, NULL);
+        harness_start(h, bgra_caps(fs.width, fs.height * 2));
+
+        GstBuffer *buf = gst_buffer_new_allocate(NULL, pixels * 4 * 2, NULL);
+        gst_buffer_memset(buf, 0, 0x10, pixels * 4 * 2);
+        add_meta(buf, fs.width, fs.height, 16, 0);
+        measure(std::string("demux_chain/") + fs.name + "/depth",
+                [&]() { gst_pad_push(h.srcpad, gst_buffer_ref(buf)); });
+        gst_buffer_unref(buf);
+
+        harness_teardown(h);
+    }
+}
+
+static void bench_csvsink() {
+    gchar *csv_path = g_build_filename(g_get_tmp_dir(), "zed-microbench.csv", NULL);
+
+    ElementHarness h;
+    if (!harness_create(h, "zeddatacsvsink")) {
+        g_free(csv_path);
+        return;
+    }
+    g_object_set(h.element, "location", csv_path, "sync", FALSE, "async", FALSE, NULL);
+    harness_start(h, gst_caps_new_empty_simple("application/data"));
+
+    // Data record, as pushed by `zeddemux` on its data pad
+    GstBuffer *src = gst_buffer_new();
+    GstZedSrcMeta *meta = add_meta(src, 1280, 720, 0, 0);
+    gsize size = gst_zed_src_meta_record_size(meta);
+    GstBuffer *record = gst_buffer_new_allocate(NULL, size, NULL);
+    GstMapInfo map;
+    gst_buffer_map(record, &map, GST_MAP_WRITE);
+    gst_zed_src_meta_write_record(meta, map.data, map.size);
+    gst_buffer_unmap(record, &map);
+    gst_buffer_unref(src);
+
+    guint64 ts = 0;
+    measure("csvsink_render", [&]() {
+        GstBuffer *buf = gst_buffer_copy(record);
+        GST_BUFFER_PTS(buf) = ts;
+        ts += GST_MSECOND;
+        gst_pad_push(h.srcpad, buf);
+    });
+    gst_buffer_unref(record);
+
+    harness_teardown(h);
+    g_remove(csv_path);
+    g_free(csv_path);
+}
+
+static void bench_overlay() {
+    for (const FrameSize &fs : frame_sizes) {
+        if (!fs.zed_stereo) {
+            continue;
+        }
+
+        ElementHarness h;
+        if (!harness_create(h, "zedodoverlay")) {
+            return;
+        }
+        harness_start(h, bgra_caps(fs.width, fs.height));
+
+        gsize size = (gsize) fs.width * fs.height * 4;
+        for (guint count : object_counts) {
+            // The pushed buffer is not writable: like in a `tee` branch, each iteration draws
+            // on a copy of the frame
+            GstBuffer *buf = gst_buffer_new_allocate(NULL, size, NULL);
+            gst_buffer_memset(buf, 0, 0x40, size);
+            add_meta(buf, fs.width, fs.height, count, 0);
+            measure(std::string("overlay/") + fs.name + "/objects=" + std::to_string(count),
+                    [&]() { gst_pad_push(h.srcpad, gst_buffer_ref(buf)); });
+            gst_buffer_unref(buf);
+        }
+
+        GstBuffer *buf = gst_buffer_new_allocate(NULL, size, NULL);
+        gst_buffer_memset(buf, 0, 0x40, size);
+        add_meta(buf, fs.width, fs.height, 0, 16);
+        measure(std::string("overlay/") + fs.name + "/skeletons=16",
+                [&]() { gst_pad_push(h.srcpad, gst_buffer_ref(buf)); });
+        gst_buffer_unref(buf);
+
+        harness_teardown(h);
+    }
+}
+// <---- Cases
+
+int main(int argc, char *argv[]) {
+    GOptionContext *optctx;
+    GError *error = NULL;
+
+    optctx = g_option_context_new("- ZED GStreamer elements microbenchmarks\n\n"
+                                  "Example: gst-zed-microbench -k overlay/hd1080");
+    g_option_context_add_main_entries(optctx, entries, NULL);
+    g_option_context_add_group(optctx, gst_init_get_option_group());
+    if (!g_option_context_parse(optctx, &argc, &argv, &error)) {
+        g_printerr("Error parsing options: %s\n", error->message);
+        g_option_context_free(optctx);
+        g_clear_error(&error);
+        exit(EXIT_FAILURE);
+    }
+    g_option_context_free(optctx);
+
+    if (min_time_ms <= 0 || repetitions <= 0) {
+        g_printerr("ERROR - the minimum time and the repetitions must be positive\n");
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream out_file;
+    if (output) {
+        out_file.open(output);
+        if (!out_file.is_open()) {
+            g_printerr("ERROR - cannot open '%s'\n", output);
+            return EXIT_FAILURE;
+        }
+        out = &out_file;
+    }
+
+    GDateTime *now = g_date_time_new_now_local();
+    gchar *timestamp = g_date_time_format(now, "%Y-%m-%dT%H:%M:%S%:z");
+    g_date_time_unref(now);
+    gchar *version = gst_version_string();
+
+    *out << "{\n";
+    *out << "  \"timestamp\": \"" << timestamp << "\",\n";
+    *out << "  \"gstreamer\": \"" << version << "\",\n";
+    *out << "  \"benchmarks\": [\n";
+    g_free(timestamp);
+    g_free(version);
+
+    bench_meta();
+    bench_demux();
+    bench_csvsink();
+    bench_overlay();
+
+    *out << "\n  ]\n}\n";
+    return EXIT_SUCCESS;
+}
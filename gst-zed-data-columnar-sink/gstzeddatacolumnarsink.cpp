@@ -0,0 +1,536 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzeddatacolumnarsink.h"
+
+#include <string.h>
+
+#include "gst-zed-meta/gstzedmeta.h"
+
+static GstStaticPadTemplate sink_factory = GST_STATIC_PAD_TEMPLATE(
+    "sink", GST_PAD_SINK, GST_PAD_ALWAYS, GST_STATIC_CAPS("application/data"));
+
+GST_DEBUG_CATEGORY_STATIC(gst_zeddatacolumnarsink_debug);
+#define GST_CAT_DEFAULT gst_zeddatacolumnarsink_debug
+
+#define DEFAULT_PROP_LOCATION ""
+#define DEFAULT_PROP_ROW_GROUP_SIZE 1024
+// Row groups are buffered in memory, column by column
+#define MAX_ROW_GROUP_SIZE (1 << 20)
+
+enum { PROP_0, PROP_LOCATION, PROP_ROW_GROUP_SIZE, PROP_LAST };
+
+typedef struct {
+    const gchar *name;
+    GstZedColumnType type;
+} GstZedColumnDesc;
+
+// Columns are written in this order. The names match the CSV header of `zeddatacsvsink`.
+enum {
+    COL_TIMESTAMP,
+    COL_FRAME_ID,
+    COL_STREAM_TYPE,
+    COL_CAM_MODEL,
+    COL_GRAB_W,
+    COL_GRAB_H,
+    COL_POSE_VAL,
+    COL_POS_TRK_STATE,
+    COL_POS_X,
+    COL_POS_Y,
+    COL_POS_Z,
+    COL_OR_X,
+    COL_OR_Y,
+    COL_OR_Z,
+    COL_IMU_VAL,
+    COL_ACC_X,
+    COL_ACC_Y,
+    COL_ACC_Z,
+    COL_GYRO_X,
+    COL_GYRO_Y,
+    COL_GYRO_Z,
+    COL_MAG_VAL,
+    COL_MAG_X,
+    COL_MAG_Y,
+    COL_MAG_Z,
+    COL_ENV_VAL,
+    COL_TEMP,
+    COL_PRESS,
+    COL_TEMP_VAL,
+    COL_TEMP_L,
+    COL_TEMP_R,
+    COL_OD_ENABLED,
+    COL_OBJ_COUNT,
+    COL_COUNT
+};
+
+static const GstZedColumnDesc column_desc[COL_COUNT] = {
+    {"TIMESTAMP", GST_ZED_COLUMN_U64},     {"FRAME_ID", GST_ZED_COLUMN_U64},
+    {"STREAM_TYPE", GST_ZED_COLUMN_I32},   {"CAM_MODEL", GST_ZED_COLUMN_I32},
+    {"GRAB_W", GST_ZED_COLUMN_U32},        {"GRAB_H", GST_ZED_COLUMN_U32},
+    {"POSE_VAL", GST_ZED_COLUMN_U8},       {"POS_TRK_STATE", GST_ZED_COLUMN_I32},
+    {"POS_X_[m]", GST_ZED_COLUMN_F32},     {"POS_Y_[m]", GST_ZED_COLUMN_F32},
+    {"POS_Z_[m]", GST_ZED_COLUMN_F32},     {"OR_X_[rad]", GST_ZED_COLUMN_F32},
+    {"OR_Y_[rad]", GST_ZED_COLUMN_F32},    {"OR_Z_[rad]", GST_ZED_COLUMN_F32},
+    {"IMU_VAL", GST_ZED_COLUMN_U8},        {"ACC_X_[m/s²]", GST_ZED_COLUMN_F32},
+    {"ACC_Y_[m/s²]", GST_ZED_COLUMN_F32},  {"ACC_Z_[m/s²]", GST_ZED_COLUMN_F32},
+    {"GYRO_X_[rad/s]", GST_ZED_COLUMN_F32}, {"GYRO_Y_[rad/s]", GST_ZED_COLUMN_F32},
+    {"GYRO_Z_[rad/s]", GST_ZED_COLUMN_F32}, {"MAG_VAL", GST_ZED_COLUMN_U8},
+    {"MAG_X_[uT]", GST_ZED_COLUMN_F32},    {"MAG_Y_[uT]", GST_ZED_COLUMN_F32},
+    {"MAG_Z_[uT]", GST_ZED_COLUMN_F32},    {"ENV_VAL", GST_ZED_COLUMN_U8},
+    {"TEMP_[°C]", GST_ZED_COLUMN_F32},     {"PRESS_[hPa]", GST_ZED_COLUMN_F32},
+    {"TEMP_VAL", GST_ZED_COLUMN_U8},       {"TEMP_L_[°C]", GST_ZED_COLUMN_F32},
+    {"TEMP_R_[°C]", GST_ZED_COLUMN_F32},   {"OD_ENABLED", GST_ZED_COLUMN_U8},
+    {"OBJ_COUNT", GST_ZED_COLUMN_U32},
+};
+
+static const guint8 zero_pad[8] = {0};
+
+static void gst_zeddatacolumnarsink_dispose(GObject *object);
+static void gst_zeddatacolumnarsink_finalize(GObject *object);
+
+static void gst_zeddatacolumnarsink_set_property(GObject *object, guint prop_id,
+                                                 const GValue *value, GParamSpec *pspec);
+static void gst_zeddatacolumnarsink_get_property(GObject *object, guint prop_id, GValue *value,
+                                                 GParamSpec *pspec);
+
+static gboolean gst_zeddatacolumnarsink_open_file(GstZedDataColumnarSink *sink);
+static void gst_zeddatacolumnarsink_close_file(GstZedDataColumnarSink *sink);
+static gboolean gst_zeddatacolumnarsink_flush_row_group(GstZedDataColumnarSink *sink);
+
+static gboolean gst_zeddatacolumnarsink_start(GstBaseSink *sink);
+static gboolean gst_zeddatacolumnarsink_stop(GstBaseSink *sink);
+
+static gboolean gst_zeddatacolumnarsink_event(GstBaseSink *sink, GstEvent *event);
+static GstFlowReturn gst_zeddatacolumnarsink_render(GstBaseSink *sink, GstBuffer *buffer);
+
+G_DEFINE_TYPE(GstZedDataColumnarSink, gst_zeddatacolumnarsink, GST_TYPE_BASE_SINK);
+
+static void gst_zeddatacolumnarsink_class_init(GstZedDataColumnarSinkClass *klass) {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass *gstelement_class = GST_ELEMENT_CLASS(klass);
+    GstBaseSinkClass *gstbasesink_class = GST_BASE_SINK_CLASS(klass);
+
+    gobject_class->dispose = gst_zeddatacolumnarsink_dispose;
+    gobject_class->finalize = gst_zeddatacolumnarsink_finalize;
+
+    gobject_class->set_property = gst_zeddatacolumnarsink_set_property;
+    gobject_class->get_property = gst_zeddatacolumnarsink_get_property;
+
+    g_object_class_install_property(
+        gobject_class, PROP_LOCATION,
+        g_param_spec_string("location", "File Location", "Location of the columnar file to write",
+                            DEFAULT_PROP_LOCATION,
+                            (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_ROW_GROUP_SIZE,
+        g_param_spec_uint("row-group-size", "Row group size",
+                          "Number of records buffered per column before being written to disk", 1,
+                          MAX_ROW_GROUP_SIZE, DEFAULT_PROP_ROW_GROUP_SIZE,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    gst_element_class_set_static_metadata(gstelement_class, "ZED Columnar File Sink", "Sink/File",
+                                          "Write data stream to a columnar binary file",
+                                          "Stereolabs <support@stereolabs.com>");
+    gst_element_class_add_static_pad_template(gstelement_class, &sink_factory);
+
+    gstbasesink_class->start = GST_DEBUG_FUNCPTR(gst_zeddatacolumnarsink_start);
+    gstbasesink_class->stop = GST_DEBUG_FUNCPTR(gst_zeddatacolumnarsink_stop);
+    gstbasesink_class->render = GST_DEBUG_FUNCPTR(gst_zeddatacolumnarsink_render);
+    gstbasesink_class->event = GST_DEBUG_FUNCPTR(gst_zeddatacolumnarsink_event);
+}
+
+static void gst_zeddatacolumnarsink_init(GstZedDataColumnarSink *colsink) {
+    GST_TRACE_OBJECT(colsink, "Init");
+
+    colsink->filename = g_string_new(DEFAULT_PROP_LOCATION);
+    colsink->row_group_size = DEFAULT_PROP_ROW_GROUP_SIZE;
+
+    colsink->out_file_ptr = NULL;
+    colsink->columns = new std::vector<std::vector<guint8>>(COL_COUNT);
+    colsink->row_group_offsets = new std::vector<guint64>();
+    colsink->rows_in_group = 0;
+    colsink->total_rows = 0;
+    colsink->file_offset = 0;
+
+    gst_base_sink_set_sync(GST_BASE_SINK(colsink), FALSE);
+}
+
+static void gst_zeddatacolumnarsink_dispose(GObject *object) {
+    GstZedDataColumnarSink *sink = GST_DATA_COLUMNAR_SINK(object);
+
+    GST_TRACE_OBJECT(sink, "Dispose");
+
+    if (sink->out_file_ptr) {
+        delete sink->out_file_ptr;
+        sink->out_file_ptr = NULL;
+    }
+
+    G_OBJECT_CLASS(gst_zeddatacolumnarsink_parent_class)->dispose(object);
+}
+
+static void gst_zeddatacolumnarsink_finalize(GObject *object) {
+    GstZedDataColumnarSink *sink = GST_DATA_COLUMNAR_SINK(object);
+
+    GST_TRACE_OBJECT(sink, "Finalize");
+
+    if (sink->filename) {
+        g_string_free(sink->filename, TRUE);
+    }
+
+    delete sink->columns;
+    delete sink->row_group_offsets;
+
+    G_OBJECT_CLASS(gst_zeddatacolumnarsink_parent_class)->finalize(object);
+}
+
+void gst_zeddatacolumnarsink_set_property(GObject *object, guint prop_id, const GValue *value,
+                                          GParamSpec *pspec) {
+    GstZedDataColumnarSink *sink = GST_DATA_COLUMNAR_SINK(object);
+
+    GST_TRACE_OBJECT(sink, "Set property");
+
+    switch (prop_id) {
+    case PROP_LOCATION:
+        g_string_assign(sink->filename, g_value_get_string(value));
+        break;
+    case PROP_ROW_GROUP_SIZE:
+        sink->row_group_size = g_value_get_uint(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+void gst_zeddatacolumnarsink_get_property(GObject *object, guint prop_id, GValue *value,
+                                          GParamSpec *pspec) {
+    GstZedDataColumnarSink *sink = GST_DATA_COLUMNAR_SINK(object);
+
+    GST_TRACE_OBJECT(sink, "Get property");
+
+    switch (prop_id) {
+    case PROP_LOCATION:
+        g_value_set_string(value, sink->filename->str);
+        break;
+    case PROP_ROW_GROUP_SIZE:
+        g_value_set_uint(value, sink->row_group_size);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static guint column_type_size(GstZedColumnType type) {
+    switch (type) {
+    case GST_ZED_COLUMN_U8:
+        return 1;
+    case GST_ZED_COLUMN_U64:
+        return 8;
+    default:
+        return 4;
+    }
+}
+
+static void write_bytes(GstZedDataColumnarSink *sink, const void *data, gsize size) {
+    sink->out_file_ptr->write((const char *) data, size);
+    sink->file_offset += size;
+}
+
+static void write_padding(GstZedDataColumnarSink *sink) {
+    gsize pad = (8 - (sink->file_offset % 8)) % 8;
+    if (pad > 0) {
+        write_bytes(sink, zero_pad, pad);
+    }
+}
+
+static void write_u32(GstZedDataColumnarSink *sink, guint32 val) {
+    val = GUINT32_TO_LE(val);
+    write_bytes(sink, &val, sizeof(val));
+}
+
+static void write_u64(GstZedDataColumnarSink *sink, guint64 val) {
+    val = GUINT64_TO_LE(val);
+    write_bytes(sink, &val, sizeof(val));
+}
+
+template <typename T> static inline void column_append(GstZedDataColumnarSink *sink, int col, T val) {
+    std::vector<guint8> &column = (*sink->columns)[col];
+    gsize pos = column.size();
+    column.resize(pos + sizeof(T));
+    memcpy(column.data() + pos, &val, sizeof(T));
+}
+
+gboolean gst_zeddatacolumnarsink_open_file(GstZedDataColumnarSink *sink) {
+    GST_TRACE_OBJECT(sink, "Open file: %s", sink->filename->str);
+
+    if (sink->filename->len == 0) {
+        GST_ELEMENT_ERROR(sink, RESOURCE, NOT_FOUND, ("No file name specified for writing"),
+                          (NULL));
+        return FALSE;
+    }
+
+#if G_BYTE_ORDER != G_LITTLE_ENDIAN
+    // Column chunks are dumped as in memory
+    GST_ELEMENT_ERROR(sink, RESOURCE, SETTINGS, ("Columnar format requires a little endian host"),
+                      (NULL));
+    return FALSE;
+#endif
+
+    // Left over by a previous start
+    if (sink->out_file_ptr) {
+        delete sink->out_file_ptr;
+        sink->out_file_ptr = NULL;
+    }
+
+    sink->out_file_ptr = new std::ofstream(sink->filename->str,
+                                           std::ios::out | std::ios::trunc | std::ios::binary);
+
+    if (!sink->out_file_ptr || !sink->out_file_ptr->good()) {
+        GST_ELEMENT_ERROR(sink, RESOURCE, OPEN_WRITE, ("Error opening columnar file for writing"),
+                          (NULL));
+        return FALSE;
+    }
+
+    sink->file_offset = 0;
+    sink->total_rows = 0;
+    sink->rows_in_group = 0;
+    sink->row_group_offsets->clear();
+
+    // Reserve the whole row group once to avoid reallocations while rendering
+    for (int c = 0; c < COL_COUNT; c++) {
+        (*sink->columns)[c].clear();
+        (*sink->columns)[c].reserve(sink->row_group_size * column_type_size(column_desc[c].type));
+    }
+
+    // ----> File header
+    write_bytes(sink, GST_ZED_COLUMNAR_MAGIC, 8);
+    write_u32(sink, COL_COUNT);
+    write_u32(sink, 0);
+    for (int c = 0; c < COL_COUNT; c++) {
+        guint8 type = (guint8) column_desc[c].type;
+        guint8 len = (guint8) strlen(column_desc[c].name);
+        write_bytes(sink, &type, 1);
+        write_bytes(sink, &len, 1);
+        write_bytes(sink, column_desc[c].name, len);
+    }
+    write_padding(sink);
+    // <---- File header
+
+    GST_TRACE_OBJECT(sink, "File opened: %s", sink->filename->str);
+
+    return TRUE;
+}
+
+gboolean gst_zeddatacolumnarsink_flush_row_group(GstZedDataColumnarSink *sink) {
+    if (sink->rows_in_group == 0) {
+        return TRUE;
+    }
+
+    GST_DEBUG_OBJECT(sink, "Writing row group with %u rows", sink->rows_in_group);
+
+    sink->row_group_offsets->push_back(sink->file_offset);
+
+    write_bytes(sink, GST_ZED_COLUMNAR_RG_MAGIC, 4);
+    write_u32(sink, sink->rows_in_group);
+    for (int c = 0; c < COL_COUNT; c++) {
+        write_u64(sink, (*sink->columns)[c].size());
+    }
+    write_padding(sink);
+
+    for (int c = 0; c < COL_COUNT; c++) {
+        std::vector<guint8> &column = (*sink->columns)[c];
+        write_bytes(sink, column.data(), column.size());
+        write_padding(sink);
+        column.clear();
+    }
+
+    sink->total_rows += sink->rows_in_group;
+    sink->rows_in_group = 0;
+
+    // Flush row group by row group so a crash loses at most one group
+    sink->out_file_ptr->flush();
+
+    return sink->out_file_ptr->good();
+}
+
+void gst_zeddatacolumnarsink_close_file(GstZedDataColumnarSink *sink) {
+    GST_TRACE_OBJECT(sink, "Close File");
+
+    if (sink->out_file_ptr && sink->out_file_ptr->is_open()) {
+        gst_zeddatacolumnarsink_flush_row_group(sink);
+
+        // ----> Footer
+        for (guint64 offset : *sink->row_group_offsets) {
+            write_u64(sink, offset);
+        }
+        write_u64(sink, sink->total_rows);
+        write_u32(sink, sink->row_group_offsets->size());
+        write_bytes(sink, GST_ZED_COLUMNAR_END_MAGIC, 4);
+        // <---- Footer
+
+        sink->out_file_ptr->flush();
+        sink->out_file_ptr->close();
+    }
+
+    if (sink->out_file_ptr) {
+        delete sink->out_file_ptr;
+        sink->out_file_ptr = NULL;
+    }
+}
+
+gboolean gst_zeddatacolumnarsink_start(GstBaseSink *sink) {
+    GstZedDataColumnarSink *colsink = GST_DATA_COLUMNAR_SINK(sink);
+
+    GST_TRACE_OBJECT(colsink, "Start");
+
+    return gst_zeddatacolumnarsink_open_file(colsink);
+}
+
+gboolean gst_zeddatacolumnarsink_stop(GstBaseSink *sink) {
+    GstZedDataColumnarSink *colsink = GST_DATA_COLUMNAR_SINK(sink);
+
+    GST_TRACE_OBJECT(colsink, "Stop");
+
+    gst_zeddatacolumnarsink_close_file(colsink);
+
+    return TRUE;
+}
+
+gboolean gst_zeddatacolumnarsink_event(GstBaseSink *sink, GstEvent *event) {
+    GstZedDataColumnarSink *colsink = GST_DATA_COLUMNAR_SINK(sink);
+
+    GST_TRACE_OBJECT(colsink, "Event ");
+
+    switch (GST_EVENT_TYPE(event)) {
+    case GST_EVENT_EOS:
+        if (colsink->out_file_ptr && colsink->out_file_ptr->is_open()) {
+            if (!gst_zeddatacolumnarsink_flush_row_group(colsink)) {
+                GST_ELEMENT_ERROR(sink, RESOURCE, WRITE, ("Error writing row group to file"),
+                                  (NULL));
+                gst_event_unref(event);
+                return FALSE;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    return GST_BASE_SINK_CLASS(gst_zeddatacolumnarsink_parent_class)->event(sink, event);
+}
+
+GstFlowReturn gst_zeddatacolumnarsink_render(GstBaseSink *sink, GstBuffer *buf) {
+    GstZedDataColumnarSink *colsink = GST_DATA_COLUMNAR_SINK(sink);
+
+    GstMapInfo map_in;
+
+    GST_TRACE_OBJECT(colsink, "Render");
+
+    if (!gst_buffer_map(buf, &map_in, GST_MAP_READ)) {
+        GST_ELEMENT_ERROR(sink, RESOURCE, FAILED, ("Failed to map buffer for reading"), (NULL));
+        return GST_FLOW_ERROR;
+    }
+
+    if (map_in.size < sizeof(GstZedSrcMeta)) {
+        gst_buffer_unmap(buf, &map_in);
+        GST_ELEMENT_ERROR(sink, STREAM, FORMAT, ("Data buffer too small for GstZedSrcMeta"),
+                          ("Received %" G_GSIZE_FORMAT " B", map_in.size));
+        return GST_FLOW_ERROR;
+    }
+
+    GstZedSrcMeta *meta = (GstZedSrcMeta *) map_in.data;
+
+    column_append<guint64>(colsink, COL_TIMESTAMP, GST_BUFFER_TIMESTAMP(buf));
+    column_append<guint64>(colsink, COL_FRAME_ID, meta->frame_id);
+
+    // ----> Info
+    column_append<gint32>(colsink, COL_STREAM_TYPE, meta->info.stream_type);
+    column_append<gint32>(colsink, COL_CAM_MODEL, meta->info.cam_model);
+    column_append<guint32>(colsink, COL_GRAB_W, meta->info.grab_single_frame_width);
+    column_append<guint32>(colsink, COL_GRAB_H, meta->info.grab_single_frame_height);
+    // <---- Info
+
+    // ----> Camera Pose
+    column_append<guint8>(colsink, COL_POSE_VAL, meta->pose.pose_avail ? 1 : 0);
+    column_append<gint32>(colsink, COL_POS_TRK_STATE, meta->pose.pos_tracking_state);
+    column_append<gfloat>(colsink, COL_POS_X, meta->pose.pos[0] / 1000.f);
+    column_append<gfloat>(colsink, COL_POS_Y, meta->pose.pos[1] / 1000.f);
+    column_append<gfloat>(colsink, COL_POS_Z, meta->pose.pos[2] / 1000.f);
+    column_append<gfloat>(colsink, COL_OR_X, meta->pose.orient[0]);
+    column_append<gfloat>(colsink, COL_OR_Y, meta->pose.orient[1]);
+    column_append<gfloat>(colsink, COL_OR_Z, meta->pose.orient[2]);
+    // <---- Camera Pose
+
+    // ----> Sensors
+    column_append<guint8>(colsink, COL_IMU_VAL, meta->sens.imu.imu_avail ? 1 : 0);
+    column_append<gfloat>(colsink, COL_ACC_X, meta->sens.imu.acc[0]);
+    column_append<gfloat>(colsink, COL_ACC_Y, meta->sens.imu.acc[1]);
+    column_append<gfloat>(colsink, COL_ACC_Z, meta->sens.imu.acc[2]);
+    column_append<gfloat>(colsink, COL_GYRO_X, meta->sens.imu.gyro[0]);
+    column_append<gfloat>(colsink, COL_GYRO_Y, meta->sens.imu.gyro[1]);
+    column_append<gfloat>(colsink, COL_GYRO_Z, meta->sens.imu.gyro[2]);
+
+    column_append<guint8>(colsink, COL_MAG_VAL, meta->sens.mag.mag_avail ? 1 : 0);
+    column_append<gfloat>(colsink, COL_MAG_X, meta->sens.mag.mag[0]);
+    column_append<gfloat>(colsink, COL_MAG_Y, meta->sens.mag.mag[1]);
+    column_append<gfloat>(colsink, COL_MAG_Z, meta->sens.mag.mag[2]);
+
+    column_append<guint8>(colsink, COL_ENV_VAL, meta->sens.env.env_avail ? 1 : 0);
+    column_append<gfloat>(colsink, COL_TEMP, meta->sens.env.temp);
+    column_append<gfloat>(colsink, COL_PRESS, meta->sens.env.press);
+
+    column_append<guint8>(colsink, COL_TEMP_VAL, meta->sens.temp.temp_avail ? 1 : 0);
+    column_append<gfloat>(colsink, COL_TEMP_L, meta->sens.temp.temp_cam_left);
+    column_append<gfloat>(colsink, COL_TEMP_R, meta->sens.temp.temp_cam_right);
+    // <---- Sensors
+
+    // ----> Object detection summary
+    column_append<guint8>(colsink, COL_OD_ENABLED, meta->od_enabled ? 1 : 0);
+    column_append<guint32>(colsink, COL_OBJ_COUNT, meta->obj_count);
+    // <---- Object detection summary
+
+    gst_buffer_unmap(buf, &map_in);
+
+    colsink->rows_in_group++;
+    if (colsink->rows_in_group >= colsink->row_group_size) {
+        if (!gst_zeddatacolumnarsink_flush_row_group(colsink)) {
+            GST_ELEMENT_ERROR(sink, RESOURCE, WRITE, ("Error writing row group to file"), (NULL));
+            return GST_FLOW_ERROR;
+        }
+    }
+
+    return GST_FLOW_OK;
+}
+
+static gboolean plugin_init(GstPlugin *plugin) {
+    GST_DEBUG_CATEGORY_INIT(gst_zeddatacolumnarsink_debug, "zeddatacolumnarsink", 0,
+                            "debug category for zeddatacolumnarsink element");
+    gst_element_register(plugin, "zeddatacolumnarsink", GST_RANK_NONE,
+                         gst_zeddatacolumnarsink_get_type());
+
+    return TRUE;
+}
+
+GST_PLUGIN_DEFINE(GST_VERSION_MAJOR, GST_VERSION_MINOR, zeddatacolumnarsink,
+                  "ZED Data columnar file sink", plugin_init, GST_PACKAGE_VERSION,
+                  GST_PACKAGE_LICENSE, GST_PACKAGE_NAME, GST_PACKAGE_ORIGIN)
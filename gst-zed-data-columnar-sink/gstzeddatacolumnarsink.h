@@ -0,0 +1,111 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef _GST_ZED_DATA_COLUMNAR_SINK_H
+#define _GST_ZED_DATA_COLUMNAR_SINK_H
+
+#include <gst/base/gstbasesink.h>
+#include <gst/gst.h>
+
+#include <fstream>
+#include <vector>
+
+G_BEGIN_DECLS
+
+/* ZED columnar file layout (all values little endian)
+ *
+ * File header:
+ *   char[8]  magic "ZEDCOL01"
+ *   guint32  column count (N)
+ *   guint32  reserved (0)
+ *   N x { guint8 type; guint8 name_len; char name[name_len]; }
+ *   zero padding to an 8 bytes boundary
+ *
+ * Row group (repeated):
+ *   char[4]  magic "ZRGP"
+ *   guint32  row count (R)
+ *   N x guint64 column chunk size in bytes
+ *   N x { column chunk data (R values); zero padding to an 8 bytes boundary }
+ *
+ * Footer (written on close):
+ *   G x guint64 absolute file offset of each row group
+ *   guint64  total row count
+ *   guint32  row group count (G)
+ *   char[4]  magic "ZEND"
+ *
+ * Every column chunk starts on an 8 bytes boundary so that it can be
+ * directly cast to a typed array when the file is memory-mapped.
+ * A file truncated by a crash is readable up to its last complete row group.
+ */
+
+#define GST_ZED_COLUMNAR_MAGIC "ZEDCOL01"
+#define GST_ZED_COLUMNAR_RG_MAGIC "ZRGP"
+#define GST_ZED_COLUMNAR_END_MAGIC "ZEND"
+
+typedef enum {
+    GST_ZED_COLUMN_U8 = 0,
+    GST_ZED_COLUMN_I32 = 1,
+    GST_ZED_COLUMN_U32 = 2,
+    GST_ZED_COLUMN_U64 = 3,
+    GST_ZED_COLUMN_F32 = 4,
+} GstZedColumnType;
+
+#define GST_TYPE_ZED_DATA_COLUMNAR_SINK (gst_zeddatacolumnarsink_get_type())
+#define GST_DATA_COLUMNAR_SINK(obj)                                                                \
+    (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_ZED_DATA_COLUMNAR_SINK, GstZedDataColumnarSink))
+#define GST_DATA_COLUMNAR_SINK_CLASS(klass)                                                        \
+    (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_ZED_DATA_COLUMNAR_SINK,                             \
+                             GstZedDataColumnarSinkClass))
+#define GST_IS_DATA_COLUMNAR_SINK(obj)                                                             \
+    (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_ZED_DATA_COLUMNAR_SINK))
+#define GST_IS_DATA_COLUMNAR_SINK_CLASS(klass)                                                     \
+    (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_ZED_DATA_COLUMNAR_SINK))
+#define GST_DATA_COLUMNAR_SINK_CAST(obj) ((GstZedDataColumnarSink *) (obj))
+
+typedef struct _GstZedDataColumnarSink GstZedDataColumnarSink;
+typedef struct _GstZedDataColumnarSinkClass GstZedDataColumnarSinkClass;
+
+struct _GstZedDataColumnarSink {
+    GstBaseSink parent;
+
+    std::ofstream *out_file_ptr;
+
+    // Per-column buffers of the row group being filled
+    std::vector<std::vector<guint8>> *columns;
+    guint rows_in_group;
+    guint64 total_rows;
+    guint64 file_offset;
+    std::vector<guint64> *row_group_offsets;
+
+    // Properties
+    GString *filename;
+    guint row_group_size;
+};
+
+struct _GstZedDataColumnarSinkClass {
+    GstBaseSinkClass parent_class;
+};
+
+G_GNUC_INTERNAL GType gst_zeddatacolumnarsink_get_type(void);
+
+G_END_DECLS
+
+#endif   // #ifndef _GST_ZED_DATA_COLUMNAR_SINK_H
@@ -22,6 +22,7 @@
 #include "gstzeddatacsvsink.h"
 
 #include <string>
+#include <sstream>
 #include <iomanip>
 #include <gst/gstformat.h>
 
@@ -37,17 +38,41 @@ GST_DEBUG_CATEGORY_STATIC (gst_zeddatacsvsink_debug);
 
 #define DEFAULT_PROP_LOCATION   ""
 #define DEFAULT_PROP_APPEND     FALSE
+#define DEFAULT_PROP_MAX_SIZE_BYTES 0
+#define DEFAULT_PROP_MAX_DURATION   0
 
 #define CSV_SEP ","
 
+// Maximum number of rows waiting for the writer thread: when the disk is too slow, render
+// blocks until the writer catches up instead of accumulating rows in memory
+#define MAX_QUEUED_ROWS 1024
+
 enum
 {
     PROP_0,
     PROP_LOCATION,
     PROP_APPEND,
+    PROP_MAX_SIZE_BYTES,
+    PROP_MAX_DURATION,
     PROP_LAST
 };
 
+enum
+{
+    SIGNAL_SEGMENT_ROLLOVER,
+    LAST_SIGNAL
+};
+
+static guint gst_zeddatacsvsink_signals[LAST_SIGNAL] = { 0 };
+
+// Item exchanged between render and the writer thread
+struct CsvRow
+{
+    GstClockTime timestamp;
+    std::string text;
+    gboolean stop;
+};
+
 static void gst_zeddatacsvsink_dispose(GObject * object);
 static void gst_zeddatacsvsink_finalize(GObject *object);
 
@@ -58,9 +83,13 @@ static void gst_zeddatacsvsink_get_property (GObject * object, guint prop_id,
 
 static gboolean gst_zeddatacsvsink_open_file(GstZedDataCsvSink* sink);
 static void gst_zeddatacsvsink_close_file(GstZedDataCsvSink* sink);
+static gpointer gst_zeddatacsvsink_writer_thread(gpointer data);
+static void gst_zeddatacsvsink_wait_writer(GstZedDataCsvSink* sink);
 
 static gboolean gst_zeddatacsvsink_start (GstBaseSink * sink);
 static gboolean gst_zeddatacsvsink_stop (GstBaseSink * sink);
+static gboolean gst_zeddatacsvsink_unlock (GstBaseSink * sink);
+static gboolean gst_zeddatacsvsink_unlock_stop (GstBaseSink * sink);
 
 static gboolean gst_zeddatacsvsink_event (GstBaseSink * sink, GstEvent * event);
 static GstFlowReturn gst_zeddatacsvsink_render (GstBaseSink * sink, GstBuffer * buffer);
@@ -90,6 +119,31 @@ static void gst_zeddatacsvsink_class_init (GstZedDataCsvSinkClass * klass)
                                                           DEFAULT_PROP_APPEND,
                                                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
+    g_object_class_install_property( gobject_class, PROP_MAX_SIZE_BYTES,
+                                     g_param_spec_uint64("max-size-bytes", "Max segment size",
+                                                         "Start a new CSV segment when the current one reaches this size in bytes (0 = disabled)",
+                                                         0, G_MAXUINT64, DEFAULT_PROP_MAX_SIZE_BYTES,
+                                                         (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property( gobject_class, PROP_MAX_DURATION,
+                                     g_param_spec_uint64("max-duration", "Max segment duration",
+                                                         "Start a new CSV segment when the current one covers this duration in nanoseconds (0 = disabled)",
+                                                         0, G_MAXUINT64, DEFAULT_PROP_MAX_DURATION,
+                                                         (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    /**
+     * GstZedDataCsvSink::segment-rollover:
+     * @sink: the sink
+     * @index: index of the new segment
+     * @location: file name of the new segment
+     *
+     * Emitted from the writer thread each time a new CSV segment is opened
+     * because of `max-size-bytes` or `max-duration`.
+     */
+    gst_zeddatacsvsink_signals[SIGNAL_SEGMENT_ROLLOVER] =
+            g_signal_new("segment-rollover", G_TYPE_FROM_CLASS(klass), G_SIGNAL_RUN_LAST,
+                         0, NULL, NULL, NULL, G_TYPE_NONE, 2, G_TYPE_UINT, G_TYPE_STRING);
+
     gst_element_class_set_static_metadata (gstelement_class,
                                            "ZED CSV File Sink",
                                            "Sink/File", "Write data stream to a file",
@@ -98,6 +152,8 @@ static void gst_zeddatacsvsink_class_init (GstZedDataCsvSinkClass * klass)
 
     gstbasesink_class->start = GST_DEBUG_FUNCPTR (gst_zeddatacsvsink_start);
     gstbasesink_class->stop = GST_DEBUG_FUNCPTR (gst_zeddatacsvsink_stop);
+    gstbasesink_class->unlock = GST_DEBUG_FUNCPTR (gst_zeddatacsvsink_unlock);
+    gstbasesink_class->unlock_stop = GST_DEBUG_FUNCPTR (gst_zeddatacsvsink_unlock_stop);
     gstbasesink_class->render = GST_DEBUG_FUNCPTR (gst_zeddatacsvsink_render);
     gstbasesink_class->event = GST_DEBUG_FUNCPTR (gst_zeddatacsvsink_event);
 }
@@ -108,9 +164,25 @@ static void gst_zeddatacsvsink_init(GstZedDataCsvSink * csvsink)
 
     csvsink->filename = g_string_new(DEFAULT_PROP_LOCATION);
     csvsink->append = DEFAULT_PROP_APPEND;
+    csvsink->max_size_bytes = DEFAULT_PROP_MAX_SIZE_BYTES;
+    csvsink->max_duration = DEFAULT_PROP_MAX_DURATION;
 
     csvsink->out_file_ptr = NULL;
 
+    csvsink->writer_thread = NULL;
+    csvsink->row_queue = NULL;
+    g_mutex_init(&csvsink->writer_lock);
+    g_cond_init(&csvsink->writer_cond);
+    csvsink->rows_queued = 0;
+    csvsink->rows_written = 0;
+    csvsink->writer_error = FALSE;
+    csvsink->flushing = FALSE;
+
+    csvsink->segment_index = 0;
+    csvsink->segment_bytes = 0;
+    csvsink->segment_start_ts = GST_CLOCK_TIME_NONE;
+    csvsink->segment_filename = g_string_new(DEFAULT_PROP_LOCATION);
+
     gst_base_sink_set_sync(GST_BASE_SINK(csvsink), FALSE);
 }
 
@@ -137,6 +209,12 @@ static void gst_zeddatacsvsink_finalize(GObject *object) {
     if (sink->filename) {
         g_string_free(sink->filename, TRUE);
     }
+    if (sink->segment_filename) {
+        g_string_free(sink->segment_filename, TRUE);
+    }
+
+    g_mutex_clear(&sink->writer_lock);
+    g_cond_clear(&sink->writer_cond);
 
     G_OBJECT_CLASS(gst_zeddatacsvsink_parent_class)->finalize(object);
 }
@@ -158,6 +236,12 @@ void gst_zeddatacsvsink_set_property (GObject * object, guint prop_id,
     case PROP_APPEND:
         sink->append = g_value_get_boolean (value);
         break;
+    case PROP_MAX_SIZE_BYTES:
+        sink->max_size_bytes = g_value_get_uint64 (value);
+        break;
+    case PROP_MAX_DURATION:
+        sink->max_duration = g_value_get_uint64 (value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
         break;
@@ -178,52 +262,136 @@ void gst_zeddatacsvsink_get_property (GObject * object, guint prop_id,
     case PROP_APPEND:
         g_value_set_boolean (value, sink->append);
         break;
+    case PROP_MAX_SIZE_BYTES:
+        g_value_set_uint64 (value, sink->max_size_bytes);
+        break;
+    case PROP_MAX_DURATION:
+        g_value_set_uint64 (value, sink->max_duration);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
         break;
     }
 }
 
-gboolean gst_zeddatacsvsink_open_file(GstZedDataCsvSink* sink)
+static std::string gst_zeddatacsvsink_segment_name(GstZedDataCsvSink* sink, guint index)
 {
-    GST_TRACE_OBJECT(sink, "Open file: %s", sink->filename->str);
+    std::string name = sink->filename->str;
 
-    if (sink->filename->len == 0) {
-        GST_ELEMENT_ERROR (sink, RESOURCE, NOT_FOUND,
-                           ("No file name specified for writing"), (NULL));
-        return FALSE;
+    if(sink->max_size_bytes == 0 && sink->max_duration == 0)
+    {
+        return name; // No rotation: keep the exact location
+    }
+
+    // "dir/name.ext" -> "dir/name_00000.ext"
+    size_t slash = name.find_last_of("/\\");
+    size_t dot = name.find_last_of('.');
+    if(dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        dot = name.size();
+    }
+
+    gchar idx[16];
+    g_snprintf(idx, sizeof(idx), "_%05u", index);
+
+    return name.substr(0, dot) + idx + name.substr(dot);
+}
+
+static void gst_zeddatacsvsink_write_header(GstZedDataCsvSink* sink)
+{
+    std::ostringstream header;
+    header << "TIMESTAMP,STREAM_TYPE,CAM_MODEL,GRAB_W,GRAB_H," <<
+              "POSE_VAL,POS_TRK_STATE,POS_X_[m],POS_Y_[m],POS_Z_[m],OR_X_[rad],OR_Y_[rad],OR_Z_[rad]," <<
+              "IMU_VAL,ACC_X_[m/s²],ACC_Y_[m/s²],ACC_Z_[m/s²],GYRO_X_[rad/s],GYROY_[rad/s],GYRO_Z_[rad/s]," <<
+              "MAG_VAL,MAG_X_[uT],MAG_Y_[uT],MAG_Z_[uT]," <<
+              "ENV_VAL,TEMP_[°C],PRESS_[hPa]," <<
+              "TEMP_VAL,TEMP_L_[°C],TEMP_R_[°C]" <<
+              "\n";
+
+    const std::string& str = header.str();
+    sink->out_file_ptr->write(str.data(), str.size());
+    sink->segment_bytes += str.size();
+}
+
+static gboolean gst_zeddatacsvsink_open_segment(GstZedDataCsvSink* sink, guint index)
+{
+    std::string name = gst_zeddatacsvsink_segment_name(sink, index);
+
+    GST_TRACE_OBJECT(sink, "Open segment %u: %s", index, name.c_str());
+
+    if(sink->out_file_ptr)
+    {
+        if(sink->out_file_ptr->is_open())
+        {
+            sink->out_file_ptr->flush();
+            sink->out_file_ptr->close();
+        }
+        delete sink->out_file_ptr;
+        sink->out_file_ptr = NULL;
     }
 
     if(sink->append)
     {
         GST_TRACE_OBJECT( sink, "Opening in append mode..." );
-        sink->out_file_ptr = new std::ofstream(sink->filename->str, std::ios::out | std::ios::app);
+        sink->out_file_ptr = new std::ofstream(name.c_str(), std::ios::out | std::ios::app);
         GST_TRACE_OBJECT( sink, "... open." );
     }
     else
     {
         GST_TRACE_OBJECT( sink, "Opening..." );
         sink->out_file_ptr =
-            new std::ofstream(sink->filename->str, std::ios::out | std::ios::trunc);
+            new std::ofstream(name.c_str(), std::ios::out | std::ios::trunc);
         GST_TRACE_OBJECT( sink, "... open." );
-
-        *sink->out_file_ptr << "TIMESTAMP,STREAM_TYPE,CAM_MODEL,GRAB_W,GRAB_H," <<
-                               "POSE_VAL,POS_TRK_STATE,POS_X_[m],POS_Y_[m],POS_Z_[m],OR_X_[rad],OR_Y_[rad],OR_Z_[rad]," <<
-                               "IMU_VAL,ACC_X_[m/s²],ACC_Y_[m/s²],ACC_Z_[m/s²],GYRO_X_[rad/s],GYROY_[rad/s],GYRO_Z_[rad/s]," <<
-                               "MAG_VAL,MAG_X_[uT],MAG_Y_[uT],MAG_Z_[uT]," <<
-                               "ENV_VAL,TEMP_[°C],PRESS_[hPa]," <<
-                               "TEMP_VAL,TEMP_L_[°C],TEMP_R_[°C]" <<
-                               std::endl;
     }
 
     if(!sink->out_file_ptr || !sink->out_file_ptr->good() )
+    {
+        return FALSE;
+    }
+
+    g_string_assign(sink->segment_filename, name.c_str());
+    sink->segment_index = index;
+    sink->segment_start_ts = GST_CLOCK_TIME_NONE;
+
+    // Each segment starts with its own header, unless appending to an existing file, whose
+    // current size counts for the rollover
+    sink->out_file_ptr->seekp(0, std::ios::end);
+    std::streamoff size = sink->out_file_ptr->tellp();
+    sink->segment_bytes = size > 0 ? (guint64) size : 0;
+    if(size <= 0)
+    {
+        gst_zeddatacsvsink_write_header(sink);
+    }
+
+    return sink->out_file_ptr->good();
+}
+
+gboolean gst_zeddatacsvsink_open_file(GstZedDataCsvSink* sink)
+{
+    GST_TRACE_OBJECT(sink, "Open file: %s", sink->filename->str);
+
+    if (sink->filename->len == 0) {
+        GST_ELEMENT_ERROR (sink, RESOURCE, NOT_FOUND,
+                           ("No file name specified for writing"), (NULL));
+        return FALSE;
+    }
+
+    // The first segment is opened here so that a wrong location fails the state change
+    if(!gst_zeddatacsvsink_open_segment(sink, 0))
     {
         GST_ELEMENT_ERROR (sink, RESOURCE, NOT_FOUND,
                            ("Error opening CSV file for writing"), (NULL));
         return FALSE;
     }
 
-    GST_TRACE_OBJECT(sink, "File opened: %s", sink->filename->str);
+    sink->rows_queued = 0;
+    sink->rows_written = 0;
+    g_atomic_int_set(&sink->writer_error, FALSE);
+
+    sink->row_queue = g_async_queue_new();
+    sink->writer_thread = g_thread_new("zedcsvwriter", gst_zeddatacsvsink_writer_thread, sink);
+
+    GST_TRACE_OBJECT(sink, "File opened: %s", sink->segment_filename->str);
 
     return TRUE;
 }
@@ -232,6 +400,23 @@ void gst_zeddatacsvsink_close_file(GstZedDataCsvSink* sink)
 {
     GST_TRACE_OBJECT( sink, "Close File" );
 
+    if(sink->writer_thread)
+    {
+        CsvRow* stop_row = new CsvRow;
+        stop_row->timestamp = GST_CLOCK_TIME_NONE;
+        stop_row->stop = TRUE;
+        g_async_queue_push(sink->row_queue, stop_row);
+
+        g_thread_join(sink->writer_thread);
+        sink->writer_thread = NULL;
+    }
+
+    if(sink->row_queue)
+    {
+        g_async_queue_unref(sink->row_queue);
+        sink->row_queue = NULL;
+    }
+
     if(sink->out_file_ptr && sink->out_file_ptr->is_open())
     {
         sink->out_file_ptr->flush();
@@ -239,6 +424,101 @@ void gst_zeddatacsvsink_close_file(GstZedDataCsvSink* sink)
     }
 }
 
+static gboolean gst_zeddatacsvsink_rollover_needed(GstZedDataCsvSink* sink, CsvRow* row)
+{
+    if(sink->max_size_bytes > 0 && sink->segment_bytes > 0 &&
+       sink->segment_bytes + row->text.size() > sink->max_size_bytes)
+    {
+        return TRUE;
+    }
+
+    if(sink->max_duration > 0 && GST_CLOCK_TIME_IS_VALID(sink->segment_start_ts) &&
+       GST_CLOCK_TIME_IS_VALID(row->timestamp) &&
+       row->timestamp >= sink->segment_start_ts + sink->max_duration)
+    {
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+gpointer gst_zeddatacsvsink_writer_thread(gpointer data)
+{
+    GstZedDataCsvSink* sink = GST_DATA_CSV_SINK(data);
+
+    GST_DEBUG_OBJECT( sink, "Writer thread started" );
+
+    while(TRUE)
+    {
+        CsvRow* row = (CsvRow*) g_async_queue_pop(sink->row_queue);
+
+        if(row->stop)
+        {
+            delete row;
+            break;
+        }
+
+        if(!g_atomic_int_get(&sink->writer_error))
+        {
+            if(gst_zeddatacsvsink_rollover_needed(sink, row))
+            {
+                guint next_index = sink->segment_index + 1;
+                if(gst_zeddatacsvsink_open_segment(sink, next_index))
+                {
+                    GST_INFO_OBJECT( sink, "New CSV segment: %s", sink->segment_filename->str );
+                    g_signal_emit(sink, gst_zeddatacsvsink_signals[SIGNAL_SEGMENT_ROLLOVER], 0,
+                                  next_index, sink->segment_filename->str);
+                }
+                else
+                {
+                    GST_ELEMENT_ERROR (sink, RESOURCE, OPEN_WRITE,
+                                       ("Error opening CSV segment for writing"), (NULL));
+                    g_atomic_int_set(&sink->writer_error, TRUE);
+                }
+            }
+
+            if(!g_atomic_int_get(&sink->writer_error))
+            {
+                if(!GST_CLOCK_TIME_IS_VALID(sink->segment_start_ts))
+                {
+                    sink->segment_start_ts = row->timestamp;
+                }
+
+                sink->out_file_ptr->write(row->text.data(), row->text.size());
+                sink->segment_bytes += row->text.size();
+
+                if(!sink->out_file_ptr->good())
+                {
+                    GST_ELEMENT_ERROR (sink, RESOURCE, WRITE,
+                                       ("Error writing CSV file"), (NULL));
+                    g_atomic_int_set(&sink->writer_error, TRUE);
+                }
+            }
+        }
+
+        delete row;
+
+        g_mutex_lock(&sink->writer_lock);
+        sink->rows_written++;
+        g_cond_broadcast(&sink->writer_cond);
+        g_mutex_unlock(&sink->writer_lock);
+    }
+
+    GST_DEBUG_OBJECT( sink, "Writer thread stopped" );
+
+    return NULL;
+}
+
+void gst_zeddatacsvsink_wait_writer(GstZedDataCsvSink* sink)
+{
+    g_mutex_lock(&sink->writer_lock);
+    while(sink->rows_written < sink->rows_queued && !sink->flushing)
+    {
+        g_cond_wait(&sink->writer_cond, &sink->writer_lock);
+    }
+    g_mutex_unlock(&sink->writer_lock);
+}
+
 gboolean gst_zeddatacsvsink_start(GstBaseSink* sink)
 {
     GstZedDataCsvSink* csvsink = GST_DATA_CSV_SINK(sink);
@@ -259,6 +539,34 @@ gboolean gst_zeddatacsvsink_stop (GstBaseSink * sink)
     return TRUE;
 }
 
+// Called on flush and on state changes to wake up render waiting for the writer thread
+gboolean gst_zeddatacsvsink_unlock (GstBaseSink * sink)
+{
+    GstZedDataCsvSink* csvsink = GST_DATA_CSV_SINK(sink);
+
+    GST_TRACE_OBJECT( csvsink, "Unlock" );
+
+    g_mutex_lock(&csvsink->writer_lock);
+    csvsink->flushing = TRUE;
+    g_cond_broadcast(&csvsink->writer_cond);
+    g_mutex_unlock(&csvsink->writer_lock);
+
+    return TRUE;
+}
+
+gboolean gst_zeddatacsvsink_unlock_stop (GstBaseSink * sink)
+{
+    GstZedDataCsvSink* csvsink = GST_DATA_CSV_SINK(sink);
+
+    GST_TRACE_OBJECT( csvsink, "Unlock stop" );
+
+    g_mutex_lock(&csvsink->writer_lock);
+    csvsink->flushing = FALSE;
+    g_mutex_unlock(&csvsink->writer_lock);
+
+    return TRUE;
+}
+
 gboolean gst_zeddatacsvsink_event (GstBaseSink * sink, GstEvent * event)
 {
     GstEventType type;
@@ -270,9 +578,15 @@ gboolean gst_zeddatacsvsink_event (GstBaseSink * sink, GstEvent * event)
 
     switch (type) {
     case GST_EVENT_EOS:
-        if(csvsink->out_file_ptr && csvsink->out_file_ptr->is_open())
+        if(csvsink->writer_thread)
         {
-            csvsink->out_file_ptr->flush();
+            // Make sure all the pending rows are on disk before EOS is posted
+            // (the writer is idle afterwards, render is not called during EOS)
+            gst_zeddatacsvsink_wait_writer(csvsink);
+            if(csvsink->out_file_ptr && csvsink->out_file_ptr->is_open())
+            {
+                csvsink->out_file_ptr->flush();
+            }
         }
         break;
     default:
@@ -291,11 +605,18 @@ GstFlowReturn gst_zeddatacsvsink_render( GstBaseSink * sink, GstBuffer* buf )
 
     GST_TRACE_OBJECT( csvsink, "Render" );
 
+    if(g_atomic_int_get(&csvsink->writer_error))
+    {
+        return GST_FLOW_ERROR;
+    }
+
     if(gst_buffer_map(buf, &map_in, GST_MAP_READ))
     {
+        std::ostringstream row;
+
         // ----> Timestamp
         GstClockTime timestamp = GST_BUFFER_TIMESTAMP (buf);
-        *csvsink->out_file_ptr << timestamp << CSV_SEP;
+        row << timestamp << CSV_SEP;
         // <---  Timestamp
 
         GST_TRACE_OBJECT( csvsink, "Input buffer size %lu B", map_in.size );
@@ -304,10 +625,10 @@ GstFlowReturn gst_zeddatacsvsink_render( GstBaseSink * sink, GstBuffer* buf )
         GstZedSrcMeta* meta = (GstZedSrcMeta*)map_in.data;
 
         // ----> Info
-        *csvsink->out_file_ptr << meta->info.stream_type << CSV_SEP;
-        *csvsink->out_file_ptr << meta->info.cam_model << CSV_SEP;
-        *csvsink->out_file_ptr << meta->info.grab_single_frame_width << CSV_SEP;
-        *csvsink->out_file_ptr << meta->info.grab_single_frame_height << CSV_SEP;
+        row << meta->info.stream_type << CSV_SEP;
+        row << meta->info.cam_model << CSV_SEP;
+        row << meta->info.grab_single_frame_width << CSV_SEP;
+        row << meta->info.grab_single_frame_height << CSV_SEP;
 
         GST_LOG (" * [META] Stream type: %d", meta->info.stream_type );
         GST_LOG (" * [META] Camera model: %d", meta->info.cam_model );
@@ -316,14 +637,14 @@ GstFlowReturn gst_zeddatacsvsink_render( GstBaseSink * sink, GstBuffer* buf )
 
         // ----> Camera Pose
 
-        *csvsink->out_file_ptr << meta->pose.pose_avail << CSV_SEP;
-        *csvsink->out_file_ptr << meta->pose.pos_tracking_state << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->pose.pos[0]/1000. << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->pose.pos[1]/1000. << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->pose.pos[2]/1000. << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->pose.orient[0] << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->pose.orient[1] << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->pose.orient[2] << CSV_SEP;
+        row << meta->pose.pose_avail << CSV_SEP;
+        row << meta->pose.pos_tracking_state << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->pose.pos[0]/1000. << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->pose.pos[1]/1000. << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->pose.pos[2]/1000. << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->pose.orient[0] << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->pose.orient[1] << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->pose.orient[2] << CSV_SEP;
 
         if( meta->pose.pose_avail==TRUE )
         {
@@ -341,26 +662,26 @@ GstFlowReturn gst_zeddatacsvsink_render( GstBaseSink * sink, GstBuffer* buf )
         // <---- Camera Pose
 
         // ----> Sensors
-        *csvsink->out_file_ptr << meta->sens.imu.imu_avail << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->sens.imu.acc[0] << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->sens.imu.acc[1] << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->sens.imu.acc[2] << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->sens.imu.gyro[0] << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->sens.imu.gyro[1] << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->sens.imu.gyro[2] << CSV_SEP;
-
-        *csvsink->out_file_ptr << meta->sens.mag.mag_avail << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->sens.mag.mag[0] << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->sens.mag.mag[1] << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(6) << meta->sens.mag.mag[2] << CSV_SEP;
-
-        *csvsink->out_file_ptr << meta->sens.env.env_avail << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(2) << meta->sens.env.temp << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(2) << meta->sens.env.press << CSV_SEP;
-
-        *csvsink->out_file_ptr << meta->sens.temp.temp_avail << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(2) << meta->sens.temp.temp_cam_left << CSV_SEP;
-        *csvsink->out_file_ptr << std::fixed << std::setprecision(2) << meta->sens.temp.temp_cam_right;
+        row << meta->sens.imu.imu_avail << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->sens.imu.acc[0] << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->sens.imu.acc[1] << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->sens.imu.acc[2] << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->sens.imu.gyro[0] << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->sens.imu.gyro[1] << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->sens.imu.gyro[2] << CSV_SEP;
+
+        row << meta->sens.mag.mag_avail << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->sens.mag.mag[0] << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->sens.mag.mag[1] << CSV_SEP;
+        row << std::fixed << std::setprecision(6) << meta->sens.mag.mag[2] << CSV_SEP;
+
+        row << meta->sens.env.env_avail << CSV_SEP;
+        row << std::fixed << std::setprecision(2) << meta->sens.env.temp << CSV_SEP;
+        row << std::fixed << std::setprecision(2) << meta->sens.env.press << CSV_SEP;
+
+        row << meta->sens.temp.temp_avail << CSV_SEP;
+        row << std::fixed << std::setprecision(2) << meta->sens.temp.temp_cam_left << CSV_SEP;
+        row << std::fixed << std::setprecision(2) << meta->sens.temp.temp_cam_right;
 
         if( meta->sens.sens_avail==TRUE )
         {
@@ -385,10 +706,37 @@ GstFlowReturn gst_zeddatacsvsink_render( GstBaseSink * sink, GstBuffer* buf )
         // <---- Sensors
 
         // endline
-        *csvsink->out_file_ptr << std::endl;
+        row << "\n";
 
         // Release incoming buffer
         gst_buffer_unmap( buf, &map_in );
+
+        // Hand the row over to the writer thread
+        CsvRow* csv_row = new CsvRow;
+        csv_row->timestamp = timestamp;
+        csv_row->text = row.str();
+        csv_row->stop = FALSE;
+
+        g_mutex_lock(&csvsink->writer_lock);
+        if(csvsink->rows_queued - csvsink->rows_written >= MAX_QUEUED_ROWS)
+        {
+            GST_DEBUG_OBJECT( csvsink, "Writer queue full, waiting for the disk" );
+            while(csvsink->rows_queued - csvsink->rows_written >= MAX_QUEUED_ROWS &&
+                  !csvsink->flushing)
+            {
+                g_cond_wait(&csvsink->writer_cond, &csvsink->writer_lock);
+            }
+        }
+        if(csvsink->flushing)
+        {
+            g_mutex_unlock(&csvsink->writer_lock);
+            delete csv_row;
+            return GST_FLOW_FLUSHING;
+        }
+        csvsink->rows_queued++;
+        g_mutex_unlock(&csvsink->writer_lock);
+
+        g_async_queue_push(csvsink->row_queue, csv_row);
     }
     else
     {
@@ -51,9 +51,27 @@ struct _GstZedDataCsvSink
 
     std::ofstream* out_file_ptr;
 
+    // Writer thread: rows are formatted in render and written/rotated here
+    GThread* writer_thread;
+    GAsyncQueue* row_queue;
+    GMutex writer_lock;
+    GCond writer_cond;
+    guint64 rows_queued;
+    guint64 rows_written;
+    gboolean writer_error;   // set by the writer thread, accessed with g_atomic_int_*
+    gboolean flushing;       // render must not wait for the writer, protected by writer_lock
+
+    // Current segment
+    guint segment_index;
+    guint64 segment_bytes;
+    GstClockTime segment_start_ts;
+    GString *segment_filename;
+
     // Properties
     GString *filename;
     gboolean append;
+    guint64 max_size_bytes;
+    GstClockTime max_duration;
 };
 
 struct _GstZedDataCsvSinkClass {
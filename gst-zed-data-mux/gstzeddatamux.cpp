@@ -505,12 +505,14 @@ static GstFlowReturn gst_zeddatamux_chain_data(GstPad *pad, GstObject *parent, G
                     GST_TRACE("Copying video buffer %lu B", out_buf_size);
                     memcpy(map_out.data, map_store.data, out_buf_size);
 
-                    GstZedSrcMeta *meta = (GstZedSrcMeta *) buf;
-
-                    GST_TRACE("Adding metadata");
-                    gst_buffer_add_zed_src_meta(out_buf, meta->info, meta->pose, meta->sens,
-                                                meta->od_enabled, meta->obj_count, meta->objects,
-                                                meta->frame_id);
+                    GstZedSrcMeta meta;
+                    if (gst_zed_src_meta_parse_record(map_in.data, map_in.size, &meta)) {
+                        GST_TRACE("Adding metadata");
+                        gst_buffer_add_zed_src_meta_full(
+                            out_buf, meta.info, meta.pose, meta.sens, meta.od_enabled,
+                            meta.od_count, gst_zed_src_meta_od_objects(&meta), meta.bt_count,
+                            gst_zed_src_meta_bt_objects(&meta), meta.frame_id);
+                    }
 
                     // ----> Timestamp meta-data
                     GST_TRACE("Out buffer set timestamp");
@@ -557,9 +559,13 @@ static GstFlowReturn gst_zeddatamux_chain_data(GstPad *pad, GstObject *parent, G
                 filter->last_data_buf =
                     gst_buffer_new_allocate(NULL, filter->last_data_buf_size, NULL);
             } else if (map_in.size != filter->last_data_buf_size) {
-                GST_TRACE("Resizing stored data buffer");
+                // The record size depends on the number of detected objects: the stored buffer
+                // cannot be grown in place
+                GST_TRACE("Reallocating stored data buffer");
+                gst_buffer_unref(filter->last_data_buf);
                 filter->last_data_buf_size = map_in.size;
-                gst_buffer_resize(filter->last_data_buf, 0, filter->last_data_buf_size);
+                filter->last_data_buf =
+                    gst_buffer_new_allocate(NULL, filter->last_data_buf_size, NULL);
             }
 
             if (!GST_IS_BUFFER(filter->last_data_buf)) {
@@ -643,12 +649,14 @@ static GstFlowReturn gst_zeddatamux_chain_video(GstPad *pad, GstObject *parent,
                     GST_TRACE("Copying video buffer %lu B", map_in.size);
                     memcpy(map_out.data, map_in.data, map_in.size);
 
-                    GstZedSrcMeta *meta = (GstZedSrcMeta *) map_store.data;
-
-                    GST_TRACE("Adding metadata");
-                    gst_buffer_add_zed_src_meta(out_buf, meta->info, meta->pose, meta->sens,
-                                                meta->od_enabled, meta->obj_count, meta->objects,
-                                                meta->frame_id);
+                    GstZedSrcMeta meta;
+                    if (gst_zed_src_meta_parse_record(map_store.data, map_store.size, &meta)) {
+                        GST_TRACE("Adding metadata");
+                        gst_buffer_add_zed_src_meta_full(
+                            out_buf, meta.info, meta.pose, meta.sens, meta.od_enabled,
+                            meta.od_count, gst_zed_src_meta_od_objects(&meta), meta.bt_count,
+                            gst_zed_src_meta_bt_objects(&meta), meta.frame_id);
+                    }
 
                     // ----> Timestamp meta-data
                     GST_TRACE("Out buffer set timestamp");
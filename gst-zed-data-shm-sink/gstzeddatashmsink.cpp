@@ -0,0 +1,405 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzeddatashmsink.h"
+#include "gstzedshmlayout.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "gst-zed-meta/gstzedmeta.h"
+
+static GstStaticPadTemplate sink_factory = GST_STATIC_PAD_TEMPLATE(
+    "sink", GST_PAD_SINK, GST_PAD_ALWAYS, GST_STATIC_CAPS("application/data"));
+
+GST_DEBUG_CATEGORY_STATIC(gst_zeddatashmsink_debug);
+#define GST_CAT_DEFAULT gst_zeddatashmsink_debug
+
+#define DEFAULT_PROP_SHM_NAME "/zed_data"
+#define DEFAULT_PROP_NUM_SLOTS 16
+#define DEFAULT_PROP_MAX_RECORD_SIZE 0
+#define DEFAULT_PROP_UNLINK TRUE
+// Objects of the records that fit in the slots when `max-record-size` is 0
+#define DEFAULT_SLOT_OBJECTS 256
+
+enum { PROP_0, PROP_SHM_NAME, PROP_NUM_SLOTS, PROP_MAX_RECORD_SIZE, PROP_UNLINK, PROP_LAST };
+
+static void gst_zeddatashmsink_finalize(GObject *object);
+
+static void gst_zeddatashmsink_set_property(GObject *object, guint prop_id, const GValue *value,
+                                            GParamSpec *pspec);
+static void gst_zeddatashmsink_get_property(GObject *object, guint prop_id, GValue *value,
+                                            GParamSpec *pspec);
+
+static gboolean gst_zeddatashmsink_open_shm(GstZedDataShmSink *sink);
+static void gst_zeddatashmsink_close_shm(GstZedDataShmSink *sink);
+
+static gboolean gst_zeddatashmsink_start(GstBaseSink *sink);
+static gboolean gst_zeddatashmsink_stop(GstBaseSink *sink);
+
+static GstFlowReturn gst_zeddatashmsink_render(GstBaseSink *sink, GstBuffer *buffer);
+
+G_DEFINE_TYPE(GstZedDataShmSink, gst_zeddatashmsink, GST_TYPE_BASE_SINK);
+
+static void gst_zeddatashmsink_class_init(GstZedDataShmSinkClass *klass) {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass *gstelement_class = GST_ELEMENT_CLASS(klass);
+    GstBaseSinkClass *gstbasesink_class = GST_BASE_SINK_CLASS(klass);
+
+    gobject_class->finalize = gst_zeddatashmsink_finalize;
+
+    gobject_class->set_property = gst_zeddatashmsink_set_property;
+    gobject_class->get_property = gst_zeddatashmsink_get_property;
+
+    g_object_class_install_property(
+        gobject_class, PROP_SHM_NAME,
+        g_param_spec_string("shm-name", "Shared memory name",
+                            "Name of the POSIX shared memory object (see shm_open)",
+                            DEFAULT_PROP_SHM_NAME,
+                            (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_NUM_SLOTS,
+        g_param_spec_uint("num-slots", "Number of slots",
+                          "Number of records kept in the ring buffer", 1, 4096,
+                          DEFAULT_PROP_NUM_SLOTS,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_MAX_RECORD_SIZE,
+        g_param_spec_uint("max-record-size", "Max record size",
+                          "Maximum size in bytes of a record. The objects of bigger "
+                          "GstZedSrcMeta records are truncated, other bigger buffers are dropped "
+                          "[0: record of GstZedSrcMeta with up to 256 objects]",
+                          0, G_MAXINT32, DEFAULT_PROP_MAX_RECORD_SIZE,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_UNLINK,
+        g_param_spec_boolean("unlink", "Unlink on stop",
+                             "Remove the shared memory object when the element stops",
+                             DEFAULT_PROP_UNLINK,
+                             (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    gst_element_class_set_static_metadata(gstelement_class, "ZED Shared Memory Data Sink",
+                                          "Sink/Memory",
+                                          "Publish the latest data records into a shared memory "
+                                          "ring buffer for out-of-process readers",
+                                          "Stereolabs <support@stereolabs.com>");
+    gst_element_class_add_static_pad_template(gstelement_class, &sink_factory);
+
+    gstbasesink_class->start = GST_DEBUG_FUNCPTR(gst_zeddatashmsink_start);
+    gstbasesink_class->stop = GST_DEBUG_FUNCPTR(gst_zeddatashmsink_stop);
+    gstbasesink_class->render = GST_DEBUG_FUNCPTR(gst_zeddatashmsink_render);
+}
+
+static void gst_zeddatashmsink_init(GstZedDataShmSink *shmsink) {
+    GST_TRACE_OBJECT(shmsink, "Init");
+
+    shmsink->shm_name = g_string_new(DEFAULT_PROP_SHM_NAME);
+    shmsink->num_slots = DEFAULT_PROP_NUM_SLOTS;
+    shmsink->max_record_size = DEFAULT_PROP_MAX_RECORD_SIZE;
+    shmsink->unlink_on_stop = DEFAULT_PROP_UNLINK;
+
+    shmsink->shm_fd = -1;
+    shmsink->shm_base = NULL;
+    shmsink->shm_size = 0;
+    shmsink->write_count = 0;
+    shmsink->truncation_warned = FALSE;
+
+    gst_base_sink_set_sync(GST_BASE_SINK(shmsink), FALSE);
+}
+
+static void gst_zeddatashmsink_finalize(GObject *object) {
+    GstZedDataShmSink *sink = GST_DATA_SHM_SINK(object);
+
+    GST_TRACE_OBJECT(sink, "Finalize");
+
+    if (sink->shm_name) {
+        g_string_free(sink->shm_name, TRUE);
+    }
+
+    G_OBJECT_CLASS(gst_zeddatashmsink_parent_class)->finalize(object);
+}
+
+void gst_zeddatashmsink_set_property(GObject *object, guint prop_id, const GValue *value,
+                                     GParamSpec *pspec) {
+    GstZedDataShmSink *sink = GST_DATA_SHM_SINK(object);
+
+    GST_TRACE_OBJECT(sink, "Set property");
+
+    switch (prop_id) {
+    case PROP_SHM_NAME:
+        g_string_assign(sink->shm_name, g_value_get_string(value));
+        break;
+    case PROP_NUM_SLOTS:
+        sink->num_slots = g_value_get_uint(value);
+        break;
+    case PROP_MAX_RECORD_SIZE:
+        sink->max_record_size = g_value_get_uint(value);
+        break;
+    case PROP_UNLINK:
+        sink->unlink_on_stop = g_value_get_boolean(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+void gst_zeddatashmsink_get_property(GObject *object, guint prop_id, GValue *value,
+                                     GParamSpec *pspec) {
+    GstZedDataShmSink *sink = GST_DATA_SHM_SINK(object);
+
+    GST_TRACE_OBJECT(sink, "Get property");
+
+    switch (prop_id) {
+    case PROP_SHM_NAME:
+        g_value_set_string(value, sink->shm_name->str);
+        break;
+    case PROP_NUM_SLOTS:
+        g_value_set_uint(value, sink->num_slots);
+        break;
+    case PROP_MAX_RECORD_SIZE:
+        g_value_set_uint(value, sink->max_record_size);
+        break;
+    case PROP_UNLINK:
+        g_value_set_boolean(value, sink->unlink_on_stop);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+gboolean gst_zeddatashmsink_open_shm(GstZedDataShmSink *sink) {
+    GST_TRACE_OBJECT(sink, "Open shared memory: %s", sink->shm_name->str);
+
+    if (sink->shm_name->len < 2 || sink->shm_name->str[0] != '/' ||
+        strchr(sink->shm_name->str + 1, '/') != NULL) {
+        GST_ELEMENT_ERROR(sink, RESOURCE, SETTINGS, ("Invalid shared memory name"),
+                          ("'%s' must be of the form '/name'", sink->shm_name->str));
+        return FALSE;
+    }
+
+    // Slots are fixed size while `zeddemux` records grow with the number of detected objects:
+    // they must hold at least a record without objects
+    if (sink->max_record_size > 0 && sink->max_record_size < sizeof(GstZedSrcMeta)) {
+        GST_ELEMENT_ERROR(sink, RESOURCE, SETTINGS, ("Invalid maximum record size"),
+                          ("max-record-size must be 0 or at least %" G_GSIZE_FORMAT " bytes",
+                           sizeof(GstZedSrcMeta)));
+        return FALSE;
+    }
+    guint64 payload_size =
+        sink->max_record_size > 0
+            ? sink->max_record_size
+            : sizeof(GstZedSrcMeta) + DEFAULT_SLOT_OBJECTS * sizeof(ZedObjectData);
+    guint64 stride = sizeof(ZedShmSlotHeader) + payload_size;
+    stride = (stride + ZED_SHM_ALIGN - 1) / ZED_SHM_ALIGN * ZED_SHM_ALIGN;
+
+    sink->shm_size = sizeof(ZedShmHeader) + stride * sink->num_slots;
+
+    sink->shm_fd = shm_open(sink->shm_name->str, O_CREAT | O_RDWR, 0644);
+    if (sink->shm_fd < 0) {
+        GST_ELEMENT_ERROR(sink, RESOURCE, OPEN_WRITE, ("Error opening shared memory"),
+                          ("shm_open(%s): %s", sink->shm_name->str, g_strerror(errno)));
+        return FALSE;
+    }
+
+    if (ftruncate(sink->shm_fd, sink->shm_size) != 0) {
+        GST_ELEMENT_ERROR(sink, RESOURCE, OPEN_WRITE, ("Error resizing shared memory"),
+                          ("ftruncate: %s", g_strerror(errno)));
+        gst_zeddatashmsink_close_shm(sink);
+        return FALSE;
+    }
+
+    sink->shm_base =
+        mmap(NULL, sink->shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, sink->shm_fd, 0);
+    if (sink->shm_base == MAP_FAILED) {
+        sink->shm_base = NULL;
+        GST_ELEMENT_ERROR(sink, RESOURCE, OPEN_WRITE, ("Error mapping shared memory"),
+                          ("mmap: %s", g_strerror(errno)));
+        gst_zeddatashmsink_close_shm(sink);
+        return FALSE;
+    }
+
+    // ----> Ring header
+    // A reader attached to a previous session sees a zeroed ring until the magic is set
+    memset(sink->shm_base, 0, sink->shm_size);
+
+    ZedShmHeader *hdr = static_cast<ZedShmHeader *>(sink->shm_base);
+    hdr->version = ZED_SHM_VERSION;
+    hdr->slot_count = sink->num_slots;
+    hdr->slot_payload_size = payload_size;
+    hdr->slot_stride = stride;
+    hdr->write_count.store(0, std::memory_order_relaxed);
+
+    for (guint s = 0; s < sink->num_slots; s++) {
+        // Never matches a valid index until the slot is written once
+        zed_shm_slot(sink->shm_base, s)->record_index = G_MAXUINT64;
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(hdr->magic, ZED_SHM_MAGIC, sizeof(hdr->magic));
+    // <---- Ring header
+
+    sink->write_count = 0;
+    sink->truncation_warned = FALSE;
+
+    GST_INFO_OBJECT(sink, "Shared memory '%s' ready: %u slots of %" G_GUINT64_FORMAT " B",
+                    sink->shm_name->str, sink->num_slots, payload_size);
+
+    return TRUE;
+}
+
+void gst_zeddatashmsink_close_shm(GstZedDataShmSink *sink) {
+    GST_TRACE_OBJECT(sink, "Close shared memory");
+
+    if (sink->shm_base) {
+        munmap(sink->shm_base, sink->shm_size);
+        sink->shm_base = NULL;
+    }
+
+    if (sink->shm_fd >= 0) {
+        close(sink->shm_fd);
+        sink->shm_fd = -1;
+
+        if (sink->unlink_on_stop) {
+            shm_unlink(sink->shm_name->str);
+        }
+    }
+}
+
+gboolean gst_zeddatashmsink_start(GstBaseSink *sink) {
+    GstZedDataShmSink *shmsink = GST_DATA_SHM_SINK(sink);
+
+    GST_TRACE_OBJECT(shmsink, "Start");
+
+    return gst_zeddatashmsink_open_shm(shmsink);
+}
+
+gboolean gst_zeddatashmsink_stop(GstBaseSink *sink) {
+    GstZedDataShmSink *shmsink = GST_DATA_SHM_SINK(sink);
+
+    GST_TRACE_OBJECT(shmsink, "Stop");
+
+    gst_zeddatashmsink_close_shm(shmsink);
+
+    return TRUE;
+}
+
+GstFlowReturn gst_zeddatashmsink_render(GstBaseSink *sink, GstBuffer *buf) {
+    GstZedDataShmSink *shmsink = GST_DATA_SHM_SINK(sink);
+
+    GstMapInfo map_in;
+
+    GST_TRACE_OBJECT(shmsink, "Render");
+
+    if (!gst_buffer_map(buf, &map_in, GST_MAP_READ)) {
+        GST_ELEMENT_ERROR(sink, RESOURCE, FAILED, ("Failed to map buffer for reading"), (NULL));
+        return GST_FLOW_ERROR;
+    }
+
+    ZedShmHeader *hdr = static_cast<ZedShmHeader *>(shmsink->shm_base);
+
+    // ----> Oversized records
+    // The objects that do not fit are dropped, the record keeps the metadata of the frame
+    gsize payload_size = map_in.size;
+    GstZedSrcMeta rec;
+    guint32 fit_objects = 0;
+    if (map_in.size > hdr->slot_payload_size) {
+        if (!gst_zed_src_meta_parse_record(map_in.data, map_in.size, &rec)) {
+            GST_WARNING_OBJECT(shmsink,
+                               "Record of %" G_GSIZE_FORMAT " B exceeds the slot size, dropped",
+                               map_in.size);
+            gst_buffer_unmap(buf, &map_in);
+            return GST_FLOW_OK;
+        }
+
+        fit_objects = (hdr->slot_payload_size - sizeof(GstZedSrcMeta)) / sizeof(ZedObjectData);
+        payload_size = sizeof(GstZedSrcMeta) + fit_objects * sizeof(ZedObjectData);
+
+        if (!shmsink->truncation_warned) {
+            GST_ELEMENT_WARNING(shmsink, RESOURCE, WRITE, ("Records truncated to the slot size"),
+                                ("Record with %u objects truncated to %u objects, increase "
+                                 "max-record-size to keep them all",
+                                 rec.obj_count, fit_objects));
+            shmsink->truncation_warned = TRUE;
+        }
+    }
+    // <---- Oversized records
+
+    // Frame ID from the attached metadata, from the payload for raw `zeddemux` dumps,
+    // or from the buffer offset
+    guint64 frame_id = GST_BUFFER_OFFSET(buf);
+    GstZedSrcMeta *meta = (GstZedSrcMeta *) gst_buffer_get_zed_src_meta(buf);
+    if (meta) {
+        frame_id = meta->frame_id;
+    } else if (map_in.size >= sizeof(GstZedSrcMeta)) {
+        frame_id = ((GstZedSrcMeta *) map_in.data)->frame_id;
+    }
+
+    // ----> Seqlock write
+    ZedShmSlotHeader *slot = zed_shm_slot(shmsink->shm_base, shmsink->write_count);
+    uint32_t seq = slot->seq.load(std::memory_order_relaxed);
+
+    slot->seq.store(seq + 1, std::memory_order_relaxed);   // odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->record_index = shmsink->write_count;
+    slot->frame_id = frame_id;
+    slot->timestamp = GST_BUFFER_TIMESTAMP(buf);
+    slot->payload_size = payload_size;
+    memcpy(zed_shm_slot_payload(slot), map_in.data, payload_size);
+    if (payload_size < map_in.size) {
+        // Object Detection results first, then Body Tracking results
+        GstZedSrcMeta *out = (GstZedSrcMeta *) zed_shm_slot_payload(slot);
+        out->obj_count = fit_objects;
+        out->od_count = MIN(rec.od_count, fit_objects);
+        out->bt_count = fit_objects - out->od_count;
+    }
+
+    slot->seq.store(seq + 2, std::memory_order_release);   // even: stable
+    // <---- Seqlock write
+
+    shmsink->write_count++;
+    hdr->write_count.store(shmsink->write_count, std::memory_order_release);
+
+    gst_buffer_unmap(buf, &map_in);
+
+    return GST_FLOW_OK;
+}
+
+static gboolean plugin_init(GstPlugin *plugin) {
+    GST_DEBUG_CATEGORY_INIT(gst_zeddatashmsink_debug, "zeddatashmsink", 0,
+                            "debug category for zeddatashmsink element");
+    gst_element_register(plugin, "zeddatashmsink", GST_RANK_NONE, gst_zeddatashmsink_get_type());
+
+    return TRUE;
+}
+
+GST_PLUGIN_DEFINE(GST_VERSION_MAJOR, GST_VERSION_MINOR, zeddatashmsink,
+                  "ZED Data shared memory sink", plugin_init, GST_PACKAGE_VERSION,
+                  GST_PACKAGE_LICENSE, GST_PACKAGE_NAME, GST_PACKAGE_ORIGIN)
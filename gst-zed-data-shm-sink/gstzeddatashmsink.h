@@ -0,0 +1,68 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef _GST_ZED_DATA_SHM_SINK_H
+#define _GST_ZED_DATA_SHM_SINK_H
+
+#include <gst/base/gstbasesink.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_ZED_DATA_SHM_SINK (gst_zeddatashmsink_get_type())
+#define GST_DATA_SHM_SINK(obj)                                                                     \
+    (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_ZED_DATA_SHM_SINK, GstZedDataShmSink))
+#define GST_DATA_SHM_SINK_CLASS(klass)                                                             \
+    (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_ZED_DATA_SHM_SINK, GstZedDataShmSinkClass))
+#define GST_IS_DATA_SHM_SINK(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_ZED_DATA_SHM_SINK))
+#define GST_IS_DATA_SHM_SINK_CLASS(klass)                                                          \
+    (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_ZED_DATA_SHM_SINK))
+#define GST_DATA_SHM_SINK_CAST(obj) ((GstZedDataShmSink *) (obj))
+
+typedef struct _GstZedDataShmSink GstZedDataShmSink;
+typedef struct _GstZedDataShmSinkClass GstZedDataShmSinkClass;
+
+struct _GstZedDataShmSink {
+    GstBaseSink parent;
+
+    // Shared memory mapping (see gstzedshmlayout.h)
+    gint shm_fd;
+    gpointer shm_base;
+    gsize shm_size;
+    guint64 write_count;
+    gboolean truncation_warned;   // oversized records already reported
+
+    // Properties
+    GString *shm_name;
+    guint num_slots;
+    guint max_record_size;
+    gboolean unlink_on_stop;
+};
+
+struct _GstZedDataShmSinkClass {
+    GstBaseSinkClass parent_class;
+};
+
+G_GNUC_INTERNAL GType gst_zeddatashmsink_get_type(void);
+
+G_END_DECLS
+
+#endif   // #ifndef _GST_ZED_DATA_SHM_SINK_H
@@ -0,0 +1,134 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef GST_ZED_SHM_LAYOUT_H
+#define GST_ZED_SHM_LAYOUT_H
+
+// Layout of the shared memory ring published by `zeddatashmsink`.
+// This header has no GStreamer dependency so that it can be included by
+// any out-of-process consumer.
+//
+// [ ZedShmHeader | slot 0 | slot 1 | ... | slot N-1 ]
+//
+// Each slot is a ZedShmSlotHeader followed by `slot_payload_size` bytes.
+// The single writer protects every slot with a sequence lock: `seq` is odd
+// while the slot is being written and even when it is stable. Readers never
+// block the writer, they retry when the sequence changed during the copy.
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+
+#define ZED_SHM_MAGIC "ZEDSHM01"
+#define ZED_SHM_VERSION 1
+#define ZED_SHM_ALIGN 64
+
+struct ZedShmHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t slot_count;
+    uint64_t slot_payload_size;   // max payload bytes per slot
+    uint64_t slot_stride;         // bytes between two slots (header included)
+    // Number of records published so far; the latest one is in slot
+    // (write_count - 1) % slot_count
+    std::atomic<uint64_t> write_count;
+    uint8_t reserved[ZED_SHM_ALIGN - 40];
+};
+
+struct ZedShmSlotHeader {
+    std::atomic<uint32_t> seq;
+    uint32_t reserved;
+    uint64_t record_index;   // position of the record in the stream (0, 1, 2, ...)
+    uint64_t frame_id;
+    uint64_t timestamp;   // buffer timestamp [ns]
+    uint64_t payload_size;
+    uint8_t pad[ZED_SHM_ALIGN - 40];
+};
+
+static_assert(sizeof(ZedShmHeader) == ZED_SHM_ALIGN, "ZedShmHeader must be cache line sized");
+static_assert(sizeof(ZedShmSlotHeader) == ZED_SHM_ALIGN,
+              "ZedShmSlotHeader must be cache line sized");
+
+inline ZedShmSlotHeader *zed_shm_slot(void *base, uint64_t index) {
+    ZedShmHeader *hdr = static_cast<ZedShmHeader *>(base);
+    uint8_t *slots = static_cast<uint8_t *>(base) + sizeof(ZedShmHeader);
+    return reinterpret_cast<ZedShmSlotHeader *>(slots +
+                                                (index % hdr->slot_count) * hdr->slot_stride);
+}
+
+inline uint8_t *zed_shm_slot_payload(ZedShmSlotHeader *slot) {
+    return reinterpret_cast<uint8_t *>(slot) + sizeof(ZedShmSlotHeader);
+}
+
+/* Copy the record with stream position `index` (0 = first record ever published).
+ * Returns false if the record is not published yet, was overwritten by the writer
+ * before it could be read, or if `max_size` is too small.
+ */
+inline bool zed_shm_read(void *base, uint64_t index, void *out, uint64_t max_size,
+                         uint64_t *frame_id, uint64_t *timestamp, uint64_t *size) {
+    ZedShmHeader *hdr = static_cast<ZedShmHeader *>(base);
+    ZedShmSlotHeader *slot = zed_shm_slot(base, index);
+
+    for (int attempt = 0; attempt < 16; attempt++) {
+        uint32_t seq1 = slot->seq.load(std::memory_order_acquire);
+        if (seq1 & 1) {
+            continue;   // write in progress
+        }
+
+        if (slot->record_index != index) {
+            return false;   // not yet published or already overwritten
+        }
+
+        uint64_t payload_size = slot->payload_size;
+        if (payload_size > max_size || payload_size > hdr->slot_payload_size) {
+            return false;
+        }
+        uint64_t fid = slot->frame_id;
+        uint64_t ts = slot->timestamp;
+        memcpy(out, zed_shm_slot_payload(slot), payload_size);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) == seq1 && slot->record_index == index) {
+            if (frame_id)
+                *frame_id = fid;
+            if (timestamp)
+                *timestamp = ts;
+            if (size)
+                *size = payload_size;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Copy the most recent record. */
+inline bool zed_shm_read_latest(void *base, void *out, uint64_t max_size, uint64_t *frame_id,
+                                uint64_t *timestamp, uint64_t *size) {
+    ZedShmHeader *hdr = static_cast<ZedShmHeader *>(base);
+    uint64_t count = hdr->write_count.load(std::memory_order_acquire);
+    if (count == 0) {
+        return false;
+    }
+    return zed_shm_read(base, count - 1, out, max_size, frame_id, timestamp, size);
+}
+
+#endif   // GST_ZED_SHM_LAYOUT_H
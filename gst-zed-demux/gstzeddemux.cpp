@@ -600,7 +600,7 @@ static GstFlowReturn gst_zeddemux_chain(GstPad *pad, GstObject *parent, GstBuffe
             }
 #endif
 
-        gsize data_size = sizeof(GstZedSrcMeta);
+        gsize data_size = gst_zed_src_meta_record_size(meta);
         GstBuffer *data_buf = gst_buffer_new_allocate(NULL, data_size, NULL);
 
         // Check if valid or go out
@@ -612,7 +612,7 @@ static GstFlowReturn gst_zeddemux_chain(GstPad *pad, GstObject *parent, GstBuffe
 
         if (gst_buffer_map(data_buf, &map_out_data, GST_MAP_WRITE)) {
             GST_TRACE("Copying data buffer %lu B", map_out_data.size);
-            memcpy(map_out_data.data, meta, map_out_data.size);
+            gst_zed_src_meta_write_record(meta, map_out_data.data, map_out_data.size);
 
             GST_TRACE("Data buffer set timestamp");
             GST_BUFFER_PTS(data_buf) = GST_BUFFER_PTS(buf);
@@ -660,9 +660,10 @@ static GstFlowReturn gst_zeddemux_chain(GstPad *pad, GstObject *parent, GstBuffe
             memcpy(map_out_left.data, map_in.data, map_out_left.size);
 
             if (meta) {
-                gst_buffer_add_zed_src_meta(left_proc_buf, meta->info, meta->pose, meta->sens,
-                                            meta->od_enabled, meta->obj_count, meta->objects,
-                                            meta->frame_id);
+                gst_buffer_add_zed_src_meta_full(left_proc_buf, meta->info, meta->pose, meta->sens,
+                                                 meta->od_enabled, meta->od_count,
+                                                 gst_zed_src_meta_od_objects(meta), meta->bt_count,
+                                                 gst_zed_src_meta_bt_objects(meta), meta->frame_id);
             }
 
             GST_TRACE("Left buffer set timestamp");
@@ -710,9 +711,10 @@ static GstFlowReturn gst_zeddemux_chain(GstPad *pad, GstObject *parent, GstBuffe
             memcpy(map_out_mono.data, map_in.data, map_out_mono.size);
 
             if (meta) {
-                gst_buffer_add_zed_src_meta(mono_proc_buf, meta->info, meta->pose, meta->sens,
-                                            meta->od_enabled, meta->obj_count, meta->objects,
-                                            meta->frame_id);
+                gst_buffer_add_zed_src_meta_full(mono_proc_buf, meta->info, meta->pose, meta->sens,
+                                                 meta->od_enabled, meta->od_count,
+                                                 gst_zed_src_meta_od_objects(meta), meta->bt_count,
+                                                 gst_zed_src_meta_bt_objects(meta), meta->frame_id);
             }
 
             GST_TRACE("Mono buffer set timestamp");
@@ -766,19 +768,16 @@ static GstFlowReturn gst_zeddemux_chain(GstPad *pad, GstObject *parent, GstBuffe
             } else {
                 GST_TRACE("Converting aux buffer %lu B", map_out_aux.size);
 
-                guint32 *gst_in_data = (guint32 *) (map_in.data + map_in.size / 2);
-                guint16 *gst_out_data = (guint16 *) map_out_aux.data;
-
-                for (unsigned long i = 0; i < map_out_aux.size / sizeof(guint16); i++) {
-                    float depth = (float) (*(gst_in_data++));
-                    *(gst_out_data++) = (guint16) depth;
-                }
+                gst_zeddemux_narrow_depth((const guint32 *) (map_in.data + map_in.size / 2),
+                                          (guint16 *) map_out_aux.data,
+                                          map_out_aux.size / sizeof(guint16));
             }
 
             if (meta) {
-                gst_buffer_add_zed_src_meta(aux_proc_buf, meta->info, meta->pose, meta->sens,
-                                            meta->od_enabled, meta->obj_count, meta->objects,
-                                            meta->frame_id);
+                gst_buffer_add_zed_src_meta_full(aux_proc_buf, meta->info, meta->pose, meta->sens,
+                                                 meta->od_enabled, meta->od_count,
+                                                 gst_zed_src_meta_od_objects(meta), meta->bt_count,
+                                                 gst_zed_src_meta_bt_objects(meta), meta->frame_id);
             }
 
             GST_TRACE("Aux buffer set timestamp");
@@ -59,6 +59,16 @@ struct _GstZedDemuxClass {
 
 GType gst_zeddemux_get_type(void);
 
+/* Convert the 32 bits depth values of the composite stream into the 16 bits values of the
+ * `src_aux` pad. `count` is the number of pixels.
+ */
+static inline void gst_zeddemux_narrow_depth(const guint32 *in, guint16 *out, gsize count) {
+    for (gsize i = 0; i < count; i++) {
+        float depth = (float) in[i];
+        out[i] = (guint16) depth;
+    }
+}
+
 G_END_DECLS
 
 #endif /* GST_ZEDDEMUX_H */
@@ -0,0 +1,450 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzeddepthcodec.h"
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// A 32 bits number needs at most 11 nibbles of 3 bits
+#define VLE_MAX_NIBBLES 11
+// A zigzag mapped 16 bits difference needs at most 18 bits, i.e. 6 nibbles
+#define VLE_MAX_VALUE_NIBBLES 6
+
+// ----> Nibble stream
+typedef struct {
+    guint8 *data;
+    guint8 *end;
+    guint32 word;
+    guint nibbles;
+    gboolean overflow;
+} RvlWriter;
+
+static inline void write_word(RvlWriter *w, guint32 word) {
+    if (w->data + 4 > w->end) {
+        w->overflow = TRUE;
+        return;
+    }
+    word = GUINT32_TO_LE(word);
+    memcpy(w->data, &word, 4);
+    w->data += 4;
+}
+
+static inline void write_nibble(RvlWriter *w, guint32 nibble) {
+    w->word = (w->word << 4) | nibble;
+    if (++w->nibbles == 8) {
+        write_word(w, w->word);
+        w->word = 0;
+        w->nibbles = 0;
+    }
+}
+
+static inline void write_vle(RvlWriter *w, guint32 value) {
+    // Fast path: small differences of smooth surfaces fit in a single nibble
+    if (value < 8) {
+        write_nibble(w, value);
+        return;
+    }
+    do {
+        guint32 nibble = value & 0x7;
+        value >>= 3;
+        if (value) {
+            nibble |= 0x8;
+        }
+        write_nibble(w, nibble);
+    } while (value);
+}
+
+static inline void flush_writer(RvlWriter *w) {
+    if (w->nibbles) {
+        write_word(w, w->word << (4 * (8 - w->nibbles)));
+        w->word = 0;
+        w->nibbles = 0;
+    }
+}
+
+/* Write 8 numbers smaller than 8, i.e. 8 single nibbles packed in `packed`, the first one in
+ * the most significant nibble.
+ */
+static inline void write_packed8(RvlWriter *w, guint32 packed) {
+    if (w->nibbles == 0) {
+        write_word(w, packed);
+        return;
+    }
+    guint shift = 4 * w->nibbles;
+    write_word(w, (w->word << (32 - shift)) | (packed >> shift));
+    w->word = packed & ((1u << shift) - 1);
+}
+
+typedef struct {
+    const guint8 *data;
+    const guint8 *end;
+    guint64 buf;   // bits to read, left aligned
+    guint bits;
+    gboolean error;
+} RvlReader;
+
+static inline void refill(RvlReader *r) {
+    if (r->bits <= 32 && r->data + 4 <= r->end) {
+        guint32 word;
+        memcpy(&word, r->data, 4);
+        r->buf |= (guint64) GUINT32_FROM_LE(word) << (32 - r->bits);
+        r->bits += 32;
+        r->data += 4;
+    }
+}
+
+static inline guint32 read_nibble(RvlReader *r) {
+    if (r->bits < 4) {
+        refill(r);
+        if (r->bits < 4) {
+            r->error = TRUE;
+            return 0;
+        }
+    }
+    guint32 nibble = (guint32) (r->buf >> 60);
+    r->buf <<= 4;
+    r->bits -= 4;
+    return nibble;
+}
+
+static inline guint32 read_vle(RvlReader *r) {
+    // Fast path: single nibble number
+    guint32 nibble = read_nibble(r);
+    if (!(nibble & 0x8)) {
+        return nibble;
+    }
+
+    guint32 value = nibble & 0x7;
+    guint shift = 3;
+    do {
+        nibble = read_nibble(r);
+        if (shift >= 32) {
+            r->error = TRUE;
+            return 0;
+        }
+        value |= (nibble & 0x7) << shift;
+        shift += 3;
+    } while (nibble & 0x8);
+    return value;
+}
+
+/* Read 8 numbers if all of them are single nibbles. Returns FALSE otherwise, without consuming
+ * anything.
+ */
+static inline gboolean read_packed8(RvlReader *r, guint32 *packed) {
+    if (r->bits < 32) {
+        refill(r);
+        if (r->bits < 32) {
+            return FALSE;
+        }
+    }
+    guint32 top = (guint32) (r->buf >> 32);
+    if (top & 0x88888888) {
+        return FALSE;
+    }
+    *packed = top;
+    r->buf <<= 32;
+    r->bits -= 32;
+    return TRUE;
+}
+// <---- Nibble stream
+
+// ----> Row kernels
+/* Number of consecutive pixels equal to zero (`zero` TRUE) or not equal to zero (`zero` FALSE)
+ * starting from `row[x]`, up to the end of the row.
+ */
+static inline guint run_length(const guint16 *row, guint x, guint width, gboolean zero) {
+    guint start = x;
+#if defined(__SSE2__)
+    const __m128i zeros = _mm_setzero_si128();
+    for (; x + 8 <= width; x += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (row + x));
+        guint mask = (guint) _mm_movemask_epi8(_mm_cmpeq_epi16(v, zeros));
+        if (!zero) {
+            mask = ~mask & 0xFFFF;
+        }
+        // `mask` has 2 bits set for each pixel of the run
+        if (mask != 0xFFFF) {
+            return x - start + (guint) __builtin_ctz(~mask) / 2;
+        }
+    }
+#elif defined(__ARM_NEON)
+    for (; x + 8 <= width; x += 8) {
+        uint16x8_t eq = vceqq_u16(vld1q_u16(row + x), vdupq_n_u16(0));
+        if (!zero) {
+            eq = vmvnq_u16(eq);
+        }
+        // One byte for each pixel, 0xFF when it belongs to the run
+        guint64 mask = vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(eq)), 0);
+        if (mask != G_GUINT64_CONSTANT(0xFFFFFFFFFFFFFFFF)) {
+            return x - start + (guint) __builtin_ctzll(~mask) / 8;
+        }
+    }
+#endif
+    for (; x < width; x++) {
+        if ((row[x] == 0) != (zero != FALSE)) {
+            break;
+        }
+    }
+    return x - start;
+}
+
+static inline void write_block8(RvlWriter *w, const guint32 *zz) {
+    if ((zz[0] | zz[1] | zz[2] | zz[3] | zz[4] | zz[5] | zz[6] | zz[7]) < 8) {
+        write_packed8(w, (zz[0] << 28) | (zz[1] << 24) | (zz[2] << 20) | (zz[3] << 16) |
+                             (zz[4] << 12) | (zz[5] << 8) | (zz[6] << 4) | zz[7]);
+        return;
+    }
+    for (int k = 0; k < 8; k++) {
+        write_vle(w, zz[k]);
+    }
+}
+
+/* Write the zigzag mapped differences of the `count` valid pixels starting at `row[x]`.
+ * `prev` is the prediction of the first pixel.
+ */
+static inline void write_valid_run(RvlWriter *w, const guint16 *row, guint x, guint count,
+                                   guint16 prev) {
+    guint i = 0;
+#if defined(__SSE2__)
+    if (count >= 8) {
+        const __m128i zeros = _mm_setzero_si128();
+        guint32 zz[8];
+        __m128i last = _mm_set1_epi16((short) prev);
+        for (; i + 8 <= count; i += 8) {
+            __m128i cur = _mm_loadu_si128((const __m128i *) (row + x + i));
+            // Previous pixels: `cur` shifted by one lane, with the last pixel of the previous block
+            __m128i pre = _mm_or_si128(_mm_slli_si128(cur, 2), _mm_srli_si128(last, 14));
+            last = cur;
+
+            __m128i d_lo = _mm_sub_epi32(_mm_unpacklo_epi16(cur, zeros),
+                                         _mm_unpacklo_epi16(pre, zeros));
+            __m128i d_hi = _mm_sub_epi32(_mm_unpackhi_epi16(cur, zeros),
+                                         _mm_unpackhi_epi16(pre, zeros));
+            d_lo = _mm_xor_si128(_mm_slli_epi32(d_lo, 1), _mm_srai_epi32(d_lo, 31));
+            d_hi = _mm_xor_si128(_mm_slli_epi32(d_hi, 1), _mm_srai_epi32(d_hi, 31));
+            _mm_storeu_si128((__m128i *) zz, d_lo);
+            _mm_storeu_si128((__m128i *) (zz + 4), d_hi);
+
+            write_block8(w, zz);
+        }
+        if (i > 0) {
+            prev = row[x + i - 1];
+        }
+    }
+#elif defined(__ARM_NEON)
+    if (count >= 8) {
+        guint32 zz[8];
+        uint16x8_t last = vdupq_n_u16(prev);
+        for (; i + 8 <= count; i += 8) {
+            uint16x8_t cur = vld1q_u16(row + x + i);
+            // Previous pixels: `cur` shifted by one lane, with the last pixel of the previous block
+            uint16x8_t pre = vextq_u16(last, cur, 7);
+            last = cur;
+
+            int32x4_t d_lo = vreinterpretq_s32_u32(vsubl_u16(vget_low_u16(cur), vget_low_u16(pre)));
+            int32x4_t d_hi =
+                vreinterpretq_s32_u32(vsubl_u16(vget_high_u16(cur), vget_high_u16(pre)));
+            d_lo = veorq_s32(vshlq_n_s32(d_lo, 1), vshrq_n_s32(d_lo, 31));
+            d_hi = veorq_s32(vshlq_n_s32(d_hi, 1), vshrq_n_s32(d_hi, 31));
+            vst1q_u32(zz, vreinterpretq_u32_s32(d_lo));
+            vst1q_u32(zz + 4, vreinterpretq_u32_s32(d_hi));
+
+            write_block8(w, zz);
+        }
+        if (i > 0) {
+            prev = row[x + i - 1];
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        gint32 d = (gint32) row[x + i] - (gint32) prev;
+        write_vle(w, ((guint32) d << 1) ^ (guint32) (d >> 31));
+        prev = row[x + i];
+    }
+}
+// <---- Row kernels
+
+gsize gst_zed_depth_rvl_max_size(guint width, guint height) {
+    // Each valid pixel needs at most 6 nibbles; the two run lengths of a run pair cover at least
+    // two pixels, except the first and the last pair of a row.
+    guint64 nibbles = (guint64) height * ((guint64) width * VLE_MAX_VALUE_NIBBLES +
+                                          4 * VLE_MAX_NIBBLES + 8);
+    return GST_ZED_DEPTH_RVL_HEADER_SIZE + 4 * ((nibbles + 7) / 8) + 4;
+}
+
+gsize gst_zed_depth_rvl_encode(const guint8 *src, guint width, guint height, gsize stride,
+                               guint8 *dst, gsize dst_size) {
+    if (dst_size < GST_ZED_DEPTH_RVL_HEADER_SIZE) {
+        return 0;
+    }
+
+    RvlWriter w;
+    w.data = dst + GST_ZED_DEPTH_RVL_HEADER_SIZE;
+    w.end = dst + dst_size;
+    w.word = 0;
+    w.nibbles = 0;
+    w.overflow = FALSE;
+
+    guint16 row_pred = 0;
+    for (guint y = 0; y < height && !w.overflow; y++) {
+        const guint16 *row = (const guint16 *) (src + y * stride);
+        guint16 prev = row_pred;
+        gboolean first_valid = TRUE;
+
+        guint x = 0;
+        while (x < width) {
+            guint zeros = run_length(row, x, width, TRUE);
+            write_vle(&w, zeros);
+            x += zeros;
+
+            guint valid = run_length(row, x, width, FALSE);
+            write_vle(&w, valid);
+            if (valid) {
+                write_valid_run(&w, row, x, valid, prev);
+                if (first_valid) {
+                    row_pred = row[x];
+                    first_valid = FALSE;
+                }
+                x += valid;
+                prev = row[x - 1];
+            }
+        }
+    }
+    flush_writer(&w);
+
+    if (w.overflow) {
+        return 0;
+    }
+
+    // ----> Header
+    guint32 words = (guint32) ((w.data - dst - GST_ZED_DEPTH_RVL_HEADER_SIZE) / 4);
+    guint32 val;
+    memcpy(dst, GST_ZED_DEPTH_RVL_MAGIC, 4);
+    dst[4] = GST_ZED_DEPTH_RVL_VERSION;
+    dst[5] = dst[6] = dst[7] = 0;
+    val = GUINT32_TO_LE(width);
+    memcpy(dst + 8, &val, 4);
+    val = GUINT32_TO_LE(height);
+    memcpy(dst + 12, &val, 4);
+    val = GUINT32_TO_LE(words);
+    memcpy(dst + 16, &val, 4);
+    // <---- Header
+
+    return w.data - dst;
+}
+
+gboolean gst_zed_depth_rvl_parse_header(const guint8 *src, gsize size, guint *width,
+                                        guint *height) {
+    if (size < GST_ZED_DEPTH_RVL_HEADER_SIZE || memcmp(src, GST_ZED_DEPTH_RVL_MAGIC, 4) != 0 ||
+        src[4] != GST_ZED_DEPTH_RVL_VERSION) {
+        return FALSE;
+    }
+
+    guint32 val;
+    memcpy(&val, src + 8, 4);
+    *width = GUINT32_FROM_LE(val);
+    memcpy(&val, src + 12, 4);
+    *height = GUINT32_FROM_LE(val);
+    return TRUE;
+}
+
+gboolean gst_zed_depth_rvl_decode(const guint8 *src, gsize size, guint8 *dst, guint width,
+                                  guint height, gsize stride) {
+    guint w_hdr, h_hdr;
+    if (!gst_zed_depth_rvl_parse_header(src, size, &w_hdr, &h_hdr) || w_hdr != width ||
+        h_hdr != height) {
+        return FALSE;
+    }
+
+    guint32 words;
+    memcpy(&words, src + 16, 4);
+    words = GUINT32_FROM_LE(words);
+    if ((guint64) words * 4 > size - GST_ZED_DEPTH_RVL_HEADER_SIZE) {
+        return FALSE;
+    }
+
+    RvlReader r;
+    r.data = src + GST_ZED_DEPTH_RVL_HEADER_SIZE;
+    r.end = r.data + (gsize) words * 4;
+    r.buf = 0;
+    r.bits = 0;
+    r.error = FALSE;
+
+    guint16 row_pred = 0;
+    for (guint y = 0; y < height; y++) {
+        guint16 *row = (guint16 *) (dst + y * stride);
+        guint16 prev = row_pred;
+        gboolean first_valid = TRUE;
+
+        guint x = 0;
+        while (x < width) {
+            guint32 zeros = read_vle(&r);
+            if (r.error || zeros > width - x) {
+                return FALSE;
+            }
+            memset(row + x, 0, zeros * sizeof(guint16));
+            x += zeros;
+
+            guint32 valid = read_vle(&r);
+            if (r.error || valid > width - x) {
+                return FALSE;
+            }
+            guint32 i = 0;
+            guint32 packed;
+            while (i + 8 <= valid && read_packed8(&r, &packed)) {
+                for (int k = 0; k < 8; k++, i++) {
+                    guint32 zz = (packed >> 28) & 0x7;
+                    packed <<= 4;
+                    prev = (guint16) (prev + ((gint32) (zz >> 1) ^ -(gint32) (zz & 1)));
+                    row[x + i] = prev;
+                }
+            }
+            for (; i < valid; i++) {
+                guint32 zz = read_vle(&r);
+                prev = (guint16) (prev + ((gint32) (zz >> 1) ^ -(gint32) (zz & 1)));
+                row[x + i] = prev;
+            }
+            if (r.error) {
+                return FALSE;
+            }
+            if (valid && first_valid) {
+                row_pred = row[x];
+                first_valid = FALSE;
+            }
+            x += valid;
+
+            // A row made only of valid pixels still codes an empty zero run first: a pair
+            // without progress means a corrupted stream
+            if (zeros == 0 && valid == 0) {
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
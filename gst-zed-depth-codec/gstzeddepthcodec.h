@@ -0,0 +1,77 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef GST_ZED_DEPTH_CODEC_H
+#define GST_ZED_DEPTH_CODEC_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Lossless RVL-style depth codec (all values little endian)
+ *
+ * Frame header:
+ *   char[4]  magic "ZRVL"
+ *   guint8   version
+ *   guint8   reserved[3] (0)
+ *   guint32  width
+ *   guint32  height
+ *   guint32  payload size in 32 bits words (W)
+ *
+ * Payload: W x guint32 words, each holding 8 nibbles, most significant nibble first.
+ *
+ * Every row is coded as a sequence of [zero run length, valid run length, valid values...]
+ * until the row is complete. Invalid pixels (0) are not coded. A valid value is coded as the
+ * zigzag mapped difference with the previous valid pixel of the row; the first valid pixel of
+ * a row is predicted from the first valid pixel of the previous row.
+ * Numbers are written with a variable length code of 3 bits per nibble, the highest bit of the
+ * nibble being set when more nibbles follow.
+ */
+
+#define GST_ZED_DEPTH_RVL_MAGIC "ZRVL"
+#define GST_ZED_DEPTH_RVL_VERSION 0
+#define GST_ZED_DEPTH_RVL_HEADER_SIZE 20
+
+#define GST_ZED_DEPTH_CODEC_CAPS_NAME "video/x-zed-depth"
+#define GST_ZED_DEPTH_CODEC_RVL "rvl"
+
+/* Maximum size of an encoded `width` x `height` frame, header included */
+gsize gst_zed_depth_rvl_max_size(guint width, guint height);
+
+/* Encode a GRAY16 depth frame. `stride` is the distance in bytes between two rows.
+ * Returns the size of the encoded frame, or 0 if `dst_size` is too small.
+ */
+gsize gst_zed_depth_rvl_encode(const guint8 *src, guint width, guint height, gsize stride,
+                               guint8 *dst, gsize dst_size);
+
+/* Read the size of an encoded frame. Returns FALSE if the header is not valid. */
+gboolean gst_zed_depth_rvl_parse_header(const guint8 *src, gsize size, guint *width,
+                                        guint *height);
+
+/* Decode a frame into a `width` x `height` GRAY16 image with rows of `stride` bytes.
+ * Returns FALSE if the frame is truncated, malformed or does not match the image size.
+ */
+gboolean gst_zed_depth_rvl_decode(const guint8 *src, gsize size, guint8 *dst, guint width,
+                                  guint height, gsize stride);
+
+G_END_DECLS
+
+#endif   // GST_ZED_DEPTH_CODEC_H
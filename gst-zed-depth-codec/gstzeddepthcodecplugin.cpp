@@ -0,0 +1,45 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include <gst/gst.h>
+
+#include "gstzeddepthdec.h"
+#include "gstzeddepthenc.h"
+#include "gstzeddepthpack.h"
+#include "gstzeddepthunpack.h"
+
+static gboolean plugin_init(GstPlugin *plugin) {
+    if (!gst_element_register(plugin, "zeddepthenc", GST_RANK_NONE, GST_TYPE_ZED_DEPTH_ENC)) {
+        return FALSE;
+    }
+    if (!gst_element_register(plugin, "zeddepthdec", GST_RANK_NONE, GST_TYPE_ZED_DEPTH_DEC)) {
+        return FALSE;
+    }
+    if (!gst_element_register(plugin, "zeddepthpack", GST_RANK_NONE, GST_TYPE_ZED_DEPTH_PACK)) {
+        return FALSE;
+    }
+    return gst_element_register(plugin, "zeddepthunpack", GST_RANK_NONE,
+                                GST_TYPE_ZED_DEPTH_UNPACK);
+}
+
+GST_PLUGIN_DEFINE(GST_VERSION_MAJOR, GST_VERSION_MINOR, zeddepthcodec,
+                  "ZED depth codecs", plugin_init, GST_PACKAGE_VERSION,
+                  GST_PACKAGE_LICENSE, GST_PACKAGE_NAME, GST_PACKAGE_ORIGIN)
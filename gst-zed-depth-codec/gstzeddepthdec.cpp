@@ -0,0 +1,190 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzeddepthdec.h"
+
+#include "gst-zed-meta/gstzedmeta.h"
+#include "gst-zed-meta/gstzedtimingmeta.h"
+#include "gstzeddepthcodec.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_zed_depth_dec_debug);
+#define GST_CAT_DEFAULT gst_zed_depth_dec_debug
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE(
+    "sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS(GST_ZED_DEPTH_CODEC_CAPS_NAME ", "
+                    "codec = (string)" GST_ZED_DEPTH_CODEC_RVL ", "
+                    "width = (int)[ 1, 8192 ], "
+                    "height = (int)[ 1, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE(
+    "src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string)GRAY16_LE, "
+                    "width = (int)[ 1, 8192 ], "
+                    "height = (int)[ 1, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+#define gst_zed_depth_dec_parent_class parent_class
+G_DEFINE_TYPE(GstZedDepthDec, gst_zed_depth_dec, GST_TYPE_BASE_TRANSFORM);
+
+static GstCaps *gst_zed_depth_dec_transform_caps(GstBaseTransform *base, GstPadDirection direction,
+                                                 GstCaps *caps, GstCaps *filter);
+static gboolean gst_zed_depth_dec_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                           GstCaps *outcaps);
+static gboolean gst_zed_depth_dec_transform_size(GstBaseTransform *base, GstPadDirection direction,
+                                                 GstCaps *caps, gsize size, GstCaps *othercaps,
+                                                 gsize *othersize);
+static gboolean gst_zed_depth_dec_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                 GstMeta *meta, GstBuffer *inbuf);
+static GstFlowReturn gst_zed_depth_dec_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                 GstBuffer *outbuf);
+
+static void gst_zed_depth_dec_class_init(GstZedDepthDecClass *klass) {
+    GstElementClass *gstelement_class = GST_ELEMENT_CLASS(klass);
+    GstBaseTransformClass *trans_class = GST_BASE_TRANSFORM_CLASS(klass);
+
+    gst_element_class_set_static_metadata(
+        gstelement_class, "ZED Depth Decoder", "Codec/Decoder/Video",
+        "Decodes the 16 bits depth maps compressed by zeddepthenc",
+        "Stereolabs <support@stereolabs.com>");
+
+    gst_element_class_add_static_pad_template(gstelement_class, &sink_template);
+    gst_element_class_add_static_pad_template(gstelement_class, &src_template);
+
+    trans_class->transform_caps = GST_DEBUG_FUNCPTR(gst_zed_depth_dec_transform_caps);
+    trans_class->set_caps = GST_DEBUG_FUNCPTR(gst_zed_depth_dec_set_caps);
+    trans_class->transform_size = GST_DEBUG_FUNCPTR(gst_zed_depth_dec_transform_size);
+    trans_class->transform_meta = GST_DEBUG_FUNCPTR(gst_zed_depth_dec_transform_meta);
+    trans_class->transform = GST_DEBUG_FUNCPTR(gst_zed_depth_dec_transform);
+    trans_class->passthrough_on_same_caps = FALSE;
+
+    GST_DEBUG_CATEGORY_INIT(gst_zed_depth_dec_debug, "zeddepthdec", 0, "ZED Depth Decoder");
+}
+
+static void gst_zed_depth_dec_init(GstZedDepthDec *dec) { gst_video_info_init(&dec->vinfo); }
+
+static GstCaps *gst_zed_depth_dec_transform_caps(GstBaseTransform *base, GstPadDirection direction,
+                                                 GstCaps *caps, GstCaps *filter) {
+    GstCaps *res = gst_caps_new_empty();
+
+    for (guint i = 0; i < gst_caps_get_size(caps); i++) {
+        GstStructure *s = gst_structure_copy(gst_caps_get_structure(caps, i));
+
+        if (direction == GST_PAD_SINK) {
+            gst_structure_set_name(s, "video/x-raw");
+            gst_structure_remove_field(s, "codec");
+            gst_structure_set(s, "format", G_TYPE_STRING, "GRAY16_LE", NULL);
+        } else {
+            gst_structure_set_name(s, GST_ZED_DEPTH_CODEC_CAPS_NAME);
+            gst_structure_remove_fields(s, "format", "colorimetry", "chroma-site", NULL);
+            gst_structure_set(s, "codec", G_TYPE_STRING, GST_ZED_DEPTH_CODEC_RVL, NULL);
+        }
+        gst_caps_append_structure(res, s);
+    }
+
+    if (filter) {
+        GstCaps *tmp = gst_caps_intersect_full(filter, res, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref(res);
+        res = tmp;
+    }
+
+    GST_DEBUG_OBJECT(base, "Transformed %" GST_PTR_FORMAT " into %" GST_PTR_FORMAT, caps, res);
+    return res;
+}
+
+static gboolean gst_zed_depth_dec_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                           GstCaps *outcaps) {
+    GstZedDepthDec *dec = GST_ZED_DEPTH_DEC(base);
+
+    if (!gst_video_info_from_caps(&dec->vinfo, outcaps)) {
+        GST_ERROR_OBJECT(dec, "Invalid output caps %" GST_PTR_FORMAT, outcaps);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean gst_zed_depth_dec_transform_size(GstBaseTransform *base, GstPadDirection direction,
+                                                 GstCaps *caps, gsize size, GstCaps *othercaps,
+                                                 gsize *othersize) {
+    if (direction == GST_PAD_SINK) {
+        GstVideoInfo vinfo;
+        if (!gst_video_info_from_caps(&vinfo, othercaps)) {
+            return FALSE;
+        }
+        *othersize = GST_VIDEO_INFO_SIZE(&vinfo);
+    } else {
+        gint width, height;
+        GstStructure *s = gst_caps_get_structure(othercaps, 0);
+        if (!gst_structure_get_int(s, "width", &width) ||
+            !gst_structure_get_int(s, "height", &height)) {
+            return FALSE;
+        }
+        *othersize = gst_zed_depth_rvl_max_size(width, height);
+    }
+    return TRUE;
+}
+
+static gboolean gst_zed_depth_dec_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                 GstMeta *meta, GstBuffer *inbuf) {
+    GType api = meta->info->api;
+    if (api == GST_ZED_SRC_META_API_TYPE || api == GST_ZED_TIMING_META_API_TYPE) {
+        return TRUE;
+    }
+    return GST_BASE_TRANSFORM_CLASS(parent_class)->transform_meta(base, outbuf, meta, inbuf);
+}
+
+static GstFlowReturn gst_zed_depth_dec_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                 GstBuffer *outbuf) {
+    GstZedDepthDec *dec = GST_ZED_DEPTH_DEC(base);
+    GstMapInfo map_in;
+    GstVideoFrame frame;
+
+    if (!gst_buffer_map(inbuf, &map_in, GST_MAP_READ)) {
+        GST_ELEMENT_ERROR(dec, RESOURCE, FAILED, ("Failed to map input buffer for reading"),
+                          (NULL));
+        return GST_FLOW_ERROR;
+    }
+    if (!gst_video_frame_map(&frame, &dec->vinfo, outbuf, GST_MAP_WRITE)) {
+        gst_buffer_unmap(inbuf, &map_in);
+        GST_ELEMENT_ERROR(dec, RESOURCE, FAILED, ("Failed to map output buffer for writing"),
+                          (NULL));
+        return GST_FLOW_ERROR;
+    }
+
+    gboolean ok = gst_zed_depth_rvl_decode(
+        map_in.data, map_in.size, (guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&frame, 0),
+        GST_VIDEO_FRAME_WIDTH(&frame), GST_VIDEO_FRAME_HEIGHT(&frame),
+        GST_VIDEO_FRAME_PLANE_STRIDE(&frame, 0));
+
+    gst_video_frame_unmap(&frame);
+    gst_buffer_unmap(inbuf, &map_in);
+
+    if (!ok) {
+        // A corrupted frame does not stop the stream, the next frames are independent
+        GST_ELEMENT_WARNING(dec, STREAM, DECODE, ("Corrupted depth frame dropped"),
+                            ("Frame of %" G_GSIZE_FORMAT " B", gst_buffer_get_size(inbuf)));
+        return GST_BASE_TRANSFORM_FLOW_DROPPED;
+    }
+
+    return GST_FLOW_OK;
+}
@@ -0,0 +1,345 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzeddepthpack.h"
+
+#include "gst-zed-meta/gstzedmeta.h"
+#include "gst-zed-meta/gstzedtimingmeta.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_zed_depth_pack_debug);
+#define GST_CAT_DEFAULT gst_zed_depth_pack_debug
+
+enum {
+    PROP_0,
+    PROP_PACKING,
+    PROP_DEPTH_MIN,
+    PROP_DEPTH_MAX,
+    PROP_MAX_ERROR,
+};
+
+#define DEFAULT_PROP_PACKING GST_ZED_DEPTH_PACKING_HUE
+#define DEFAULT_PROP_DEPTH_MIN 300.f
+#define DEFAULT_PROP_DEPTH_MAX 20000.f
+
+#define GST_TYPE_ZED_DEPTH_PACKING (gst_zed_depth_packing_get_type())
+static GType gst_zed_depth_packing_get_type(void) {
+    static GType zed_depth_packing_type = 0;
+
+    if (!zed_depth_packing_type) {
+        static GEnumValue pattern_types[] = {
+            {GST_ZED_DEPTH_PACKING_HUE, "RGB frames, depth mapped on a hue ramp", "HUE"},
+            {GST_ZED_DEPTH_PACKING_DUAL_PLANE,
+             "NV12 frames, coarse depth in the Y plane and fine depth in the UV plane",
+             "DUAL_PLANE"},
+            {0, NULL, NULL},
+        };
+
+        zed_depth_packing_type = g_enum_register_static("GstZedDepthPacking", pattern_types);
+    }
+
+    return zed_depth_packing_type;
+}
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE(
+    "sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string)GRAY16_LE, "
+                    "width = (int)[ 1, 8192 ], "
+                    "height = (int)[ 1, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE(
+    "src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string){ RGB, NV12 }, "
+                    "width = (int)[ 1, 8192 ], "
+                    "height = (int)[ 1, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+#define gst_zed_depth_pack_parent_class parent_class
+G_DEFINE_TYPE(GstZedDepthPack, gst_zed_depth_pack, GST_TYPE_BASE_TRANSFORM);
+
+static void gst_zed_depth_pack_set_property(GObject *object, guint prop_id, const GValue *value,
+                                            GParamSpec *pspec);
+static void gst_zed_depth_pack_get_property(GObject *object, guint prop_id, GValue *value,
+                                            GParamSpec *pspec);
+
+static GstCaps *gst_zed_depth_pack_transform_caps(GstBaseTransform *base,
+                                                  GstPadDirection direction, GstCaps *caps,
+                                                  GstCaps *filter);
+static gboolean gst_zed_depth_pack_get_unit_size(GstBaseTransform *base, GstCaps *caps,
+                                                 gsize *size);
+static gboolean gst_zed_depth_pack_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                            GstCaps *outcaps);
+static gboolean gst_zed_depth_pack_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                  GstMeta *meta, GstBuffer *inbuf);
+static GstFlowReturn gst_zed_depth_pack_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                  GstBuffer *outbuf);
+static gboolean gst_zed_depth_pack_stop(GstBaseTransform *base);
+
+static void gst_zed_depth_pack_class_init(GstZedDepthPackClass *klass) {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass *gstelement_class = GST_ELEMENT_CLASS(klass);
+    GstBaseTransformClass *trans_class = GST_BASE_TRANSFORM_CLASS(klass);
+
+    gobject_class->set_property = gst_zed_depth_pack_set_property;
+    gobject_class->get_property = gst_zed_depth_pack_get_property;
+
+    g_object_class_install_property(
+        gobject_class, PROP_PACKING,
+        g_param_spec_enum("packing", "Packing", "How the depth is packed into the video frames",
+                          GST_TYPE_ZED_DEPTH_PACKING, DEFAULT_PROP_PACKING,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_DEPTH_MIN,
+        g_param_spec_float("depth-minimum-distance", "Minimum depth value",
+                           "Depth packed on the first level, lower values are clamped", 0.f,
+                           65534.f, DEFAULT_PROP_DEPTH_MIN,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_DEPTH_MAX,
+        g_param_spec_float("depth-maximum-distance", "Maximum depth value",
+                           "Depth packed on the last level, higher values are clamped", 1.f,
+                           65535.f, DEFAULT_PROP_DEPTH_MAX,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_MAX_ERROR,
+        g_param_spec_float("max-error", "Maximum error",
+                           "Quantization error bound of the packing, in depth units, without "
+                           "the errors of the video codec",
+                           0.f, G_MAXFLOAT, 0.f,
+                           (GParamFlags) (G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+
+    gst_element_class_set_static_metadata(
+        gstelement_class, "ZED Depth Packer", "Filter/Converter/Video",
+        "Packs 16 bits depth maps into 8 bits video frames robust to lossy video encoders",
+        "Stereolabs <support@stereolabs.com>");
+
+    gst_element_class_add_static_pad_template(gstelement_class, &sink_template);
+    gst_element_class_add_static_pad_template(gstelement_class, &src_template);
+
+    trans_class->transform_caps = GST_DEBUG_FUNCPTR(gst_zed_depth_pack_transform_caps);
+    trans_class->get_unit_size = GST_DEBUG_FUNCPTR(gst_zed_depth_pack_get_unit_size);
+    trans_class->set_caps = GST_DEBUG_FUNCPTR(gst_zed_depth_pack_set_caps);
+    trans_class->transform_meta = GST_DEBUG_FUNCPTR(gst_zed_depth_pack_transform_meta);
+    trans_class->transform = GST_DEBUG_FUNCPTR(gst_zed_depth_pack_transform);
+    trans_class->stop = GST_DEBUG_FUNCPTR(gst_zed_depth_pack_stop);
+    trans_class->passthrough_on_same_caps = FALSE;
+
+    GST_DEBUG_CATEGORY_INIT(gst_zed_depth_pack_debug, "zeddepthpack", 0, "ZED Depth Packer");
+}
+
+static void gst_zed_depth_pack_init(GstZedDepthPack *pack) {
+    gst_video_info_init(&pack->in_info);
+    gst_video_info_init(&pack->out_info);
+    pack->tables.pack_lut = NULL;
+    pack->tables.unpack_lut = NULL;
+
+    pack->packing = DEFAULT_PROP_PACKING;
+    pack->depth_min = DEFAULT_PROP_DEPTH_MIN;
+    pack->depth_max = DEFAULT_PROP_DEPTH_MAX;
+}
+
+static void gst_zed_depth_pack_set_property(GObject *object, guint prop_id, const GValue *value,
+                                            GParamSpec *pspec) {
+    GstZedDepthPack *pack = GST_ZED_DEPTH_PACK(object);
+
+    GST_OBJECT_LOCK(pack);
+    switch (prop_id) {
+    case PROP_PACKING:
+        pack->packing = (GstZedDepthPacking) g_value_get_enum(value);
+        break;
+    case PROP_DEPTH_MIN:
+        pack->depth_min = g_value_get_float(value);
+        break;
+    case PROP_DEPTH_MAX:
+        pack->depth_max = g_value_get_float(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(pack);
+}
+
+static void gst_zed_depth_pack_get_property(GObject *object, guint prop_id, GValue *value,
+                                            GParamSpec *pspec) {
+    GstZedDepthPack *pack = GST_ZED_DEPTH_PACK(object);
+
+    GST_OBJECT_LOCK(pack);
+    switch (prop_id) {
+    case PROP_PACKING:
+        g_value_set_enum(value, pack->packing);
+        break;
+    case PROP_DEPTH_MIN:
+        g_value_set_float(value, pack->depth_min);
+        break;
+    case PROP_DEPTH_MAX:
+        g_value_set_float(value, pack->depth_max);
+        break;
+    case PROP_MAX_ERROR:
+        g_value_set_float(value, gst_zed_depth_packing_max_error(pack->packing,
+                                                                 (guint) pack->depth_min,
+                                                                 (guint) pack->depth_max));
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(pack);
+}
+
+static GstCaps *gst_zed_depth_pack_transform_caps(GstBaseTransform *base,
+                                                  GstPadDirection direction, GstCaps *caps,
+                                                  GstCaps *filter) {
+    GstZedDepthPack *pack = GST_ZED_DEPTH_PACK(base);
+    GstCaps *res = gst_caps_new_empty();
+
+    GST_OBJECT_LOCK(pack);
+    const gchar *packed_format = pack->packing == GST_ZED_DEPTH_PACKING_HUE ? "RGB" : "NV12";
+    GST_OBJECT_UNLOCK(pack);
+
+    for (guint i = 0; i < gst_caps_get_size(caps); i++) {
+        GstStructure *s = gst_structure_copy(gst_caps_get_structure(caps, i));
+
+        gst_structure_remove_fields(s, "colorimetry", "chroma-site", NULL);
+        gst_structure_set(s, "format", G_TYPE_STRING,
+                          direction == GST_PAD_SINK ? packed_format : "GRAY16_LE", NULL);
+        gst_caps_append_structure(res, s);
+    }
+
+    if (filter) {
+        GstCaps *tmp = gst_caps_intersect_full(filter, res, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref(res);
+        res = tmp;
+    }
+
+    GST_DEBUG_OBJECT(base, "Transformed %" GST_PTR_FORMAT " into %" GST_PTR_FORMAT, caps, res);
+    return res;
+}
+
+static gboolean gst_zed_depth_pack_get_unit_size(GstBaseTransform *base, GstCaps *caps,
+                                                 gsize *size) {
+    GstVideoInfo vinfo;
+
+    if (!gst_video_info_from_caps(&vinfo, caps)) {
+        return FALSE;
+    }
+    *size = GST_VIDEO_INFO_SIZE(&vinfo);
+    return TRUE;
+}
+
+static gboolean gst_zed_depth_pack_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                            GstCaps *outcaps) {
+    GstZedDepthPack *pack = GST_ZED_DEPTH_PACK(base);
+
+    if (!gst_video_info_from_caps(&pack->in_info, incaps) ||
+        !gst_video_info_from_caps(&pack->out_info, outcaps)) {
+        GST_ERROR_OBJECT(pack, "Invalid caps %" GST_PTR_FORMAT " -> %" GST_PTR_FORMAT, incaps,
+                         outcaps);
+        return FALSE;
+    }
+
+    GST_OBJECT_LOCK(pack);
+    guint depth_min = (guint) pack->depth_min;
+    guint depth_max = (guint) pack->depth_max;
+    GST_OBJECT_UNLOCK(pack);
+
+    if (depth_min >= depth_max) {
+        GST_ELEMENT_ERROR(pack, LIBRARY, SETTINGS,
+                          ("The minimum depth must be lower than the maximum depth"),
+                          ("Depth range [%u, %u]", depth_min, depth_max));
+        return FALSE;
+    }
+
+    // The packing follows the negotiated format
+    GstZedDepthPacking packing = GST_VIDEO_INFO_FORMAT(&pack->out_info) == GST_VIDEO_FORMAT_RGB
+                                     ? GST_ZED_DEPTH_PACKING_HUE
+                                     : GST_ZED_DEPTH_PACKING_DUAL_PLANE;
+
+    gst_zed_depth_pack_tables_clear(&pack->tables);
+    gst_zed_depth_pack_tables_init(&pack->tables, packing, depth_min, depth_max, FALSE);
+
+    GST_INFO_OBJECT(pack, "Packing depth [%u, %u] into %s frames, maximum error %.2f", depth_min,
+                    depth_max, gst_video_format_to_string(GST_VIDEO_INFO_FORMAT(&pack->out_info)),
+                    gst_zed_depth_packing_max_error(packing, depth_min, depth_max));
+    return TRUE;
+}
+
+static gboolean gst_zed_depth_pack_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                  GstMeta *meta, GstBuffer *inbuf) {
+    // The frames are the same, only their encoding changes: keep the ZED metadata
+    GType api = meta->info->api;
+    if (api == GST_ZED_SRC_META_API_TYPE || api == GST_ZED_TIMING_META_API_TYPE) {
+        return TRUE;
+    }
+    return GST_BASE_TRANSFORM_CLASS(parent_class)->transform_meta(base, outbuf, meta, inbuf);
+}
+
+static GstFlowReturn gst_zed_depth_pack_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                  GstBuffer *outbuf) {
+    GstZedDepthPack *pack = GST_ZED_DEPTH_PACK(base);
+    GstVideoFrame in_frame, out_frame;
+
+    if (!gst_video_frame_map(&in_frame, &pack->in_info, inbuf, GST_MAP_READ)) {
+        GST_ELEMENT_ERROR(pack, RESOURCE, FAILED, ("Failed to map input buffer for reading"),
+                          (NULL));
+        return GST_FLOW_ERROR;
+    }
+    if (!gst_video_frame_map(&out_frame, &pack->out_info, outbuf, GST_MAP_WRITE)) {
+        gst_video_frame_unmap(&in_frame);
+        GST_ELEMENT_ERROR(pack, RESOURCE, FAILED, ("Failed to map output buffer for writing"),
+                          (NULL));
+        return GST_FLOW_ERROR;
+    }
+
+    const guint8 *src = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&in_frame, 0);
+    gsize src_stride = GST_VIDEO_FRAME_PLANE_STRIDE(&in_frame, 0);
+    guint width = GST_VIDEO_FRAME_WIDTH(&in_frame);
+    guint height = GST_VIDEO_FRAME_HEIGHT(&in_frame);
+
+    if (pack->tables.packing == GST_ZED_DEPTH_PACKING_HUE) {
+        gst_zed_depth_pack_hue(&pack->tables, src, src_stride,
+                               (guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&out_frame, 0),
+                               GST_VIDEO_FRAME_PLANE_STRIDE(&out_frame, 0), width, height);
+    } else {
+        gst_zed_depth_pack_dual_plane(&pack->tables, src, src_stride,
+                                      (guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&out_frame, 0),
+                                      GST_VIDEO_FRAME_PLANE_STRIDE(&out_frame, 0),
+                                      (guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&out_frame, 1),
+                                      GST_VIDEO_FRAME_PLANE_STRIDE(&out_frame, 1), width, height);
+    }
+
+    gst_video_frame_unmap(&out_frame);
+    gst_video_frame_unmap(&in_frame);
+
+    return GST_FLOW_OK;
+}
+
+static gboolean gst_zed_depth_pack_stop(GstBaseTransform *base) {
+    GstZedDepthPack *pack = GST_ZED_DEPTH_PACK(base);
+
+    gst_zed_depth_pack_tables_clear(&pack->tables);
+    return TRUE;
+}
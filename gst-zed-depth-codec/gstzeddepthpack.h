@@ -0,0 +1,51 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef __GST_ZED_DEPTH_PACK_H__
+#define __GST_ZED_DEPTH_PACK_H__
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#include "gstzeddepthpacking.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_ZED_DEPTH_PACK (gst_zed_depth_pack_get_type())
+G_DECLARE_FINAL_TYPE(GstZedDepthPack, gst_zed_depth_pack, GST, ZED_DEPTH_PACK, GstBaseTransform)
+
+struct _GstZedDepthPack {
+    GstBaseTransform element;
+
+    GstVideoInfo in_info;
+    GstVideoInfo out_info;
+    GstZedDepthPackTables tables;   // built when the caps are set
+
+    // Properties
+    GstZedDepthPacking packing;
+    gfloat depth_min;
+    gfloat depth_max;
+};
+
+G_END_DECLS
+
+#endif /* __GST_ZED_DEPTH_PACK_H__ */
@@ -0,0 +1,314 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzeddepthpacking.h"
+
+#include <math.h>
+#include <string.h>
+
+// Period of the DUAL_PLANE triangle waves, in coarse levels
+#define TRIANGLE_PERIOD 16.0
+// Maximum distance between the decoded depth and the coarse depth, in coarse levels
+#define COARSE_TOLERANCE 2.0
+// Offset of the valid coarse levels in the Y plane, lower values are invalid pixels
+#define LUMA_OFFSET 16
+#define LUMA_INVALID_THRESHOLD 8
+// RGB pixels whose brightest channel is below this threshold are invalid pixels
+#define HUE_INVALID_THRESHOLD 128
+
+// ----> Lookup tables
+static inline gdouble normalize(guint depth, guint depth_min, guint depth_max) {
+    depth = CLAMP(depth, depth_min, depth_max);
+    return (gdouble) (depth - depth_min) / (depth_max - depth_min);
+}
+
+static inline guint16 denormalize(gdouble value, guint depth_min, guint depth_max) {
+    guint depth = (guint) (depth_min + value * (depth_max - depth_min) + 0.5);
+    return (guint16) CLAMP(depth, 1, 65535);   // 0 is reserved to invalid pixels
+}
+
+// Triangle wave of period 2 going from 0 to 1 and back
+static inline gdouble triangle(gdouble t) {
+    t = fmod(t, 2.0);
+    if (t < 0) {
+        t += 2.0;
+    }
+    return t > 1.0 ? 2.0 - t : t;
+}
+
+static inline guint8 to_byte(gdouble value) { return (guint8) CLAMP(value * 255.0 + 0.5, 0, 255); }
+
+static void hue_color(guint level, guint8 *rgb) {
+    guint r, g, b;
+
+    if (level <= 255) {   // red to yellow
+        r = 255, g = level, b = 0;
+    } else if (level <= 510) {   // yellow to green
+        r = 510 - level, g = 255, b = 0;
+    } else if (level <= 765) {   // green to cyan
+        r = 0, g = 255, b = level - 510;
+    } else if (level <= 1020) {   // cyan to blue
+        r = 0, g = 1020 - level, b = 255;
+    } else {   // blue to magenta
+        r = level - 1020, g = 0, b = 255;
+    }
+    rgb[0] = r;
+    rgb[1] = g;
+    rgb[2] = b;
+}
+
+static void init_pack_hue(GstZedDepthPackTables *tables) {
+    memset(tables->pack_lut, 0, 3);   // invalid pixels are black
+    for (guint depth = 1; depth < 65536; depth++) {
+        gdouble x = normalize(depth, tables->depth_min, tables->depth_max);
+        guint level = (guint) (x * (GST_ZED_DEPTH_HUE_LEVELS - 1) + 0.5);
+        hue_color(level, tables->pack_lut + depth * 3);
+    }
+}
+
+static void init_unpack_hue(GstZedDepthPackTables *tables) {
+    for (guint level = 0; level < GST_ZED_DEPTH_HUE_LEVELS; level++) {
+        tables->unpack_lut[level] = denormalize((gdouble) level / (GST_ZED_DEPTH_HUE_LEVELS - 1),
+                                                tables->depth_min, tables->depth_max);
+    }
+}
+
+static void init_pack_dual_plane(GstZedDepthPackTables *tables) {
+    guint8 *lut = tables->pack_lut;
+
+    lut[0] = 0;   // invalid pixels, their chroma is never read
+    lut[1] = lut[2] = 128;
+    for (guint depth = 1; depth < 65536; depth++) {
+        gdouble c = normalize(depth, tables->depth_min, tables->depth_max) *
+                    (GST_ZED_DEPTH_COARSE_LEVELS - 1);
+        lut[depth * 3] = LUMA_OFFSET + (guint8) (c + 0.5);
+        lut[depth * 3 + 1] = to_byte(triangle(c / (TRIANGLE_PERIOD / 2)));
+        lut[depth * 3 + 2] = to_byte(triangle((c - TRIANGLE_PERIOD / 4) / (TRIANGLE_PERIOD / 2)));
+    }
+}
+
+static void init_unpack_dual_plane(GstZedDepthPackTables *tables) {
+    const gdouble p = TRIANGLE_PERIOD;
+
+    for (guint y = 0; y < 256; y++) {
+        guint16 *lut = tables->unpack_lut + (y << 8);
+
+        if (y < LUMA_INVALID_THRESHOLD) {
+            tables->chroma_sel[y] = 0;
+            memset(lut, 0, 256 * sizeof(guint16));
+            continue;
+        }
+
+        // The coarse level selects the wave in its linear part (U for m = 0 and 2, V for m = 1
+        // and 3, decreasing for m >= 2) and the start of the half period it covers
+        gdouble coarse = y > LUMA_OFFSET ? y - LUMA_OFFSET : 0;
+        gint m = ((gint) floor(4.0 * coarse / p - 0.5)) & 3;
+        gdouble phase = fmod(coarse - p / 8, p);
+        if (phase < 0) {
+            phase += p;
+        }
+        gdouble start = coarse - phase + p / 4 * m - p / 8;
+        tables->chroma_sel[y] = m & 1;
+
+        for (guint f = 0; f < 256; f++) {
+            gdouble wave = f / 255.0;
+            gdouble c = start + (m < 2 ? wave : 1.0 - wave) * p / 2;
+            // A chroma sample of another surface of the block does not move the depth away
+            // from the coarse value
+            c = CLAMP(c, coarse - COARSE_TOLERANCE, coarse + COARSE_TOLERANCE);
+            c = CLAMP(c, 0, GST_ZED_DEPTH_COARSE_LEVELS - 1);
+            lut[f] = denormalize(c / (GST_ZED_DEPTH_COARSE_LEVELS - 1), tables->depth_min,
+                                 tables->depth_max);
+        }
+    }
+}
+
+void gst_zed_depth_pack_tables_init(GstZedDepthPackTables *tables, GstZedDepthPacking packing,
+                                    guint depth_min, guint depth_max, gboolean unpack) {
+    g_return_if_fail(depth_min < depth_max && depth_max <= 65535);
+
+    tables->packing = packing;
+    tables->depth_min = depth_min;
+    tables->depth_max = depth_max;
+    tables->pack_lut = NULL;
+    tables->unpack_lut = NULL;
+    memset(tables->chroma_sel, 0, sizeof(tables->chroma_sel));
+
+    if (!unpack) {
+        tables->pack_lut = (guint8 *) g_malloc(65536 * 3);
+        if (packing == GST_ZED_DEPTH_PACKING_HUE) {
+            init_pack_hue(tables);
+        } else {
+            init_pack_dual_plane(tables);
+        }
+    } else if (packing == GST_ZED_DEPTH_PACKING_HUE) {
+        tables->unpack_lut = (guint16 *) g_malloc(GST_ZED_DEPTH_HUE_LEVELS * sizeof(guint16));
+        init_unpack_hue(tables);
+    } else {
+        tables->unpack_lut = (guint16 *) g_malloc(65536 * sizeof(guint16));
+        init_unpack_dual_plane(tables);
+    }
+}
+
+void gst_zed_depth_pack_tables_clear(GstZedDepthPackTables *tables) {
+    g_free(tables->pack_lut);
+    tables->pack_lut = NULL;
+    g_free(tables->unpack_lut);
+    tables->unpack_lut = NULL;
+}
+
+gdouble gst_zed_depth_packing_max_error(GstZedDepthPacking packing, guint depth_min,
+                                        guint depth_max) {
+    gdouble range = depth_max > depth_min ? depth_max - depth_min : 0;
+
+    gdouble step;
+
+    if (packing == GST_ZED_DEPTH_PACKING_HUE) {
+        step = range / (GST_ZED_DEPTH_HUE_LEVELS - 1);
+    } else {
+        // A chroma step is 1/255 of half a period of the triangle waves
+        step = range / (GST_ZED_DEPTH_COARSE_LEVELS - 1) * (TRIANGLE_PERIOD / 2) / 255;
+    }
+    // Half a step, plus the rounding of the unpacked depth
+    return step / 2 + 0.5;
+}
+// <---- Lookup tables
+
+// ----> Packing
+void gst_zed_depth_pack_hue(const GstZedDepthPackTables *tables, const guint8 *src,
+                            gsize src_stride, guint8 *dst, gsize dst_stride, guint width,
+                            guint height) {
+    const guint8 *lut = tables->pack_lut;
+
+    for (guint y = 0; y < height; y++) {
+        const guint16 *in = (const guint16 *) (src + y * src_stride);
+        guint8 *out = dst + y * dst_stride;
+
+        for (guint x = 0; x < width; x++, out += 3) {
+            const guint8 *rgb = lut + in[x] * 3;
+            out[0] = rgb[0];
+            out[1] = rgb[1];
+            out[2] = rgb[2];
+        }
+    }
+}
+
+static inline void pack_luma(const guint8 *lut, guint16 depth, guint8 *y, guint32 *sum,
+                             guint *count) {
+    *y = lut[depth * 3];
+    if (depth) {
+        *sum += depth;
+        (*count)++;
+    }
+}
+
+void gst_zed_depth_pack_dual_plane(const GstZedDepthPackTables *tables, const guint8 *src,
+                                   gsize src_stride, guint8 *y, gsize y_stride, guint8 *uv,
+                                   gsize uv_stride, guint width, guint height) {
+    const guint8 *lut = tables->pack_lut;
+
+    for (guint j = 0; j < height; j += 2) {
+        const guint16 *in0 = (const guint16 *) (src + j * src_stride);
+        const guint16 *in1 = j + 1 < height ? (const guint16 *) (src + (j + 1) * src_stride) : NULL;
+        guint8 *y0 = y + j * y_stride;
+        guint8 *y1 = y0 + y_stride;
+        guint8 *chroma = uv + (j / 2) * uv_stride;
+
+        for (guint i = 0; i < width; i += 2) {
+            guint32 sum = 0;
+            guint count = 0;
+            gboolean right = i + 1 < width;
+
+            pack_luma(lut, in0[i], y0 + i, &sum, &count);
+            if (right) {
+                pack_luma(lut, in0[i + 1], y0 + i + 1, &sum, &count);
+            }
+            if (in1) {
+                pack_luma(lut, in1[i], y1 + i, &sum, &count);
+                if (right) {
+                    pack_luma(lut, in1[i + 1], y1 + i + 1, &sum, &count);
+                }
+            }
+
+            // The fine depth of the block is the one of its mean valid depth
+            guint mean = count ? (sum + count / 2) / count : 0;
+            chroma[i] = lut[mean * 3 + 1];
+            chroma[i + 1] = lut[mean * 3 + 2];
+        }
+    }
+}
+// <---- Packing
+
+// ----> Unpacking
+static inline guint hue_level(guint r, guint g, guint b) {
+    if (r >= g && r >= b) {
+        if (g >= b) {
+            return g - b;
+        }
+        // Magenta end of the ramp, or codec noise on the blue channel of the red end
+        return b >= 128 ? MIN(1530 - b + g, GST_ZED_DEPTH_HUE_LEVELS - 1) : 0;
+    }
+    if (g >= b) {
+        return 510 + b - r;
+    }
+    return 1020 + r - g;
+}
+
+void gst_zed_depth_unpack_hue(const GstZedDepthPackTables *tables, const guint8 *src,
+                              gsize src_stride, guint8 *dst, gsize dst_stride, guint width,
+                              guint height) {
+    const guint16 *lut = tables->unpack_lut;
+
+    for (guint y = 0; y < height; y++) {
+        const guint8 *in = src + y * src_stride;
+        guint16 *out = (guint16 *) (dst + y * dst_stride);
+
+        for (guint x = 0; x < width; x++, in += 3) {
+            guint r = in[0], g = in[1], b = in[2];
+            if (MAX(r, MAX(g, b)) < HUE_INVALID_THRESHOLD) {
+                out[x] = 0;
+            } else {
+                out[x] = lut[hue_level(r, g, b)];
+            }
+        }
+    }
+}
+
+void gst_zed_depth_unpack_dual_plane(const GstZedDepthPackTables *tables, const guint8 *y,
+                                     gsize y_stride, const guint8 *u, const guint8 *v,
+                                     gsize uv_stride, guint chroma_step, guint8 *dst,
+                                     gsize dst_stride, guint width, guint height) {
+    const guint16 *lut = tables->unpack_lut;
+    const guint8 *sel = tables->chroma_sel;
+
+    for (guint j = 0; j < height; j++) {
+        const guint8 *luma = y + j * y_stride;
+        const guint8 *chroma[2] = {u + (j / 2) * uv_stride, v + (j / 2) * uv_stride};
+        guint16 *out = (guint16 *) (dst + j * dst_stride);
+
+        for (guint i = 0; i < width; i++) {
+            guint l = luma[i];
+            guint f = chroma[sel[l]][(i / 2) * chroma_step];
+            out[i] = lut[(l << 8) | f];
+        }
+    }
+}
+// <---- Unpacking
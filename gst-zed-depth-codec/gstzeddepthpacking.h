@@ -0,0 +1,104 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef GST_ZED_DEPTH_PACKING_H
+#define GST_ZED_DEPTH_PACKING_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Packing of 16 bits depth maps into 8 bits video frames that survive lossy video codecs.
+ *
+ * Depth values are normalized over [depth_min, depth_max], invalid pixels (0) stay invalid.
+ *
+ * HUE: RGB frame. The normalized depth is mapped on 1276 levels of a hue ramp going from red
+ * (near) to magenta (far), each level changing a single channel by one unit. Invalid pixels
+ * are black.
+ *
+ * DUAL_PLANE: NV12 frame, following the triangle wave scheme of Pece et al. ("Adapting standard
+ * video codecs for depth streaming"). The Y plane holds a coarse depth on 240 levels
+ * (16 + level, invalid pixels are 0). The U and V samples hold two triangle waves in quadrature
+ * with a period of 16 coarse levels, giving the fine depth of each 2x2 block. The decoder
+ * selects the wave in its linear part from the coarse value, so that an error of up to 1.5
+ * coarse levels does not change the decoded depth.
+ */
+
+typedef enum {
+    GST_ZED_DEPTH_PACKING_HUE = 0,
+    GST_ZED_DEPTH_PACKING_DUAL_PLANE = 1,
+} GstZedDepthPacking;
+
+#define GST_ZED_DEPTH_HUE_LEVELS 1276
+#define GST_ZED_DEPTH_COARSE_LEVELS 240
+
+typedef struct {
+    GstZedDepthPacking packing;
+    guint depth_min;
+    guint depth_max;
+
+    // Packing: 3 bytes per depth value, R, G, B (HUE) or Y, U, V (DUAL_PLANE)
+    guint8 *pack_lut;
+
+    // Unpacking: depth of each hue level (HUE) or of each (Y << 8 | chroma) pair (DUAL_PLANE)
+    guint16 *unpack_lut;
+    // DUAL_PLANE unpacking: chroma sample to read for each Y value, 0 for U and 1 for V
+    guint8 chroma_sel[256];
+} GstZedDepthPackTables;
+
+/* Build the lookup tables of one direction. `depth_min` must be lower than `depth_max`. */
+void gst_zed_depth_pack_tables_init(GstZedDepthPackTables *tables, GstZedDepthPacking packing,
+                                    guint depth_min, guint depth_max, gboolean unpack);
+void gst_zed_depth_pack_tables_clear(GstZedDepthPackTables *tables);
+
+/* Maximum quantization error of the unpacked depth, in depth units, without the error introduced
+ * by the video codec. DUAL_PLANE frames carry the fine depth of the mean of each 2x2 block: the
+ * depth variations inside a block add to this error, which stays bounded by 2.5 coarse levels.
+ */
+gdouble gst_zed_depth_packing_max_error(GstZedDepthPacking packing, guint depth_min,
+                                        guint depth_max);
+
+/* GRAY16 to RGB */
+void gst_zed_depth_pack_hue(const GstZedDepthPackTables *tables, const guint8 *src,
+                            gsize src_stride, guint8 *dst, gsize dst_stride, guint width,
+                            guint height);
+
+/* GRAY16 to NV12 */
+void gst_zed_depth_pack_dual_plane(const GstZedDepthPackTables *tables, const guint8 *src,
+                                   gsize src_stride, guint8 *y, gsize y_stride, guint8 *uv,
+                                   gsize uv_stride, guint width, guint height);
+
+/* RGB to GRAY16 */
+void gst_zed_depth_unpack_hue(const GstZedDepthPackTables *tables, const guint8 *src,
+                              gsize src_stride, guint8 *dst, gsize dst_stride, guint width,
+                              guint height);
+
+/* NV12 or I420 to GRAY16. `chroma_step` is the distance in bytes between two U samples: 2 for
+ * NV12 (with `v` = `u` + 1) and 1 for I420.
+ */
+void gst_zed_depth_unpack_dual_plane(const GstZedDepthPackTables *tables, const guint8 *y,
+                                     gsize y_stride, const guint8 *u, const guint8 *v,
+                                     gsize uv_stride, guint chroma_step, guint8 *dst,
+                                     gsize dst_stride, guint width, guint height);
+
+G_END_DECLS
+
+#endif   // GST_ZED_DEPTH_PACKING_H
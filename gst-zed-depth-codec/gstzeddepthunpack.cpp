@@ -0,0 +1,327 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzeddepthunpack.h"
+
+#include "gst-zed-meta/gstzedmeta.h"
+#include "gst-zed-meta/gstzedtimingmeta.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_zed_depth_unpack_debug);
+#define GST_CAT_DEFAULT gst_zed_depth_unpack_debug
+
+enum {
+    PROP_0,
+    PROP_DEPTH_MIN,
+    PROP_DEPTH_MAX,
+    PROP_MAX_ERROR,
+};
+
+#define DEFAULT_PROP_DEPTH_MIN 300.f
+#define DEFAULT_PROP_DEPTH_MAX 20000.f
+
+// RGB frames carry the HUE packing, YUV frames the DUAL_PLANE packing
+static const gchar *packed_formats[] = {"RGB", "NV12", "I420"};
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE(
+    "sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string){ RGB, NV12, I420 }, "
+                    "width = (int)[ 1, 8192 ], "
+                    "height = (int)[ 1, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE(
+    "src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string)GRAY16_LE, "
+                    "width = (int)[ 1, 8192 ], "
+                    "height = (int)[ 1, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+#define gst_zed_depth_unpack_parent_class parent_class
+G_DEFINE_TYPE(GstZedDepthUnpack, gst_zed_depth_unpack, GST_TYPE_BASE_TRANSFORM);
+
+static void gst_zed_depth_unpack_set_property(GObject *object, guint prop_id, const GValue *value,
+                                              GParamSpec *pspec);
+static void gst_zed_depth_unpack_get_property(GObject *object, guint prop_id, GValue *value,
+                                              GParamSpec *pspec);
+
+static GstCaps *gst_zed_depth_unpack_transform_caps(GstBaseTransform *base,
+                                                    GstPadDirection direction, GstCaps *caps,
+                                                    GstCaps *filter);
+static gboolean gst_zed_depth_unpack_get_unit_size(GstBaseTransform *base, GstCaps *caps,
+                                                   gsize *size);
+static gboolean gst_zed_depth_unpack_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                              GstCaps *outcaps);
+static gboolean gst_zed_depth_unpack_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                    GstMeta *meta, GstBuffer *inbuf);
+static GstFlowReturn gst_zed_depth_unpack_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                    GstBuffer *outbuf);
+static gboolean gst_zed_depth_unpack_stop(GstBaseTransform *base);
+
+static void gst_zed_depth_unpack_class_init(GstZedDepthUnpackClass *klass) {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass *gstelement_class = GST_ELEMENT_CLASS(klass);
+    GstBaseTransformClass *trans_class = GST_BASE_TRANSFORM_CLASS(klass);
+
+    gobject_class->set_property = gst_zed_depth_unpack_set_property;
+    gobject_class->get_property = gst_zed_depth_unpack_get_property;
+
+    g_object_class_install_property(
+        gobject_class, PROP_DEPTH_MIN,
+        g_param_spec_float("depth-minimum-distance", "Minimum depth value",
+                           "Depth of the first level, must match the one of zeddepthpack", 0.f,
+                           65534.f, DEFAULT_PROP_DEPTH_MIN,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_DEPTH_MAX,
+        g_param_spec_float("depth-maximum-distance", "Maximum depth value",
+                           "Depth of the last level, must match the one of zeddepthpack", 1.f,
+                           65535.f, DEFAULT_PROP_DEPTH_MAX,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_MAX_ERROR,
+        g_param_spec_float("max-error", "Maximum error",
+                           "Quantization error bound of the negotiated packing, in depth units, "
+                           "without the errors of the video codec",
+                           0.f, G_MAXFLOAT, 0.f,
+                           (GParamFlags) (G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+
+    gst_element_class_set_static_metadata(
+        gstelement_class, "ZED Depth Unpacker", "Filter/Converter/Video",
+        "Unpacks the 16 bits depth maps packed into video frames by zeddepthpack",
+        "Stereolabs <support@stereolabs.com>");
+
+    gst_element_class_add_static_pad_template(gstelement_class, &sink_template);
+    gst_element_class_add_static_pad_template(gstelement_class, &src_template);
+
+    trans_class->transform_caps = GST_DEBUG_FUNCPTR(gst_zed_depth_unpack_transform_caps);
+    trans_class->get_unit_size = GST_DEBUG_FUNCPTR(gst_zed_depth_unpack_get_unit_size);
+    trans_class->set_caps = GST_DEBUG_FUNCPTR(gst_zed_depth_unpack_set_caps);
+    trans_class->transform_meta = GST_DEBUG_FUNCPTR(gst_zed_depth_unpack_transform_meta);
+    trans_class->transform = GST_DEBUG_FUNCPTR(gst_zed_depth_unpack_transform);
+    trans_class->stop = GST_DEBUG_FUNCPTR(gst_zed_depth_unpack_stop);
+    trans_class->passthrough_on_same_caps = FALSE;
+
+    GST_DEBUG_CATEGORY_INIT(gst_zed_depth_unpack_debug, "zeddepthunpack", 0,
+                            "ZED Depth Unpacker");
+}
+
+static void gst_zed_depth_unpack_init(GstZedDepthUnpack *unpack) {
+    gst_video_info_init(&unpack->in_info);
+    gst_video_info_init(&unpack->out_info);
+    unpack->tables.pack_lut = NULL;
+    unpack->tables.unpack_lut = NULL;
+    unpack->packing = GST_ZED_DEPTH_PACKING_HUE;
+
+    unpack->depth_min = DEFAULT_PROP_DEPTH_MIN;
+    unpack->depth_max = DEFAULT_PROP_DEPTH_MAX;
+}
+
+static void gst_zed_depth_unpack_set_property(GObject *object, guint prop_id, const GValue *value,
+                                              GParamSpec *pspec) {
+    GstZedDepthUnpack *unpack = GST_ZED_DEPTH_UNPACK(object);
+
+    GST_OBJECT_LOCK(unpack);
+    switch (prop_id) {
+    case PROP_DEPTH_MIN:
+        unpack->depth_min = g_value_get_float(value);
+        break;
+    case PROP_DEPTH_MAX:
+        unpack->depth_max = g_value_get_float(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(unpack);
+}
+
+static void gst_zed_depth_unpack_get_property(GObject *object, guint prop_id, GValue *value,
+                                              GParamSpec *pspec) {
+    GstZedDepthUnpack *unpack = GST_ZED_DEPTH_UNPACK(object);
+
+    GST_OBJECT_LOCK(unpack);
+    switch (prop_id) {
+    case PROP_DEPTH_MIN:
+        g_value_set_float(value, unpack->depth_min);
+        break;
+    case PROP_DEPTH_MAX:
+        g_value_set_float(value, unpack->depth_max);
+        break;
+    case PROP_MAX_ERROR:
+        g_value_set_float(value, gst_zed_depth_packing_max_error(unpack->packing,
+                                                                 (guint) unpack->depth_min,
+                                                                 (guint) unpack->depth_max));
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(unpack);
+}
+
+static GstCaps *gst_zed_depth_unpack_transform_caps(GstBaseTransform *base,
+                                                    GstPadDirection direction, GstCaps *caps,
+                                                    GstCaps *filter) {
+    GstCaps *res = gst_caps_new_empty();
+
+    for (guint i = 0; i < gst_caps_get_size(caps); i++) {
+        GstStructure *s = gst_structure_copy(gst_caps_get_structure(caps, i));
+        gst_structure_remove_fields(s, "colorimetry", "chroma-site", NULL);
+
+        if (direction == GST_PAD_SINK) {
+            gst_structure_set(s, "format", G_TYPE_STRING, "GRAY16_LE", NULL);
+            gst_caps_append_structure(res, s);
+            continue;
+        }
+
+        for (guint f = 0; f < G_N_ELEMENTS(packed_formats); f++) {
+            GstStructure *packed = gst_structure_copy(s);
+            gst_structure_set(packed, "format", G_TYPE_STRING, packed_formats[f], NULL);
+            gst_caps_append_structure(res, packed);
+        }
+        gst_structure_free(s);
+    }
+
+    if (filter) {
+        GstCaps *tmp = gst_caps_intersect_full(filter, res, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref(res);
+        res = tmp;
+    }
+
+    GST_DEBUG_OBJECT(base, "Transformed %" GST_PTR_FORMAT " into %" GST_PTR_FORMAT, caps, res);
+    return res;
+}
+
+static gboolean gst_zed_depth_unpack_get_unit_size(GstBaseTransform *base, GstCaps *caps,
+                                                   gsize *size) {
+    GstVideoInfo vinfo;
+
+    if (!gst_video_info_from_caps(&vinfo, caps)) {
+        return FALSE;
+    }
+    *size = GST_VIDEO_INFO_SIZE(&vinfo);
+    return TRUE;
+}
+
+static gboolean gst_zed_depth_unpack_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                              GstCaps *outcaps) {
+    GstZedDepthUnpack *unpack = GST_ZED_DEPTH_UNPACK(base);
+
+    if (!gst_video_info_from_caps(&unpack->in_info, incaps) ||
+        !gst_video_info_from_caps(&unpack->out_info, outcaps)) {
+        GST_ERROR_OBJECT(unpack, "Invalid caps %" GST_PTR_FORMAT " -> %" GST_PTR_FORMAT, incaps,
+                         outcaps);
+        return FALSE;
+    }
+
+    GST_OBJECT_LOCK(unpack);
+    guint depth_min = (guint) unpack->depth_min;
+    guint depth_max = (guint) unpack->depth_max;
+    unpack->packing = GST_VIDEO_INFO_FORMAT(&unpack->in_info) == GST_VIDEO_FORMAT_RGB
+                          ? GST_ZED_DEPTH_PACKING_HUE
+                          : GST_ZED_DEPTH_PACKING_DUAL_PLANE;
+    GST_OBJECT_UNLOCK(unpack);
+
+    if (depth_min >= depth_max) {
+        GST_ELEMENT_ERROR(unpack, LIBRARY, SETTINGS,
+                          ("The minimum depth must be lower than the maximum depth"),
+                          ("Depth range [%u, %u]", depth_min, depth_max));
+        return FALSE;
+    }
+
+    gst_zed_depth_pack_tables_clear(&unpack->tables);
+    gst_zed_depth_pack_tables_init(&unpack->tables, unpack->packing, depth_min, depth_max, TRUE);
+
+    GST_INFO_OBJECT(unpack, "Unpacking depth [%u, %u] from %s frames, maximum error %.2f",
+                    depth_min, depth_max,
+                    gst_video_format_to_string(GST_VIDEO_INFO_FORMAT(&unpack->in_info)),
+                    gst_zed_depth_packing_max_error(unpack->packing, depth_min, depth_max));
+    return TRUE;
+}
+
+static gboolean gst_zed_depth_unpack_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                    GstMeta *meta, GstBuffer *inbuf) {
+    GType api = meta->info->api;
+    if (api == GST_ZED_SRC_META_API_TYPE || api == GST_ZED_TIMING_META_API_TYPE) {
+        return TRUE;
+    }
+    return GST_BASE_TRANSFORM_CLASS(parent_class)->transform_meta(base, outbuf, meta, inbuf);
+}
+
+static GstFlowReturn gst_zed_depth_unpack_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                    GstBuffer *outbuf) {
+    GstZedDepthUnpack *unpack = GST_ZED_DEPTH_UNPACK(base);
+    GstVideoFrame in_frame, out_frame;
+
+    if (!gst_video_frame_map(&in_frame, &unpack->in_info, inbuf, GST_MAP_READ)) {
+        GST_ELEMENT_ERROR(unpack, RESOURCE, FAILED, ("Failed to map input buffer for reading"),
+                          (NULL));
+        return GST_FLOW_ERROR;
+    }
+    if (!gst_video_frame_map(&out_frame, &unpack->out_info, outbuf, GST_MAP_WRITE)) {
+        gst_video_frame_unmap(&in_frame);
+        GST_ELEMENT_ERROR(unpack, RESOURCE, FAILED, ("Failed to map output buffer for writing"),
+                          (NULL));
+        return GST_FLOW_ERROR;
+    }
+
+    guint8 *dst = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&out_frame, 0);
+    gsize dst_stride = GST_VIDEO_FRAME_PLANE_STRIDE(&out_frame, 0);
+    guint width = GST_VIDEO_FRAME_WIDTH(&out_frame);
+    guint height = GST_VIDEO_FRAME_HEIGHT(&out_frame);
+    const guint8 *y = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&in_frame, 0);
+    gsize y_stride = GST_VIDEO_FRAME_PLANE_STRIDE(&in_frame, 0);
+
+    switch (GST_VIDEO_FRAME_FORMAT(&in_frame)) {
+    case GST_VIDEO_FORMAT_RGB:
+        gst_zed_depth_unpack_hue(&unpack->tables, y, y_stride, dst, dst_stride, width, height);
+        break;
+    case GST_VIDEO_FORMAT_NV12: {
+        const guint8 *uv = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&in_frame, 1);
+        gst_zed_depth_unpack_dual_plane(&unpack->tables, y, y_stride, uv, uv + 1,
+                                        GST_VIDEO_FRAME_PLANE_STRIDE(&in_frame, 1), 2, dst,
+                                        dst_stride, width, height);
+        break;
+    }
+    default:   // I420
+        gst_zed_depth_unpack_dual_plane(
+            &unpack->tables, y, y_stride, (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&in_frame, 1),
+            (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&in_frame, 2),
+            GST_VIDEO_FRAME_PLANE_STRIDE(&in_frame, 1), 1, dst, dst_stride, width, height);
+        break;
+    }
+
+    gst_video_frame_unmap(&out_frame);
+    gst_video_frame_unmap(&in_frame);
+
+    return GST_FLOW_OK;
+}
+
+static gboolean gst_zed_depth_unpack_stop(GstBaseTransform *base) {
+    GstZedDepthUnpack *unpack = GST_ZED_DEPTH_UNPACK(base);
+
+    gst_zed_depth_pack_tables_clear(&unpack->tables);
+    return TRUE;
+}
@@ -0,0 +1,394 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzeddepthdecimate.h"
+
+#include "gst-zed-meta/gstzedmeta.h"
+#include "gst-zed-meta/gstzedtimingmeta.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_zed_depth_decimate_debug);
+#define GST_CAT_DEFAULT gst_zed_depth_decimate_debug
+
+enum {
+    PROP_0,
+    PROP_FACTOR,
+    PROP_POOLING,
+};
+
+#define DEFAULT_PROP_FACTOR 2
+#define DEFAULT_PROP_POOLING GST_ZED_DEPTH_POOLING_MIN
+
+#define MAX_SIZE 8192
+
+#define GST_TYPE_ZED_DEPTH_DECIMATE_FACTOR (gst_zed_depth_decimate_factor_get_type())
+static GType gst_zed_depth_decimate_factor_get_type(void) {
+    static GType zed_depth_decimate_factor_type = 0;
+
+    if (!zed_depth_decimate_factor_type) {
+        static GEnumValue pattern_types[] = {
+            {2, "2x2 blocks, 4 times less pixels", "2"},
+            {4, "4x4 blocks, 16 times less pixels", "4"},
+            {8, "8x8 blocks, 64 times less pixels", "8"},
+            {0, NULL, NULL},
+        };
+
+        zed_depth_decimate_factor_type =
+            g_enum_register_static("GstZedDepthDecimateFactor", pattern_types);
+    }
+
+    return zed_depth_decimate_factor_type;
+}
+
+#define GST_TYPE_ZED_DEPTH_POOLING (gst_zed_depth_pooling_get_type())
+static GType gst_zed_depth_pooling_get_type(void) {
+    static GType zed_depth_pooling_type = 0;
+
+    if (!zed_depth_pooling_type) {
+        static GEnumValue pattern_types[] = {
+            {GST_ZED_DEPTH_POOLING_MIN, "Nearest valid depth of the block", "MIN"},
+            {GST_ZED_DEPTH_POOLING_MEDIAN, "Lower median of the valid depths of the block",
+             "MEDIAN"},
+            {GST_ZED_DEPTH_POOLING_NEAREST, "Valid pixel closest to the center of the block",
+             "NEAREST"},
+            {0, NULL, NULL},
+        };
+
+        zed_depth_pooling_type = g_enum_register_static("GstZedDepthPooling", pattern_types);
+    }
+
+    return zed_depth_pooling_type;
+}
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE(
+    "sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string)GRAY16_LE, "
+                    "width = (int)[ 1, 8192 ], "
+                    "height = (int)[ 1, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE(
+    "src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string)GRAY16_LE, "
+                    "width = (int)[ 1, 4096 ], "
+                    "height = (int)[ 1, 4096 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+#define gst_zed_depth_decimate_parent_class parent_class
+G_DEFINE_TYPE(GstZedDepthDecimate, gst_zed_depth_decimate, GST_TYPE_BASE_TRANSFORM);
+
+static void gst_zed_depth_decimate_set_property(GObject *object, guint prop_id,
+                                                const GValue *value, GParamSpec *pspec);
+static void gst_zed_depth_decimate_get_property(GObject *object, guint prop_id, GValue *value,
+                                                GParamSpec *pspec);
+static void gst_zed_depth_decimate_finalize(GObject *object);
+
+static GstCaps *gst_zed_depth_decimate_transform_caps(GstBaseTransform *base,
+                                                      GstPadDirection direction, GstCaps *caps,
+                                                      GstCaps *filter);
+static gboolean gst_zed_depth_decimate_get_unit_size(GstBaseTransform *base, GstCaps *caps,
+                                                     gsize *size);
+static gboolean gst_zed_depth_decimate_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                                GstCaps *outcaps);
+static gboolean gst_zed_depth_decimate_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                      GstMeta *meta, GstBuffer *inbuf);
+static GstFlowReturn gst_zed_depth_decimate_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                      GstBuffer *outbuf);
+static gboolean gst_zed_depth_decimate_stop(GstBaseTransform *base);
+
+static void gst_zed_depth_decimate_class_init(GstZedDepthDecimateClass *klass) {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass *gstelement_class = GST_ELEMENT_CLASS(klass);
+    GstBaseTransformClass *trans_class = GST_BASE_TRANSFORM_CLASS(klass);
+
+    gobject_class->set_property = gst_zed_depth_decimate_set_property;
+    gobject_class->get_property = gst_zed_depth_decimate_get_property;
+    gobject_class->finalize = gst_zed_depth_decimate_finalize;
+
+    g_object_class_install_property(
+        gobject_class, PROP_FACTOR,
+        g_param_spec_enum("factor", "Decimation factor",
+                          "Width and height of the blocks of pixels reduced to one pixel",
+                          GST_TYPE_ZED_DEPTH_DECIMATE_FACTOR, DEFAULT_PROP_FACTOR,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_POOLING,
+        g_param_spec_enum("pooling", "Pooling", "How the valid depths of a block are reduced",
+                          GST_TYPE_ZED_DEPTH_POOLING, DEFAULT_PROP_POOLING,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    gst_element_class_set_static_metadata(
+        gstelement_class, "ZED Depth Decimation", "Filter/Converter/Video/Scaler",
+        "Reduce the resolution of 16 bits depth maps ignoring the invalid pixels",
+        "Stereolabs <support@stereolabs.com>");
+
+    gst_element_class_add_static_pad_template(gstelement_class, &sink_template);
+    gst_element_class_add_static_pad_template(gstelement_class, &src_template);
+
+    trans_class->transform_caps = GST_DEBUG_FUNCPTR(gst_zed_depth_decimate_transform_caps);
+    trans_class->get_unit_size = GST_DEBUG_FUNCPTR(gst_zed_depth_decimate_get_unit_size);
+    trans_class->set_caps = GST_DEBUG_FUNCPTR(gst_zed_depth_decimate_set_caps);
+    trans_class->transform_meta = GST_DEBUG_FUNCPTR(gst_zed_depth_decimate_transform_meta);
+    trans_class->transform = GST_DEBUG_FUNCPTR(gst_zed_depth_decimate_transform);
+    trans_class->stop = GST_DEBUG_FUNCPTR(gst_zed_depth_decimate_stop);
+    trans_class->passthrough_on_same_caps = FALSE;
+
+    GST_DEBUG_CATEGORY_INIT(gst_zed_depth_decimate_debug, "zeddepthdecimate", 0,
+                            "ZED Depth Decimation");
+}
+
+static void gst_zed_depth_decimate_init(GstZedDepthDecimate *decimate) {
+    gst_video_info_init(&decimate->in_info);
+    gst_video_info_init(&decimate->out_info);
+    decimate->caps_factor = 0;
+    decimate->tmp = NULL;
+
+    decimate->factor = DEFAULT_PROP_FACTOR;
+    decimate->pooling = DEFAULT_PROP_POOLING;
+}
+
+static void gst_zed_depth_decimate_finalize(GObject *object) {
+    GstZedDepthDecimate *decimate = GST_ZED_DEPTH_DECIMATE(object);
+
+    g_free(decimate->tmp);
+    decimate->tmp = NULL;
+
+    G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
+static void gst_zed_depth_decimate_set_property(GObject *object, guint prop_id,
+                                                const GValue *value, GParamSpec *pspec) {
+    GstZedDepthDecimate *decimate = GST_ZED_DEPTH_DECIMATE(object);
+    gboolean reconfigure = FALSE;
+
+    GST_OBJECT_LOCK(decimate);
+    switch (prop_id) {
+    case PROP_FACTOR:
+        reconfigure = decimate->factor != (guint) g_value_get_enum(value);
+        decimate->factor = (guint) g_value_get_enum(value);
+        break;
+    case PROP_POOLING:
+        decimate->pooling = (GstZedDepthPooling) g_value_get_enum(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(decimate);
+
+    // The output size changes with the factor
+    if (reconfigure) {
+        gst_pad_mark_reconfigure(GST_BASE_TRANSFORM_SRC_PAD(decimate));
+    }
+}
+
+static void gst_zed_depth_decimate_get_property(GObject *object, guint prop_id, GValue *value,
+                                                GParamSpec *pspec) {
+    GstZedDepthDecimate *decimate = GST_ZED_DEPTH_DECIMATE(object);
+
+    GST_OBJECT_LOCK(decimate);
+    switch (prop_id) {
+    case PROP_FACTOR:
+        g_value_set_enum(value, (gint) decimate->factor);
+        break;
+    case PROP_POOLING:
+        g_value_set_enum(value, decimate->pooling);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(decimate);
+}
+
+/* Replace the `field` size of `s` by the sizes it gives on the other side of the element: the
+ * output size is the input size divided by `factor` and rounded up.
+ */
+static void transform_size(GstStructure *s, const gchar *field, GstPadDirection direction,
+                           gint factor) {
+    const GValue *value = gst_structure_get_value(s, field);
+    gint min, max;
+
+    if (value == NULL) {
+        return;
+    }
+    if (G_VALUE_HOLDS_INT(value)) {
+        min = max = g_value_get_int(value);
+    } else if (GST_VALUE_HOLDS_INT_RANGE(value)) {
+        min = gst_value_get_int_range_min(value);
+        max = gst_value_get_int_range_max(value);
+    } else {
+        gst_structure_remove_field(s, field);
+        return;
+    }
+
+    if (direction == GST_PAD_SINK) {
+        min = (MAX(min, 1) + factor - 1) / factor;
+        max = (MIN(max, MAX_SIZE) + factor - 1) / factor;
+    } else {
+        min = (MAX(min, 1) - 1) * factor + 1;
+        max = MIN(max, MAX_SIZE / factor) * factor;
+    }
+
+    if (min >= max) {
+        gst_structure_set(s, field, G_TYPE_INT, min, NULL);
+    } else {
+        gst_structure_set(s, field, GST_TYPE_INT_RANGE, min, max, NULL);
+    }
+}
+
+static GstCaps *gst_zed_depth_decimate_transform_caps(GstBaseTransform *base,
+                                                      GstPadDirection direction, GstCaps *caps,
+                                                      GstCaps *filter) {
+    GstZedDepthDecimate *decimate = GST_ZED_DEPTH_DECIMATE(base);
+    GstCaps *res = gst_caps_new_empty();
+
+    GST_OBJECT_LOCK(decimate);
+    gint factor = (gint) decimate->factor;
+    GST_OBJECT_UNLOCK(decimate);
+
+    for (guint i = 0; i < gst_caps_get_size(caps); i++) {
+        GstStructure *s = gst_structure_copy(gst_caps_get_structure(caps, i));
+
+        transform_size(s, "width", direction, factor);
+        transform_size(s, "height", direction, factor);
+        gst_caps_append_structure(res, s);
+    }
+
+    if (filter) {
+        GstCaps *tmp = gst_caps_intersect_full(filter, res, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref(res);
+        res = tmp;
+    }
+
+    GST_DEBUG_OBJECT(base, "Transformed %" GST_PTR_FORMAT " into %" GST_PTR_FORMAT, caps, res);
+    return res;
+}
+
+static gboolean gst_zed_depth_decimate_get_unit_size(GstBaseTransform *base, GstCaps *caps,
+                                                     gsize *size) {
+    GstVideoInfo vinfo;
+
+    if (!gst_video_info_from_caps(&vinfo, caps)) {
+        return FALSE;
+    }
+    *size = GST_VIDEO_INFO_SIZE(&vinfo);
+    return TRUE;
+}
+
+static gboolean gst_zed_depth_decimate_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                                GstCaps *outcaps) {
+    GstZedDepthDecimate *decimate = GST_ZED_DEPTH_DECIMATE(base);
+
+    if (!gst_video_info_from_caps(&decimate->in_info, incaps) ||
+        !gst_video_info_from_caps(&decimate->out_info, outcaps)) {
+        GST_ERROR_OBJECT(decimate, "Invalid caps %" GST_PTR_FORMAT " -> %" GST_PTR_FORMAT,
+                         incaps, outcaps);
+        return FALSE;
+    }
+
+    GST_OBJECT_LOCK(decimate);
+    guint factor = decimate->factor;
+    GST_OBJECT_UNLOCK(decimate);
+
+    guint in_w = GST_VIDEO_INFO_WIDTH(&decimate->in_info);
+    guint in_h = GST_VIDEO_INFO_HEIGHT(&decimate->in_info);
+    if (GST_VIDEO_INFO_WIDTH(&decimate->out_info) != (gint) ((in_w + factor - 1) / factor) ||
+        GST_VIDEO_INFO_HEIGHT(&decimate->out_info) != (gint) ((in_h + factor - 1) / factor)) {
+        GST_ERROR_OBJECT(decimate, "Output size does not match a decimation by %u", factor);
+        return FALSE;
+    }
+    decimate->caps_factor = factor;
+
+    g_free(decimate->tmp);
+    decimate->tmp = (guint16 *) g_malloc(in_w * sizeof(guint16));
+
+    GST_INFO_OBJECT(decimate, "Decimating %ux%u depth maps by %u", in_w, in_h, factor);
+    return TRUE;
+}
+
+static gboolean gst_zed_depth_decimate_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                      GstMeta *meta, GstBuffer *inbuf) {
+    // The ZED metadata is copied, its 2D coordinates are rescaled after the decimation
+    GType api = meta->info->api;
+    if (api == GST_ZED_SRC_META_API_TYPE || api == GST_ZED_TIMING_META_API_TYPE) {
+        return TRUE;
+    }
+    return GST_BASE_TRANSFORM_CLASS(parent_class)->transform_meta(base, outbuf, meta, inbuf);
+}
+
+static GstFlowReturn gst_zed_depth_decimate_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                      GstBuffer *outbuf) {
+    GstZedDepthDecimate *decimate = GST_ZED_DEPTH_DECIMATE(base);
+    GstVideoFrame in_frame, out_frame;
+
+    GST_OBJECT_LOCK(decimate);
+    GstZedDepthPooling pooling = decimate->pooling;
+    GST_OBJECT_UNLOCK(decimate);
+    guint factor = decimate->caps_factor;
+
+    if (!gst_video_frame_map(&in_frame, &decimate->in_info, inbuf, GST_MAP_READ)) {
+        GST_ELEMENT_ERROR(decimate, RESOURCE, FAILED, ("Failed to map input buffer"), (NULL));
+        return GST_FLOW_ERROR;
+    }
+    if (!gst_video_frame_map(&out_frame, &decimate->out_info, outbuf, GST_MAP_WRITE)) {
+        gst_video_frame_unmap(&in_frame);
+        GST_ELEMENT_ERROR(decimate, RESOURCE, FAILED, ("Failed to map output buffer"), (NULL));
+        return GST_FLOW_ERROR;
+    }
+
+    const guint8 *in = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&in_frame, 0);
+    gsize in_stride = GST_VIDEO_FRAME_PLANE_STRIDE(&in_frame, 0);
+    guint in_w = GST_VIDEO_FRAME_WIDTH(&in_frame);
+    guint in_h = GST_VIDEO_FRAME_HEIGHT(&in_frame);
+    guint8 *out = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&out_frame, 0);
+    gsize out_stride = GST_VIDEO_FRAME_PLANE_STRIDE(&out_frame, 0);
+
+    for (guint y = 0; y < (guint) GST_VIDEO_FRAME_HEIGHT(&out_frame); y++) {
+        // The rows of the last partial blocks are completed with the last row of the frame
+        const guint16 *rows[8];
+        for (guint r = 0; r < factor; r++) {
+            rows[r] = (const guint16 *) (in + MIN(y * factor + r, in_h - 1) * in_stride);
+        }
+        gst_zed_depth_decimate_row(pooling, factor, rows, in_w, (guint16 *) (out + y * out_stride),
+                                   decimate->tmp);
+    }
+
+    gst_video_frame_unmap(&out_frame);
+    gst_video_frame_unmap(&in_frame);
+
+    GstZedSrcMeta *meta = gst_buffer_get_zed_src_meta(outbuf);
+    if (meta) {
+        gst_zed_src_meta_scale(meta, 1.0 / factor, 1.0 / factor);
+    }
+
+    return GST_FLOW_OK;
+}
+
+static gboolean gst_zed_depth_decimate_stop(GstBaseTransform *base) {
+    GstZedDepthDecimate *decimate = GST_ZED_DEPTH_DECIMATE(base);
+
+    g_free(decimate->tmp);
+    decimate->tmp = NULL;
+    return TRUE;
+}
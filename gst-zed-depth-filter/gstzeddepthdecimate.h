@@ -0,0 +1,52 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef __GST_ZED_DEPTH_DECIMATE_H__
+#define __GST_ZED_DEPTH_DECIMATE_H__
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#include "gstzeddepthfilterkernels.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_ZED_DEPTH_DECIMATE (gst_zed_depth_decimate_get_type())
+G_DECLARE_FINAL_TYPE(GstZedDepthDecimate, gst_zed_depth_decimate, GST, ZED_DEPTH_DECIMATE,
+                     GstBaseTransform)
+
+struct _GstZedDepthDecimate {
+    GstBaseTransform element;
+
+    GstVideoInfo in_info;
+    GstVideoInfo out_info;
+    guint caps_factor;   // factor of the negotiated caps
+    guint16 *tmp;        // one input row for the row kernels
+
+    // Properties
+    guint factor;
+    GstZedDepthPooling pooling;
+};
+
+G_END_DECLS
+
+#endif /* __GST_ZED_DEPTH_DECIMATE_H__ */
@@ -0,0 +1,537 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzeddepthfilter.h"
+
+#include <string.h>
+
+#include "gstzeddepthfilterkernels.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_zed_depth_filter_debug);
+#define GST_CAT_DEFAULT gst_zed_depth_filter_debug
+
+enum {
+    PROP_0,
+    PROP_SPATIAL_ITERATIONS,
+    PROP_SPATIAL_THRESHOLD,
+    PROP_TEMPORAL_ALPHA,
+    PROP_TEMPORAL_THRESHOLD,
+    PROP_TEMPORAL_PERSISTENCE,
+    PROP_HOLE_FILL_SIZE,
+    PROP_THREADS,
+};
+
+#define DEFAULT_PROP_SPATIAL_ITERATIONS 1
+#define DEFAULT_PROP_SPATIAL_THRESHOLD 4.f
+#define DEFAULT_PROP_TEMPORAL_ALPHA 0.4f
+#define DEFAULT_PROP_TEMPORAL_THRESHOLD 5.f
+#define DEFAULT_PROP_TEMPORAL_PERSISTENCE 2
+#define DEFAULT_PROP_HOLE_FILL_SIZE 8
+#define DEFAULT_PROP_THREADS 1
+
+#define MAX_THREADS 64
+
+// Largest threshold, in percent of the depth, supported by the row kernels
+#define MAX_THRESHOLD (100.f * GST_ZED_DEPTH_FILTER_MAX_RATIO / 65536)
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE(
+    "sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string)GRAY16_LE, "
+                    "width = (int)[ 1, 8192 ], "
+                    "height = (int)[ 1, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE(
+    "src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string)GRAY16_LE, "
+                    "width = (int)[ 1, 8192 ], "
+                    "height = (int)[ 1, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+// Filtering parameters of a frame, in the fixed point formats of the row kernels
+typedef struct {
+    guint spatial_iterations;
+    guint16 spatial_ratio;
+    gboolean temporal;
+    guint16 temporal_beta;
+    guint16 temporal_ratio;
+    guint16 temporal_persistence;
+    guint hole_fill_size;
+} GstZedDepthFilterParams;
+
+typedef enum {
+    GST_ZED_DEPTH_FILTER_PASS_HORIZONTAL,   // frame to scratch
+    GST_ZED_DEPTH_FILTER_PASS_VERTICAL,     // scratch to frame
+    GST_ZED_DEPTH_FILTER_PASS_NONE,         // only the temporal filter and the hole filling
+} GstZedDepthFilterPass;
+
+// Horizontal band of the frame processed by one thread
+typedef struct {
+    GstZedDepthFilter *filter;
+    const GstZedDepthFilterParams *params;
+    GstZedDepthFilterPass pass;
+    gboolean finish;   // run the temporal filter and the hole filling on the output rows
+    guint8 *data;
+    gsize stride;
+    guint width;
+    guint height;
+    guint y_begin;
+    guint y_end;
+} GstZedDepthFilterSlice;
+
+#define gst_zed_depth_filter_parent_class parent_class
+G_DEFINE_TYPE(GstZedDepthFilter, gst_zed_depth_filter, GST_TYPE_BASE_TRANSFORM);
+
+static void gst_zed_depth_filter_set_property(GObject *object, guint prop_id, const GValue *value,
+                                              GParamSpec *pspec);
+static void gst_zed_depth_filter_get_property(GObject *object, guint prop_id, GValue *value,
+                                              GParamSpec *pspec);
+static void gst_zed_depth_filter_finalize(GObject *object);
+
+static gboolean gst_zed_depth_filter_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                              GstCaps *outcaps);
+static gboolean gst_zed_depth_filter_sink_event(GstBaseTransform *base, GstEvent *event);
+static GstFlowReturn gst_zed_depth_filter_transform_ip(GstBaseTransform *base, GstBuffer *buf);
+static gboolean gst_zed_depth_filter_stop(GstBaseTransform *base);
+
+static void ensure_pool(GstZedDepthFilter *filter, guint threads);
+static void run_slices(GstZedDepthFilter *filter, const GstZedDepthFilterParams *params,
+                       GstZedDepthFilterPass pass, gboolean finish, GstVideoFrame *frame);
+
+static void gst_zed_depth_filter_class_init(GstZedDepthFilterClass *klass) {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass *gstelement_class = GST_ELEMENT_CLASS(klass);
+    GstBaseTransformClass *trans_class = GST_BASE_TRANSFORM_CLASS(klass);
+
+    gobject_class->set_property = gst_zed_depth_filter_set_property;
+    gobject_class->get_property = gst_zed_depth_filter_get_property;
+    gobject_class->finalize = gst_zed_depth_filter_finalize;
+
+    g_object_class_install_property(
+        gobject_class, PROP_SPATIAL_ITERATIONS,
+        g_param_spec_uint("spatial-iterations", "Spatial iterations",
+                          "Number of passes of the edge-preserving spatial filter, 0 to disable it",
+                          0, 5, DEFAULT_PROP_SPATIAL_ITERATIONS,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_SPATIAL_THRESHOLD,
+        g_param_spec_float("spatial-threshold", "Spatial threshold",
+                           "Largest depth difference with a neighbor pixel that is smoothed, in "
+                           "percent of the depth. Larger differences are preserved as edges",
+                           0.f, MAX_THRESHOLD, DEFAULT_PROP_SPATIAL_THRESHOLD,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_TEMPORAL_ALPHA,
+        g_param_spec_float("temporal-alpha", "Temporal alpha",
+                           "Weight of the new frame in the exponential temporal filter, 1 to "
+                           "disable it",
+                           0.f, 1.f, DEFAULT_PROP_TEMPORAL_ALPHA,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_TEMPORAL_THRESHOLD,
+        g_param_spec_float("temporal-threshold", "Temporal threshold",
+                           "Largest depth difference with the history that is filtered, in "
+                           "percent of the depth. Larger differences reset the history",
+                           0.f, MAX_THRESHOLD, DEFAULT_PROP_TEMPORAL_THRESHOLD,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_TEMPORAL_PERSISTENCE,
+        g_param_spec_uint("temporal-persistence", "Temporal persistence",
+                          "Number of frames an invalid pixel keeps its last valid depth, 0 to "
+                          "disable it",
+                          0, 255, DEFAULT_PROP_TEMPORAL_PERSISTENCE,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_HOLE_FILL_SIZE,
+        g_param_spec_uint("hole-fill-size", "Hole filling size",
+                          "Largest horizontal hole, in pixels, filled with the farthest of its "
+                          "neighbors, 0 to disable the hole filling",
+                          0, 8192, DEFAULT_PROP_HOLE_FILL_SIZE,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_THREADS,
+        g_param_spec_uint("threads", "Threads",
+                          "Number of threads filtering the frames, each one processing a "
+                          "horizontal band of the image",
+                          1, MAX_THREADS, DEFAULT_PROP_THREADS,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    gst_element_class_set_static_metadata(
+        gstelement_class, "ZED Depth Filter", "Filter/Video",
+        "Spatial, temporal and hole filling post-processing of 16 bits depth maps",
+        "Stereolabs <support@stereolabs.com>");
+
+    gst_element_class_add_static_pad_template(gstelement_class, &sink_template);
+    gst_element_class_add_static_pad_template(gstelement_class, &src_template);
+
+    trans_class->set_caps = GST_DEBUG_FUNCPTR(gst_zed_depth_filter_set_caps);
+    trans_class->sink_event = GST_DEBUG_FUNCPTR(gst_zed_depth_filter_sink_event);
+    trans_class->transform_ip = GST_DEBUG_FUNCPTR(gst_zed_depth_filter_transform_ip);
+    trans_class->stop = GST_DEBUG_FUNCPTR(gst_zed_depth_filter_stop);
+    trans_class->passthrough_on_same_caps = FALSE;
+
+    GST_DEBUG_CATEGORY_INIT(gst_zed_depth_filter_debug, "zeddepthfilter", 0, "ZED Depth Filter");
+}
+
+static void gst_zed_depth_filter_init(GstZedDepthFilter *filter) {
+    gst_video_info_init(&filter->vinfo);
+
+    filter->scratch = NULL;
+    filter->history = NULL;
+    filter->age = NULL;
+    filter->reset_history = TRUE;
+
+    filter->pool = NULL;
+    filter->pool_size = 0;
+    g_mutex_init(&filter->lock);
+    g_cond_init(&filter->cond);
+    filter->pending = 0;
+
+    filter->spatial_iterations = DEFAULT_PROP_SPATIAL_ITERATIONS;
+    filter->spatial_threshold = DEFAULT_PROP_SPATIAL_THRESHOLD;
+    filter->temporal_alpha = DEFAULT_PROP_TEMPORAL_ALPHA;
+    filter->temporal_threshold = DEFAULT_PROP_TEMPORAL_THRESHOLD;
+    filter->temporal_persistence = DEFAULT_PROP_TEMPORAL_PERSISTENCE;
+    filter->hole_fill_size = DEFAULT_PROP_HOLE_FILL_SIZE;
+    filter->threads = DEFAULT_PROP_THREADS;
+}
+
+static void free_buffers(GstZedDepthFilter *filter) {
+    g_free(filter->scratch);
+    filter->scratch = NULL;
+    g_free(filter->history);
+    filter->history = NULL;
+    g_free(filter->age);
+    filter->age = NULL;
+}
+
+static void gst_zed_depth_filter_finalize(GObject *object) {
+    GstZedDepthFilter *filter = GST_ZED_DEPTH_FILTER(object);
+
+    if (filter->pool) {
+        g_thread_pool_free(filter->pool, FALSE, TRUE);
+        filter->pool = NULL;
+    }
+    g_mutex_clear(&filter->lock);
+    g_cond_clear(&filter->cond);
+    free_buffers(filter);
+
+    G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
+static void gst_zed_depth_filter_set_property(GObject *object, guint prop_id, const GValue *value,
+                                              GParamSpec *pspec) {
+    GstZedDepthFilter *filter = GST_ZED_DEPTH_FILTER(object);
+
+    GST_OBJECT_LOCK(filter);
+    switch (prop_id) {
+    case PROP_SPATIAL_ITERATIONS:
+        filter->spatial_iterations = g_value_get_uint(value);
+        break;
+    case PROP_SPATIAL_THRESHOLD:
+        filter->spatial_threshold = g_value_get_float(value);
+        break;
+    case PROP_TEMPORAL_ALPHA:
+        filter->temporal_alpha = g_value_get_float(value);
+        break;
+    case PROP_TEMPORAL_THRESHOLD:
+        filter->temporal_threshold = g_value_get_float(value);
+        break;
+    case PROP_TEMPORAL_PERSISTENCE:
+        filter->temporal_persistence = g_value_get_uint(value);
+        break;
+    case PROP_HOLE_FILL_SIZE:
+        filter->hole_fill_size = g_value_get_uint(value);
+        break;
+    case PROP_THREADS:
+        filter->threads = g_value_get_uint(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(filter);
+}
+
+static void gst_zed_depth_filter_get_property(GObject *object, guint prop_id, GValue *value,
+                                              GParamSpec *pspec) {
+    GstZedDepthFilter *filter = GST_ZED_DEPTH_FILTER(object);
+
+    GST_OBJECT_LOCK(filter);
+    switch (prop_id) {
+    case PROP_SPATIAL_ITERATIONS:
+        g_value_set_uint(value, filter->spatial_iterations);
+        break;
+    case PROP_SPATIAL_THRESHOLD:
+        g_value_set_float(value, filter->spatial_threshold);
+        break;
+    case PROP_TEMPORAL_ALPHA:
+        g_value_set_float(value, filter->temporal_alpha);
+        break;
+    case PROP_TEMPORAL_THRESHOLD:
+        g_value_set_float(value, filter->temporal_threshold);
+        break;
+    case PROP_TEMPORAL_PERSISTENCE:
+        g_value_set_uint(value, filter->temporal_persistence);
+        break;
+    case PROP_HOLE_FILL_SIZE:
+        g_value_set_uint(value, filter->hole_fill_size);
+        break;
+    case PROP_THREADS:
+        g_value_set_uint(value, filter->threads);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(filter);
+}
+
+static gboolean gst_zed_depth_filter_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                              GstCaps *outcaps) {
+    GstZedDepthFilter *filter = GST_ZED_DEPTH_FILTER(base);
+
+    if (!gst_video_info_from_caps(&filter->vinfo, incaps)) {
+        GST_ERROR_OBJECT(filter, "Invalid input caps %" GST_PTR_FORMAT, incaps);
+        return FALSE;
+    }
+
+    gsize pixels = (gsize) GST_VIDEO_INFO_WIDTH(&filter->vinfo) *
+                   GST_VIDEO_INFO_HEIGHT(&filter->vinfo);
+    free_buffers(filter);
+    filter->scratch = (guint16 *) g_malloc(pixels * sizeof(guint16));
+    filter->history = (guint16 *) g_malloc(pixels * sizeof(guint16));
+    filter->age = (guint16 *) g_malloc(pixels * sizeof(guint16));
+    filter->reset_history = TRUE;
+
+    return TRUE;
+}
+
+static gboolean gst_zed_depth_filter_sink_event(GstBaseTransform *base, GstEvent *event) {
+    GstZedDepthFilter *filter = GST_ZED_DEPTH_FILTER(base);
+
+    if (GST_EVENT_TYPE(event) == GST_EVENT_FLUSH_STOP) {
+        filter->reset_history = TRUE;
+    }
+
+    return GST_BASE_TRANSFORM_CLASS(parent_class)->sink_event(base, event);
+}
+
+static void get_params(GstZedDepthFilter *filter, GstZedDepthFilterParams *params,
+                       guint *threads) {
+    GST_OBJECT_LOCK(filter);
+    params->spatial_iterations = filter->spatial_iterations;
+    params->spatial_ratio = (guint16) (filter->spatial_threshold / 100.f * 65536.f);
+    params->temporal = filter->temporal_alpha < 1.f || filter->temporal_persistence > 0;
+    params->temporal_beta = (guint16) ((1.f - filter->temporal_alpha) * 32767.f + 0.5f);
+    params->temporal_ratio = (guint16) (filter->temporal_threshold / 100.f * 65536.f);
+    params->temporal_persistence = (guint16) filter->temporal_persistence;
+    params->hole_fill_size = filter->hole_fill_size;
+    *threads = filter->threads;
+    GST_OBJECT_UNLOCK(filter);
+
+    params->spatial_ratio = MIN(params->spatial_ratio, GST_ZED_DEPTH_FILTER_MAX_RATIO);
+    params->temporal_ratio = MIN(params->temporal_ratio, GST_ZED_DEPTH_FILTER_MAX_RATIO);
+}
+
+static GstFlowReturn gst_zed_depth_filter_transform_ip(GstBaseTransform *base, GstBuffer *buf) {
+    GstZedDepthFilter *filter = GST_ZED_DEPTH_FILTER(base);
+    GstZedDepthFilterParams params;
+    GstVideoFrame frame;
+    guint threads;
+
+    get_params(filter, &params, &threads);
+    if (params.spatial_iterations == 0 && !params.temporal && params.hole_fill_size == 0) {
+        return GST_FLOW_OK;
+    }
+
+    if (!gst_video_frame_map(&frame, &filter->vinfo, buf, GST_MAP_READWRITE)) {
+        GST_ELEMENT_ERROR(filter, RESOURCE, FAILED, ("Failed to map buffer for writing"), (NULL));
+        return GST_FLOW_ERROR;
+    }
+
+    // The history of the temporal filter does not survive a discontinuity
+    if (filter->reset_history || GST_BUFFER_FLAG_IS_SET(buf, GST_BUFFER_FLAG_DISCONT)) {
+        gsize size = (gsize) GST_VIDEO_FRAME_WIDTH(&frame) * GST_VIDEO_FRAME_HEIGHT(&frame) *
+                     sizeof(guint16);
+        memset(filter->history, 0, size);
+        memset(filter->age, 0, size);
+        filter->reset_history = FALSE;
+    }
+
+    ensure_pool(filter, threads);
+
+    if (params.spatial_iterations == 0) {
+        run_slices(filter, &params, GST_ZED_DEPTH_FILTER_PASS_NONE, TRUE, &frame);
+    }
+    for (guint i = 0; i < params.spatial_iterations; i++) {
+        run_slices(filter, &params, GST_ZED_DEPTH_FILTER_PASS_HORIZONTAL, FALSE, &frame);
+        run_slices(filter, &params, GST_ZED_DEPTH_FILTER_PASS_VERTICAL,
+                   i + 1 == params.spatial_iterations, &frame);
+    }
+
+    gst_video_frame_unmap(&frame);
+
+    return GST_FLOW_OK;
+}
+
+static gboolean gst_zed_depth_filter_stop(GstBaseTransform *base) {
+    GstZedDepthFilter *filter = GST_ZED_DEPTH_FILTER(base);
+
+    free_buffers(filter);
+    filter->reset_history = TRUE;
+    return TRUE;
+}
+
+// ----> Slices
+static void run_slice(GstZedDepthFilterSlice *slice) {
+    GstZedDepthFilter *filter = slice->filter;
+    const GstZedDepthFilterParams *params = slice->params;
+    guint width = slice->width;
+
+    for (guint y = slice->y_begin; y < slice->y_end; y++) {
+        guint16 *row = (guint16 *) (slice->data + y * slice->stride);
+        guint16 *scratch = filter->scratch + (gsize) y * width;
+
+        if (slice->pass == GST_ZED_DEPTH_FILTER_PASS_HORIZONTAL) {
+            gst_zed_depth_filter_spatial_row(row, scratch, width, params->spatial_ratio);
+        } else if (slice->pass == GST_ZED_DEPTH_FILTER_PASS_VERTICAL) {
+            // The missing neighbors of the first and last rows are replaced by the rows themselves
+            const guint16 *above = y > 0 ? scratch - width : scratch;
+            const guint16 *below = y + 1 < slice->height ? scratch + width : scratch;
+            gst_zed_depth_filter_spatial_col(above, scratch, below, row, width,
+                                             params->spatial_ratio);
+        }
+
+        if (!slice->finish) {
+            continue;
+        }
+        if (params->temporal) {
+            gst_zed_depth_filter_temporal_row(row, filter->history + (gsize) y * width,
+                                              filter->age + (gsize) y * width, width,
+                                              params->temporal_beta, params->temporal_ratio,
+                                              params->temporal_persistence);
+        }
+        if (params->hole_fill_size > 0) {
+            gst_zed_depth_filter_fill_holes_row(row, width, params->hole_fill_size);
+        }
+    }
+}
+
+static void slice_worker(gpointer data, gpointer user_data) {
+    GstZedDepthFilter *filter = GST_ZED_DEPTH_FILTER(user_data);
+
+    run_slice((GstZedDepthFilterSlice *) data);
+
+    g_mutex_lock(&filter->lock);
+    filter->pending--;
+    if (filter->pending == 0) {
+        g_cond_signal(&filter->cond);
+    }
+    g_mutex_unlock(&filter->lock);
+}
+
+static void ensure_pool(GstZedDepthFilter *filter, guint threads) {
+    guint workers = threads > 1 ? threads - 1 : 0;
+
+    if (filter->pool && filter->pool_size == workers) {
+        return;
+    }
+
+    if (filter->pool) {
+        g_thread_pool_free(filter->pool, FALSE, TRUE);
+        filter->pool = NULL;
+        filter->pool_size = 0;
+    }
+
+    if (workers == 0) {
+        return;
+    }
+
+    GError *error = NULL;
+    filter->pool = g_thread_pool_new(slice_worker, filter, workers, TRUE, &error);
+    if (filter->pool == NULL) {
+        GST_WARNING_OBJECT(filter, "Cannot start the filtering threads: %s",
+                           error ? error->message : "unknown error");
+        g_clear_error(&error);
+        return;
+    }
+    filter->pool_size = workers;
+
+    GST_DEBUG_OBJECT(filter, "Filtering with %u threads", workers + 1);
+}
+
+/* Split the frame in horizontal bands, one per thread, and run one pass on them. The first band
+ * is processed by the calling thread. A pass only reads the rows of the other bands that are
+ * not written during the same pass.
+ */
+static void run_slices(GstZedDepthFilter *filter, const GstZedDepthFilterParams *params,
+                       GstZedDepthFilterPass pass, gboolean finish, GstVideoFrame *frame) {
+    guint height = GST_VIDEO_FRAME_HEIGHT(frame);
+    guint bands = filter->pool ? MIN(filter->pool_size + 1, height) : 1;
+    bands = MAX(bands, 1);
+    guint band_h = (height + bands - 1) / bands;
+
+    GstZedDepthFilterSlice slices[MAX_THREADS];
+    guint count = 0;
+    for (guint y = 0; y < height; y += band_h) {
+        GstZedDepthFilterSlice *slice = &slices[count++];
+        slice->filter = filter;
+        slice->params = params;
+        slice->pass = pass;
+        slice->finish = finish;
+        slice->data = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA(frame, 0);
+        slice->stride = GST_VIDEO_FRAME_PLANE_STRIDE(frame, 0);
+        slice->width = GST_VIDEO_FRAME_WIDTH(frame);
+        slice->height = height;
+        slice->y_begin = y;
+        slice->y_end = MIN(y + band_h, height);
+    }
+
+    if (count > 1) {
+        g_mutex_lock(&filter->lock);
+        filter->pending = count - 1;
+        g_mutex_unlock(&filter->lock);
+
+        for (guint s = 1; s < count; s++) {
+            g_thread_pool_push(filter->pool, &slices[s], NULL);
+        }
+    }
+
+    run_slice(&slices[0]);
+
+    if (count > 1) {
+        g_mutex_lock(&filter->lock);
+        while (filter->pending > 0) {
+            g_cond_wait(&filter->cond, &filter->lock);
+        }
+        g_mutex_unlock(&filter->lock);
+    }
+}
+// <---- Slices
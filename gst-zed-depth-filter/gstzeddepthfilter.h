@@ -0,0 +1,66 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef __GST_ZED_DEPTH_FILTER_H__
+#define __GST_ZED_DEPTH_FILTER_H__
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_ZED_DEPTH_FILTER (gst_zed_depth_filter_get_type())
+G_DECLARE_FINAL_TYPE(GstZedDepthFilter, gst_zed_depth_filter, GST, ZED_DEPTH_FILTER,
+                     GstBaseTransform)
+
+struct _GstZedDepthFilter {
+    GstBaseTransform element;
+
+    GstVideoInfo vinfo;
+
+    // Output of the horizontal pass of the spatial filter
+    guint16 *scratch;
+    // Temporal filter state, one value per pixel
+    guint16 *history;
+    guint16 *age;
+    gboolean reset_history;
+
+    // Slice workers, used when `threads` > 1
+    GThreadPool *pool;
+    guint pool_size;
+    GMutex lock;
+    GCond cond;
+    guint pending;
+
+    // Properties
+    guint spatial_iterations;
+    gfloat spatial_threshold;
+    gfloat temporal_alpha;
+    gfloat temporal_threshold;
+    guint temporal_persistence;
+    guint hole_fill_size;
+    guint threads;
+};
+
+G_END_DECLS
+
+#endif /* __GST_ZED_DEPTH_FILTER_H__ */
@@ -0,0 +1,535 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzeddepthfilterkernels.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// ----> Spatial filter
+static inline guint16 smooth3(guint16 l, guint16 c, guint16 r, guint16 ratio) {
+    guint t = ((guint32) c * ratio) >> 16;
+
+    if (l == 0 || (guint) ABS((gint) l - (gint) c) > t) {
+        l = c;
+    }
+    if (r == 0 || (guint) ABS((gint) r - (gint) c) > t) {
+        r = c;
+    }
+    // Same rounding as the SIMD averages
+    return (guint16) ((((l + r + 1) >> 1) + c + 1) >> 1);
+}
+
+#if defined(__SSE2__)
+static inline __m128i smooth3_sse2(__m128i l, __m128i c, __m128i r, __m128i ratio) {
+    const __m128i zeros = _mm_setzero_si128();
+    __m128i t = _mm_mulhi_epu16(c, ratio);
+
+    __m128i dl = _mm_or_si128(_mm_subs_epu16(l, c), _mm_subs_epu16(c, l));
+    __m128i dr = _mm_or_si128(_mm_subs_epu16(r, c), _mm_subs_epu16(c, r));
+    // A neighbor is kept when it is valid and close to the center: |d| - t saturates to 0
+    __m128i keep_l = _mm_andnot_si128(_mm_cmpeq_epi16(l, zeros),
+                                      _mm_cmpeq_epi16(_mm_subs_epu16(dl, t), zeros));
+    __m128i keep_r = _mm_andnot_si128(_mm_cmpeq_epi16(r, zeros),
+                                      _mm_cmpeq_epi16(_mm_subs_epu16(dr, t), zeros));
+    l = _mm_or_si128(_mm_and_si128(keep_l, l), _mm_andnot_si128(keep_l, c));
+    r = _mm_or_si128(_mm_and_si128(keep_r, r), _mm_andnot_si128(keep_r, c));
+
+    return _mm_avg_epu16(_mm_avg_epu16(l, r), c);
+}
+#elif defined(__ARM_NEON)
+static inline uint16x8_t smooth3_neon(uint16x8_t l, uint16x8_t c, uint16x8_t r, uint16x4_t ratio) {
+    uint16x8_t t = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(c), ratio), 16),
+                                vshrn_n_u32(vmull_u16(vget_high_u16(c), ratio), 16));
+
+    uint16x8_t keep_l = vandq_u16(vtstq_u16(l, l), vcleq_u16(vabdq_u16(l, c), t));
+    uint16x8_t keep_r = vandq_u16(vtstq_u16(r, r), vcleq_u16(vabdq_u16(r, c), t));
+    l = vbslq_u16(keep_l, l, c);
+    r = vbslq_u16(keep_r, r, c);
+
+    return vrhaddq_u16(vrhaddq_u16(l, r), c);
+}
+#endif
+
+void gst_zed_depth_filter_spatial_row(const guint16 *in, guint16 *out, guint width,
+                                      guint16 ratio) {
+    if (width == 0) {
+        return;
+    }
+    if (width == 1) {
+        out[0] = in[0];
+        return;
+    }
+
+    // The missing neighbors of the first and last pixels are replaced by the pixels themselves
+    out[0] = smooth3(in[0], in[0], in[1], ratio);
+
+    guint x = 1;
+#if defined(__SSE2__)
+    const __m128i k = _mm_set1_epi16((short) ratio);
+    for (; x + 9 <= width; x += 8) {
+        __m128i l = _mm_loadu_si128((const __m128i *) (in + x - 1));
+        __m128i c = _mm_loadu_si128((const __m128i *) (in + x));
+        __m128i r = _mm_loadu_si128((const __m128i *) (in + x + 1));
+        _mm_storeu_si128((__m128i *) (out + x), smooth3_sse2(l, c, r, k));
+    }
+#elif defined(__ARM_NEON)
+    const uint16x4_t k = vdup_n_u16(ratio);
+    for (; x + 9 <= width; x += 8) {
+        vst1q_u16(out + x, smooth3_neon(vld1q_u16(in + x - 1), vld1q_u16(in + x),
+                                        vld1q_u16(in + x + 1), k));
+    }
+#endif
+    for (; x + 1 < width; x++) {
+        out[x] = smooth3(in[x - 1], in[x], in[x + 1], ratio);
+    }
+
+    out[width - 1] = smooth3(in[width - 2], in[width - 1], in[width - 1], ratio);
+}
+
+void gst_zed_depth_filter_spatial_col(const guint16 *above, const guint16 *in,
+                                      const guint16 *below, guint16 *out, guint width,
+                                      guint16 ratio) {
+    guint x = 0;
+#if defined(__SSE2__)
+    const __m128i k = _mm_set1_epi16((short) ratio);
+    for (; x + 8 <= width; x += 8) {
+        __m128i l = _mm_loadu_si128((const __m128i *) (above + x));
+        __m128i c = _mm_loadu_si128((const __m128i *) (in + x));
+        __m128i r = _mm_loadu_si128((const __m128i *) (below + x));
+        _mm_storeu_si128((__m128i *) (out + x), smooth3_sse2(l, c, r, k));
+    }
+#elif defined(__ARM_NEON)
+    const uint16x4_t k = vdup_n_u16(ratio);
+    for (; x + 8 <= width; x += 8) {
+        vst1q_u16(out + x,
+                  smooth3_neon(vld1q_u16(above + x), vld1q_u16(in + x), vld1q_u16(below + x), k));
+    }
+#endif
+    for (; x < width; x++) {
+        out[x] = smooth3(above[x], in[x], below[x], ratio);
+    }
+}
+// <---- Spatial filter
+
+// ----> Temporal filter
+void gst_zed_depth_filter_temporal_row(guint16 *row, guint16 *history, guint16 *age, guint width,
+                                       guint16 beta, guint16 ratio, guint16 persistence) {
+    guint x = 0;
+#if defined(__SSE2__)
+    const __m128i zeros = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    const __m128i k = _mm_set1_epi16((short) ratio);
+    const __m128i b = _mm_set1_epi16((short) beta);
+    const __m128i p = _mm_set1_epi16((short) persistence);
+    for (; x + 8 <= width; x += 8) {
+        __m128i cur = _mm_loadu_si128((const __m128i *) (row + x));
+        __m128i prev = _mm_loadu_si128((const __m128i *) (history + x));
+        __m128i a = _mm_loadu_si128((const __m128i *) (age + x));
+
+        __m128i invalid = _mm_cmpeq_epi16(cur, zeros);
+        __m128i t = _mm_mulhi_epu16(prev, k);
+        __m128i d = _mm_or_si128(_mm_subs_epu16(cur, prev), _mm_subs_epu16(prev, cur));
+        __m128i close = _mm_andnot_si128(_mm_cmpeq_epi16(prev, zeros),
+                                         _mm_cmpeq_epi16(_mm_subs_epu16(d, t), zeros));
+        // cur - (1 - alpha) x (cur - prev), the difference fits in 15 bits when `close`
+        __m128i diff = _mm_slli_epi16(_mm_sub_epi16(cur, prev), 1);
+        __m128i blended = _mm_sub_epi16(cur, _mm_mulhi_epi16(diff, b));
+        __m128i valid_out = _mm_or_si128(_mm_and_si128(close, blended),
+                                         _mm_andnot_si128(close, cur));
+
+        a = _mm_and_si128(invalid, _mm_adds_epu16(a, ones));
+        __m128i persist = _mm_and_si128(invalid, _mm_cmpeq_epi16(_mm_subs_epu16(a, p), zeros));
+        __m128i out =
+            _mm_or_si128(_mm_andnot_si128(invalid, valid_out), _mm_and_si128(persist, prev));
+
+        __m128i keep = _mm_cmpeq_epi16(out, zeros);
+        prev = _mm_or_si128(_mm_and_si128(keep, prev), _mm_andnot_si128(keep, out));
+
+        _mm_storeu_si128((__m128i *) (row + x), out);
+        _mm_storeu_si128((__m128i *) (history + x), prev);
+        _mm_storeu_si128((__m128i *) (age + x), a);
+    }
+#elif defined(__ARM_NEON)
+    const uint16x4_t k = vdup_n_u16(ratio);
+    const int16x8_t b = vdupq_n_s16((int16_t) beta);
+    const uint16x8_t p = vdupq_n_u16(persistence);
+    for (; x + 8 <= width; x += 8) {
+        uint16x8_t cur = vld1q_u16(row + x);
+        uint16x8_t prev = vld1q_u16(history + x);
+        uint16x8_t a = vld1q_u16(age + x);
+
+        uint16x8_t invalid = vceqq_u16(cur, vdupq_n_u16(0));
+        uint16x8_t t = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(prev), k), 16),
+                                    vshrn_n_u32(vmull_u16(vget_high_u16(prev), k), 16));
+        uint16x8_t close = vandq_u16(vtstq_u16(prev, prev), vcleq_u16(vabdq_u16(cur, prev), t));
+        // cur - (1 - alpha) x (cur - prev), the difference fits in 15 bits when `close`
+        int16x8_t diff = vreinterpretq_s16_u16(vsubq_u16(cur, prev));
+        uint16x8_t blended = vsubq_u16(cur, vreinterpretq_u16_s16(vqdmulhq_s16(diff, b)));
+        uint16x8_t valid_out = vbslq_u16(close, blended, cur);
+
+        a = vandq_u16(invalid, vqaddq_u16(a, vdupq_n_u16(1)));
+        uint16x8_t persist = vandq_u16(invalid, vcleq_u16(a, p));
+        uint16x8_t out = vbslq_u16(invalid, vandq_u16(persist, prev), valid_out);
+
+        prev = vbslq_u16(vceqq_u16(out, vdupq_n_u16(0)), prev, out);
+
+        vst1q_u16(row + x, out);
+        vst1q_u16(history + x, prev);
+        vst1q_u16(age + x, a);
+    }
+#endif
+    for (; x < width; x++) {
+        guint16 cur = row[x];
+        guint16 prev = history[x];
+        guint16 out;
+
+        if (cur != 0) {
+            gint diff = (gint) cur - (gint) prev;
+            guint t = ((guint32) prev * ratio) >> 16;
+            if (prev != 0 && (guint) ABS(diff) <= t) {
+                out = (guint16) (cur - ((diff * 2 * (gint) beta) >> 16));
+            } else {
+                out = cur;
+            }
+            age[x] = 0;
+        } else {
+            age[x] = age[x] < G_MAXUINT16 ? age[x] + 1 : G_MAXUINT16;
+            out = age[x] <= persistence ? prev : 0;
+        }
+
+        row[x] = out;
+        if (out != 0) {
+            history[x] = out;
+        }
+    }
+}
+// <---- Temporal filter
+
+// ----> Hole filling
+/* Number of consecutive pixels equal to zero (`zero` TRUE) or not equal to zero (`zero` FALSE)
+ * starting from `row[x]`, up to the end of the row.
+ */
+static inline guint run_length(const guint16 *row, guint x, guint width, gboolean zero) {
+    guint start = x;
+#if defined(__SSE2__)
+    const __m128i zeros = _mm_setzero_si128();
+    for (; x + 8 <= width; x += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (row + x));
+        guint mask = (guint) _mm_movemask_epi8(_mm_cmpeq_epi16(v, zeros));
+        if (!zero) {
+            mask = ~mask & 0xFFFF;
+        }
+        // `mask` has 2 bits set for each pixel of the run
+        if (mask != 0xFFFF) {
+            return x - start + (guint) __builtin_ctz(~mask) / 2;
+        }
+    }
+#elif defined(__ARM_NEON)
+    for (; x + 8 <= width; x += 8) {
+        uint16x8_t eq = vceqq_u16(vld1q_u16(row + x), vdupq_n_u16(0));
+        if (!zero) {
+            eq = vmvnq_u16(eq);
+        }
+        // One byte for each pixel, 0xFF when it belongs to the run
+        guint64 mask = vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(eq)), 0);
+        if (mask != G_GUINT64_CONSTANT(0xFFFFFFFFFFFFFFFF)) {
+            return x - start + (guint) __builtin_ctzll(~mask) / 8;
+        }
+    }
+#endif
+    for (; x < width; x++) {
+        if ((row[x] == 0) != (zero != FALSE)) {
+            break;
+        }
+    }
+    return x - start;
+}
+
+void gst_zed_depth_filter_fill_holes_row(guint16 *row, guint width, guint max_size) {
+    guint x = run_length(row, 0, width, TRUE);   // holes on the left border are not filled
+
+    while (x < width) {
+        x += run_length(row, x, width, FALSE);
+        if (x >= width) {
+            break;
+        }
+
+        guint start = x;
+        x += run_length(row, x, width, TRUE);
+        if (x < width && x - start <= max_size) {
+            guint16 fill = MAX(row[start - 1], row[x]);
+            for (guint i = start; i < x; i++) {
+                row[i] = fill;
+            }
+        }
+    }
+}
+// <---- Hole filling
+
+// ----> Decimation
+#if defined(__SSE2__)
+/* Even and odd pixels of the 16 pixels at `p`, moved to the signed domain (xor 0x8000) so that
+ * the signed 16 bits instructions compare them as unsigned values.
+ */
+static inline void deinterleave_sse2(const guint16 *p, __m128i *even, __m128i *odd) {
+    const __m128i bias = _mm_set1_epi16((short) 0x8000);
+    __m128i v0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) p), bias);
+    __m128i v1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (p + 8)), bias);
+
+    *even = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(v0, 16), 16),
+                            _mm_srai_epi32(_mm_slli_epi32(v1, 16), 16));
+    *odd = _mm_packs_epi32(_mm_srai_epi32(v0, 16), _mm_srai_epi32(v1, 16));
+}
+#endif
+
+/* MIN works on `v - 1`: the invalid pixels wrap to the largest value and never win unless the
+ * whole block is invalid, which wraps back to 0 on output.
+ */
+static void decimate_min(guint factor, const guint16 *const *rows, guint width, guint16 *out,
+                         guint16 *tmp) {
+    guint x = 0;
+#if defined(__SSE2__)
+    const __m128i bias = _mm_set1_epi16((short) 0x8000);
+    const __m128i ones = _mm_set1_epi16(1);
+    for (; x + 8 <= width; x += 8) {
+        __m128i m = _mm_set1_epi16(0x7FFF);
+        for (guint r = 0; r < factor; r++) {
+            __m128i v = _mm_loadu_si128((const __m128i *) (rows[r] + x));
+            m = _mm_min_epi16(m, _mm_xor_si128(_mm_sub_epi16(v, ones), bias));
+        }
+        _mm_storeu_si128((__m128i *) (tmp + x), _mm_xor_si128(m, bias));
+    }
+#elif defined(__ARM_NEON)
+    const uint16x8_t ones = vdupq_n_u16(1);
+    for (; x + 8 <= width; x += 8) {
+        uint16x8_t m = vdupq_n_u16(0xFFFF);
+        for (guint r = 0; r < factor; r++) {
+            m = vminq_u16(m, vsubq_u16(vld1q_u16(rows[r] + x), ones));
+        }
+        vst1q_u16(tmp + x, m);
+    }
+#endif
+    for (; x < width; x++) {
+        guint16 m = 0xFFFF;
+        for (guint r = 0; r < factor; r++) {
+            m = MIN(m, (guint16) (rows[r][x] - 1));
+        }
+        tmp[x] = m;
+    }
+
+    // Pairwise horizontal reductions, in place: output `i` is written after reading `2 * i`
+    guint n = width;
+    for (guint f = factor; f > 1; f >>= 1) {
+        guint i = 0;
+#if defined(__SSE2__)
+        for (; 2 * i + 16 <= n; i += 8) {
+            __m128i even, odd;
+            deinterleave_sse2(tmp + 2 * i, &even, &odd);
+            _mm_storeu_si128((__m128i *) (tmp + i), _mm_xor_si128(_mm_min_epi16(even, odd), bias));
+        }
+#elif defined(__ARM_NEON)
+        for (; 2 * i + 16 <= n; i += 8) {
+            uint16x8x2_t v = vld2q_u16(tmp + 2 * i);
+            vst1q_u16(tmp + i, vminq_u16(v.val[0], v.val[1]));
+        }
+#endif
+        for (; 2 * i < n; i++) {
+            guint16 a = tmp[2 * i];
+            tmp[i] = 2 * i + 1 < n ? MIN(a, tmp[2 * i + 1]) : a;
+        }
+        n = i;
+    }
+
+    for (guint i = 0; i < n; i++) {
+        out[i] = (guint16) (tmp[i] + 1);
+    }
+}
+
+/* Median of the 2x2 blocks of 8 output pixels. The blocks are sorted with a 5 comparators
+ * network where the invalid pixels come first, the lower median of the valid ones is then
+ * s1, s2 or s3 depending on how many of them are invalid.
+ */
+static guint decimate_median2(const guint16 *const *rows, guint width, guint16 *out) {
+    guint i = 0;
+#if defined(__SSE2__)
+    const __m128i bias = _mm_set1_epi16((short) 0x8000);
+    const __m128i invalid = bias;   // 0 in the signed domain
+    const __m128i three = _mm_set1_epi16(-3);
+    for (; 2 * i + 16 <= width; i += 8) {
+        __m128i a, b, c, d;
+        deinterleave_sse2(rows[0] + 2 * i, &a, &b);
+        deinterleave_sse2(rows[1] + 2 * i, &c, &d);
+
+        // Minus the number of invalid pixels
+        __m128i z = _mm_add_epi16(
+            _mm_add_epi16(_mm_cmpeq_epi16(a, invalid), _mm_cmpeq_epi16(b, invalid)),
+            _mm_add_epi16(_mm_cmpeq_epi16(c, invalid), _mm_cmpeq_epi16(d, invalid)));
+
+        __m128i t1 = _mm_min_epi16(a, b), t2 = _mm_max_epi16(a, b);
+        __m128i t3 = _mm_min_epi16(c, d), t4 = _mm_max_epi16(c, d);
+        __m128i lo = _mm_max_epi16(t1, t3), hi = _mm_min_epi16(t2, t4);
+        __m128i s1 = _mm_min_epi16(lo, hi), s2 = _mm_max_epi16(lo, hi);
+        __m128i s3 = _mm_max_epi16(t2, t4);
+
+        __m128i all = _mm_cmpeq_epi16(z, _mm_setzero_si128());
+        __m128i two = _mm_cmpgt_epi16(z, three);
+        __m128i m = _mm_or_si128(_mm_and_si128(two, s2), _mm_andnot_si128(two, s3));
+        m = _mm_or_si128(_mm_and_si128(all, s1), _mm_andnot_si128(all, m));
+        _mm_storeu_si128((__m128i *) (out + i), _mm_xor_si128(m, bias));
+    }
+#elif defined(__ARM_NEON)
+    const uint16x8_t zeros = vdupq_n_u16(0);
+    for (; 2 * i + 16 <= width; i += 8) {
+        uint16x8x2_t r0 = vld2q_u16(rows[0] + 2 * i);
+        uint16x8x2_t r1 = vld2q_u16(rows[1] + 2 * i);
+        uint16x8_t a = r0.val[0], b = r0.val[1], c = r1.val[0], d = r1.val[1];
+
+        uint16x8_t n = vaddq_u16(vaddq_u16(vshrq_n_u16(vceqq_u16(a, zeros), 15),
+                                           vshrq_n_u16(vceqq_u16(b, zeros), 15)),
+                                 vaddq_u16(vshrq_n_u16(vceqq_u16(c, zeros), 15),
+                                           vshrq_n_u16(vceqq_u16(d, zeros), 15)));
+
+        uint16x8_t t1 = vminq_u16(a, b), t2 = vmaxq_u16(a, b);
+        uint16x8_t t3 = vminq_u16(c, d), t4 = vmaxq_u16(c, d);
+        uint16x8_t lo = vmaxq_u16(t1, t3), hi = vminq_u16(t2, t4);
+        uint16x8_t s1 = vminq_u16(lo, hi), s2 = vmaxq_u16(lo, hi);
+        uint16x8_t s3 = vmaxq_u16(t2, t4);
+
+        uint16x8_t m = vbslq_u16(vcleq_u16(n, vdupq_n_u16(2)), s2, s3);
+        vst1q_u16(out + i, vbslq_u16(vceqq_u16(n, zeros), s1, m));
+    }
+#endif
+    return i;
+}
+
+/* First valid pixel of the 2x2 blocks of 8 output pixels, in raster order. */
+static guint decimate_nearest2(const guint16 *const *rows, guint width, guint16 *out) {
+    guint i = 0;
+#if defined(__SSE2__)
+    const __m128i bias = _mm_set1_epi16((short) 0x8000);
+    for (; 2 * i + 16 <= width; i += 8) {
+        __m128i a, b, c, d;
+        deinterleave_sse2(rows[0] + 2 * i, &a, &b);
+        deinterleave_sse2(rows[1] + 2 * i, &c, &d);
+
+        __m128i m = d;
+        __m128i inv = _mm_cmpeq_epi16(c, bias);
+        m = _mm_or_si128(_mm_and_si128(inv, m), _mm_andnot_si128(inv, c));
+        inv = _mm_cmpeq_epi16(b, bias);
+        m = _mm_or_si128(_mm_and_si128(inv, m), _mm_andnot_si128(inv, b));
+        inv = _mm_cmpeq_epi16(a, bias);
+        m = _mm_or_si128(_mm_and_si128(inv, m), _mm_andnot_si128(inv, a));
+        _mm_storeu_si128((__m128i *) (out + i), _mm_xor_si128(m, bias));
+    }
+#elif defined(__ARM_NEON)
+    const uint16x8_t zeros = vdupq_n_u16(0);
+    for (; 2 * i + 16 <= width; i += 8) {
+        uint16x8x2_t r0 = vld2q_u16(rows[0] + 2 * i);
+        uint16x8x2_t r1 = vld2q_u16(rows[1] + 2 * i);
+
+        uint16x8_t m = vbslq_u16(vceqq_u16(r1.val[0], zeros), r1.val[1], r1.val[0]);
+        m = vbslq_u16(vceqq_u16(r0.val[1], zeros), m, r0.val[1]);
+        vst1q_u16(out + i, vbslq_u16(vceqq_u16(r0.val[0], zeros), m, r0.val[0]));
+    }
+#endif
+    return i;
+}
+
+/* Block offsets (row * 8 + column) sorted by distance to the block center, then in raster
+ * order.
+ */
+static void nearest_order(guint factor, guint8 *order) {
+    guint n = 0;
+    for (guint y = 0; y < factor; y++) {
+        for (guint x = 0; x < factor; x++) {
+            order[n++] = (guint8) (y * 8 + x);
+        }
+    }
+
+    // Distances are compared on the doubled coordinates to stay in integers
+    auto dist = [factor](guint8 o) -> gint {
+        gint dy = 2 * (gint) (o / 8) - (gint) factor + 1;
+        gint dx = 2 * (gint) (o % 8) - (gint) factor + 1;
+        return dx * dx + dy * dy;
+    };
+    std::stable_sort(order, order + n, [&](guint8 a, guint8 b) { return dist(a) < dist(b); });
+}
+
+void gst_zed_depth_decimate_row(GstZedDepthPooling pooling, guint factor,
+                                const guint16 *const *rows, guint width, guint16 *out,
+                                guint16 *tmp) {
+    g_return_if_fail(factor == 2 || factor == 4 || factor == 8);
+
+    if (pooling == GST_ZED_DEPTH_POOLING_MIN) {
+        decimate_min(factor, rows, width, out, tmp);
+        return;
+    }
+
+    guint out_width = (width + factor - 1) / factor;
+    guint i = 0;
+    guint8 order[64];
+    if (factor == 2) {
+        i = pooling == GST_ZED_DEPTH_POOLING_MEDIAN ? decimate_median2(rows, width, out)
+                                                    : decimate_nearest2(rows, width, out);
+    }
+    if (pooling == GST_ZED_DEPTH_POOLING_NEAREST) {
+        nearest_order(factor, order);
+    }
+
+    for (; i < out_width; i++) {
+        guint x0 = i * factor;
+        guint x1 = MIN(x0 + factor, width);
+
+        if (pooling == GST_ZED_DEPTH_POOLING_MEDIAN) {
+            guint16 values[64];
+            guint n = 0;
+            for (guint r = 0; r < factor; r++) {
+                for (guint x = x0; x < x1; x++) {
+                    if (rows[r][x] != 0) {
+                        values[n++] = rows[r][x];
+                    }
+                }
+            }
+            if (n == 0) {
+                out[i] = 0;
+                continue;
+            }
+            std::nth_element(values, values + (n - 1) / 2, values + n);
+            out[i] = values[(n - 1) / 2];
+        } else {
+            out[i] = 0;
+            for (guint k = 0; k < factor * factor; k++) {
+                guint x = x0 + order[k] % 8;
+                if (x < x1 && rows[order[k] / 8][x] != 0) {
+                    out[i] = rows[order[k] / 8][x];
+                    break;
+                }
+            }
+        }
+    }
+}
+// <---- Decimation
@@ -0,0 +1,81 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef GST_ZED_DEPTH_FILTER_KERNELS_H
+#define GST_ZED_DEPTH_FILTER_KERNELS_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Row kernels of `zeddepthfilter` and `zeddepthdecimate`, working on 16 bits depth values where 0
+ * is an invalid pixel.
+ * Thresholds are relative to the depth: `ratio` is a fraction of the depth in Q16 (65536 = 100%),
+ * lower than 25% so that the accepted differences fit in 15 bits.
+ */
+
+#define GST_ZED_DEPTH_FILTER_MAX_RATIO 16384
+
+/* Edge-preserving smoothing: each valid pixel is replaced by (left + 2 x center + right) / 4,
+ * where a neighbor that is invalid or differs from the center by more than `ratio` is replaced by
+ * the center. Invalid pixels stay invalid.
+ * The horizontal version reads `in[0..width)`, the vertical version the pixels of the rows above
+ * and below; `out` must not alias the inputs.
+ */
+void gst_zed_depth_filter_spatial_row(const guint16 *in, guint16 *out, guint width,
+                                      guint16 ratio);
+void gst_zed_depth_filter_spatial_col(const guint16 *above, const guint16 *in,
+                                      const guint16 *below, guint16 *out, guint width,
+                                      guint16 ratio);
+
+/* Exponential filtering with the history of the previous frames.
+ * A valid pixel close to its history (`ratio`) becomes history + alpha x (pixel - history), with
+ * `beta` = (1 - alpha) in Q15; otherwise it resets the history. An invalid pixel takes its
+ * history value while it has been invalid for at most `persistence` frames.
+ * `history` and `age` (number of frames since the pixel was last valid) are updated.
+ */
+void gst_zed_depth_filter_temporal_row(guint16 *row, guint16 *history, guint16 *age, guint width,
+                                       guint16 beta, guint16 ratio, guint16 persistence);
+
+/* Fill the runs of at most `max_size` invalid pixels that lie between two valid pixels with the
+ * farthest of them, so that the holes at the edges of the objects take the background depth.
+ */
+void gst_zed_depth_filter_fill_holes_row(guint16 *row, guint width, guint max_size);
+
+typedef enum {
+    GST_ZED_DEPTH_POOLING_MIN = 0,
+    GST_ZED_DEPTH_POOLING_MEDIAN = 1,
+    GST_ZED_DEPTH_POOLING_NEAREST = 2,
+} GstZedDepthPooling;
+
+/* Reduce `factor` x `factor` blocks (`factor` = 2, 4 or 8) into single pixels, ignoring the
+ * invalid pixels: MIN keeps the nearest depth, MEDIAN the lower median depth and NEAREST the valid
+ * pixel closest to the center of the block. A block without valid pixels gives an invalid pixel.
+ * `rows` are the `factor` input rows of `width` pixels, `out` receives ceil(`width` / `factor`)
+ * pixels, the last block being partial. `tmp` holds `width` values.
+ */
+void gst_zed_depth_decimate_row(GstZedDepthPooling pooling, guint factor,
+                                const guint16 *const *rows, guint width, guint16 *out,
+                                guint16 *tmp);
+
+G_END_DECLS
+
+#endif   // GST_ZED_DEPTH_FILTER_KERNELS_H
@@ -49,9 +49,10 @@ GType gst_zed_src_meta_api_get_type() {
 
     static GType type;
 
-    static const gchar *tags[] = {/*GST_META_TAG_VIDEO_STR, GST_META_TAG_VIDEO_SIZE_STR,
-                                    GST_META_TAG_VIDEO_ORIENTATION_STR,*/
-                                  NULL};
+    // The 2D coordinates of the detected objects depend on the frame geometry: the tags let
+    // `videoscale`, `videocrop` and similar elements call the transform function instead of
+    // blindly copying the metadata
+    static const gchar *tags[] = {GST_META_TAG_VIDEO_STR, GST_META_TAG_VIDEO_SIZE_STR, GST_META_TAG_VIDEO_ORIENTATION_STR, NULL};
 
     if (g_once_init_enter(&type)) {
         GType _type = gst_meta_api_type_register("GstZedSrcMetaAPI", tags);
@@ -79,37 +80,145 @@ static gboolean gst_zed_src_meta_init(GstMeta *meta, gpointer params, GstBuffer
     emeta->pose.orient[0] = 0.0;
     emeta->pose.orient[1] = 0.0;
     emeta->pose.orient[2] = 0.0;
+
+    emeta->od_enabled = FALSE;
+    emeta->obj_count = 0;
+    emeta->od_count = 0;
+    emeta->bt_count = 0;
+    emeta->objects = NULL;
+    emeta->objects_soa = NULL;
     return true;
 }
 
+static guint scale_coord(guint value, gdouble scale) {
+    return (guint) (value * scale + 0.5);
+}
+
+static guint crop_coord(guint value, guint offset, guint size) {
+    if (value <= offset) {
+        return 0;
+    }
+    return MIN(value - offset, size);
+}
+
+void gst_zed_src_meta_scale(GstZedSrcMeta *meta, gdouble scale_x, gdouble scale_y) {
+    g_return_if_fail(meta != NULL);
+
+    gst_zed_src_meta_reset_objects_soa(meta);
+
+    meta->info.grab_single_frame_width = scale_coord(meta->info.grab_single_frame_width, scale_x);
+    meta->info.grab_single_frame_height = scale_coord(meta->info.grab_single_frame_height, scale_y);
+
+    for (guint i = 0; i < meta->obj_count; i++) {
+        ZedObjectData &obj = meta->objects[i];
+
+        for (int c = 0; c < 4; c++) {
+            obj.bounding_box_2d[c][0] = scale_coord(obj.bounding_box_2d[c][0], scale_x);
+            obj.bounding_box_2d[c][1] = scale_coord(obj.bounding_box_2d[c][1], scale_y);
+            obj.head_bounding_box_2d[c][0] *= scale_x;
+            obj.head_bounding_box_2d[c][1] *= scale_y;
+        }
+
+        if (obj.skeletons_avail) {
+            for (int k = 0; k < 70; k++) {
+                if (obj.keypoint_2d[k][0] < 0 || obj.keypoint_2d[k][1] < 0) {
+                    continue;   // not valid
+                }
+                obj.keypoint_2d[k][0] *= scale_x;
+                obj.keypoint_2d[k][1] *= scale_y;
+            }
+        }
+    }
+}
+
+void gst_zed_src_meta_crop(GstZedSrcMeta *meta, guint x, guint y, guint width, guint height) {
+    g_return_if_fail(meta != NULL);
+
+    gst_zed_src_meta_reset_objects_soa(meta);
+
+    meta->info.grab_single_frame_width = width;
+    meta->info.grab_single_frame_height = height;
+
+    for (guint i = 0; i < meta->obj_count; i++) {
+        ZedObjectData &obj = meta->objects[i];
+
+        for (int c = 0; c < 4; c++) {
+            obj.bounding_box_2d[c][0] = crop_coord(obj.bounding_box_2d[c][0], x, width);
+            obj.bounding_box_2d[c][1] = crop_coord(obj.bounding_box_2d[c][1], y, height);
+            obj.head_bounding_box_2d[c][0] = CLAMP(obj.head_bounding_box_2d[c][0] - x, 0.0f, (gfloat) width);
+            obj.head_bounding_box_2d[c][1] = CLAMP(obj.head_bounding_box_2d[c][1] - y, 0.0f, (gfloat) height);
+        }
+
+        if (obj.skeletons_avail) {
+            for (int k = 0; k < 70; k++) {
+                gfloat kx = obj.keypoint_2d[k][0];
+                gfloat ky = obj.keypoint_2d[k][1];
+                if (kx < 0 || ky < 0) {
+                    continue;   // not valid
+                }
+                kx -= x;
+                ky -= y;
+                if (kx < 0 || ky < 0 || kx >= width || ky >= height) {
+                    kx = -1.0f;   // cropped out -> not valid
+                    ky = -1.0f;
+                }
+                obj.keypoint_2d[k][0] = kx;
+                obj.keypoint_2d[k][1] = ky;
+            }
+        }
+    }
+}
+
 static gboolean gst_zed_src_meta_transform(GstBuffer *transbuf, GstMeta *meta, GstBuffer *buffer, GQuark type, gpointer data) {
     GST_TRACE("gst_zed_src_meta_transform [%u]", type);
 
     GstZedSrcMeta *emeta = (GstZedSrcMeta *) meta;
 
-    // ----> Scale transformation
-    // TODO understand how `videoscale` filter handleds this part because there is something weird with
-    //      metadata tags handling
-    //    if( GST_VIDEO_META_TRANSFORM_IS_SCALE(type) )
-    //    {
-    //        if(emeta->od_enabled==TRUE && emeta->obj_count>0)
-    //        {
-    //            GstVideoMetaTransform* transf = (GstVideoMetaTransform*)data;
-    //            gint in_w = transf->in_info->width;
-    //            gint in_h = transf->in_info->height;
-    //            gint out_w = transf->out_info->width;
-    //            gint out_h = transf->out_info->height;
-
-    //            GST_DEBUG(  "Transform scale: [%dx%d] -> [%d,x%d]", in_w,in_h, out_w,out_h );
-    //        }
-    //    }
-    // <---- Scale transformation
-
-    if (GST_META_TRANSFORM_IS_COPY(type)) {
+    // ----> Scale parameters
+    // Validated before the meta is added, so that an invalid transformation never leaves an
+    // unscaled meta on the output buffer
+    gdouble scale_x = 1.0;
+    gdouble scale_y = 1.0;
+    if (GST_VIDEO_META_TRANSFORM_IS_SCALE(type)) {
+        GstVideoMetaTransform *transf = (GstVideoMetaTransform *) data;
+        gint in_w = GST_VIDEO_INFO_WIDTH(transf->in_info);
+        gint in_h = GST_VIDEO_INFO_HEIGHT(transf->in_info);
+        gint out_w = GST_VIDEO_INFO_WIDTH(transf->out_info);
+        gint out_h = GST_VIDEO_INFO_HEIGHT(transf->out_info);
+
+        GST_DEBUG("Transform scale: [%dx%d] -> [%dx%d]", in_w, in_h, out_w, out_h);
+
+        if (in_w <= 0 || in_h <= 0 || out_w <= 0 || out_h <= 0) {
+            GST_WARNING("Invalid video info for scale transformation");
+            return FALSE;
+        }
+
+        scale_x = (gdouble) out_w / in_w;
+        scale_y = (gdouble) out_h / in_h;
+    } else if (GST_META_TRANSFORM_IS_COPY(type)) {
         GST_DEBUG("Transform copy");
+    } else {
+        // Rotations, flips, crops...: the 2D coordinates cannot be transformed, the meta is
+        // dropped rather than attached with coordinates in the wrong reference
+        GST_DEBUG("Unsupported transform '%s', metadata dropped", g_quark_to_string(type));
+        return FALSE;
     }
+    // <---- Scale parameters
 
-    gst_buffer_add_zed_src_meta(transbuf, emeta->info, emeta->pose, emeta->sens, emeta->od_enabled, emeta->obj_count, emeta->objects, emeta->frame_id);
+    GstZedSrcMeta *out =
+        gst_buffer_add_zed_src_meta_full(transbuf, emeta->info, emeta->pose, emeta->sens, emeta->od_enabled, emeta->od_count, gst_zed_src_meta_od_objects(emeta),
+                                         emeta->bt_count, gst_zed_src_meta_bt_objects(emeta), emeta->frame_id);
+    if (!out) {
+        return FALSE;
+    }
+
+    // ----> Scale transformation
+    // Composite streams (left/right, left/depth) are scaled as a whole, so the same factors
+    // apply to the single frame the coordinates refer to
+    if (scale_x != 1.0 || scale_y != 1.0) {
+        gst_zed_src_meta_scale(out, scale_x, scale_y);
+    }
+    // <---- Scale transformation
 
     return TRUE;
 }
@@ -118,7 +227,193 @@ static void gst_zed_src_meta_free(GstMeta *meta, GstBuffer *buffer) {
     GST_TRACE("gst_zed_src_meta_free");
 
     GstZedSrcMeta *emeta = (GstZedSrcMeta *) meta;
+
+    g_free(emeta->objects_soa);
+    emeta->objects_soa = NULL;
+
+    g_free(emeta->objects);
+    emeta->objects = NULL;
+    emeta->obj_count = 0;
+    emeta->od_count = 0;
+    emeta->bt_count = 0;
+}
+
+// ----> Structure-of-arrays view
+// Number of arrays of GstZedObjectsSoA, all with 4 bytes values
+#define ZED_OBJECTS_SOA_ARRAYS 13
+
+static GstZedObjectsSoA *build_objects_soa(const GstZedSrcMeta *meta) {
+    const guint count = meta->obj_count;
+    const guint padded = GST_ROUND_UP_N(count, GST_ZED_OBJECTS_SOA_LANES);
+    const gsize array_bytes = GST_ROUND_UP_64(padded * sizeof(gfloat));
+
+    // A single zeroed block: the view itself, then the 64 bytes aligned arrays
+    guint8 *block = (guint8 *) g_malloc0(sizeof(GstZedObjectsSoA) + 63 + ZED_OBJECTS_SOA_ARRAYS * array_bytes);
+    GstZedObjectsSoA *soa = (GstZedObjectsSoA *) block;
+    guint8 *data = (guint8 *) GST_ROUND_UP_64((guintptr) (block + sizeof(GstZedObjectsSoA)));
+
+    soa->count = count;
+    soa->padded_count = padded;
+    soa->id = (gint *) data;
+    soa->label = (gint *) (data + array_bytes);
+    soa->confidence = (gfloat *) (data + 2 * array_bytes);
+    for (int c = 0; c < 3; c++) {
+        soa->position[c] = (gfloat *) (data + (3 + c) * array_bytes);
+        soa->velocity[c] = (gfloat *) (data + (6 + c) * array_bytes);
+    }
+    for (int c = 0; c < 4; c++) {
+        soa->bbox_2d[c] = (gfloat *) (data + (9 + c) * array_bytes);
+    }
+
+    for (guint i = 0; i < count; i++) {
+        const ZedObjectData &obj = meta->objects[i];
+
+        soa->id[i] = obj.id;
+        soa->label[i] = static_cast<gint>(obj.label);
+        soa->confidence[i] = obj.confidence;
+        for (int c = 0; c < 3; c++) {
+            soa->position[c][i] = obj.position[c];
+            soa->velocity[c][i] = obj.velocity[c];
+        }
+
+        // Corner 0 is the top left one, corner 2 the bottom right one
+        gfloat x0 = obj.bounding_box_2d[0][0];
+        gfloat y0 = obj.bounding_box_2d[0][1];
+        gfloat x1 = obj.bounding_box_2d[2][0];
+        gfloat y1 = obj.bounding_box_2d[2][1];
+        soa->bbox_2d[0][i] = x0;
+        soa->bbox_2d[1][i] = y0;
+        soa->bbox_2d[2][i] = x1 > x0 ? x1 - x0 : 0.0f;
+        soa->bbox_2d[3][i] = y1 > y0 ? y1 - y0 : 0.0f;
+    }
+
+    return soa;
+}
+
+// Buffers can be read by several threads (e.g. after a `tee`): the views are built and
+// released under this lock, so that each one is built once and never replaced while published
+G_LOCK_DEFINE_STATIC(objects_soa);
+
+const GstZedObjectsSoA *gst_zed_src_meta_get_objects_soa(GstZedSrcMeta *meta) {
+    g_return_val_if_fail(meta != NULL, NULL);
+
+    GstZedObjectsSoA *soa = (GstZedObjectsSoA *) g_atomic_pointer_get(&meta->objects_soa);
+    if (soa) {
+        return soa;
+    }
+
+    G_LOCK(objects_soa);
+    soa = meta->objects_soa;
+    if (!soa) {
+        soa = build_objects_soa(meta);
+        g_atomic_pointer_set(&meta->objects_soa, soa);
+    }
+    G_UNLOCK(objects_soa);
+
+    return soa;
+}
+
+void gst_zed_src_meta_reset_objects_soa(GstZedSrcMeta *meta) {
+    g_return_if_fail(meta != NULL);
+
+    G_LOCK(objects_soa);
+    gpointer soa = meta->objects_soa;
+    g_atomic_pointer_set(&meta->objects_soa, NULL);
+    G_UNLOCK(objects_soa);
+
+    g_free(soa);
+}
+// <---- Structure-of-arrays view
+
+#if GST_CHECK_VERSION(1, 24, 0)
+// ----> Serialization
+// Header of the serialized metadata (version 0), followed by the `od_count` Object Detection and
+// the `bt_count` Body Tracking ZedObjectData records.
+// The structures are stored with their native layout: their sizes are part of the header so that
+// a peer built with a different version of `gstzedmeta.h` is detected and the meta is dropped.
+struct ZedMetaSerialHeader {
+    guint32 info_size;
+    guint32 pose_size;
+    guint32 sens_size;
+    guint32 obj_size;
+    guint64 frame_id;
+    guint32 od_enabled;
+    guint32 od_count;
+    guint32 bt_count;
+    guint32 reserved;
+    ZedInfo info;
+    ZedPose pose;
+    ZedSensors sens;
+};
+
+#define ZED_META_SERIAL_VERSION 0
+
+static gboolean gst_zed_src_meta_serialize(const GstMeta *meta, GstByteArrayInterface *data, guint8 *version) {
+    GST_TRACE("gst_zed_src_meta_serialize");
+
+    const GstZedSrcMeta *emeta = (const GstZedSrcMeta *) meta;
+
+    ZedMetaSerialHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.info_size = sizeof(ZedInfo);
+    hdr.pose_size = sizeof(ZedPose);
+    hdr.sens_size = sizeof(ZedSensors);
+    hdr.obj_size = sizeof(ZedObjectData);
+    hdr.frame_id = emeta->frame_id;
+    hdr.od_enabled = emeta->od_enabled;
+    hdr.od_count = emeta->od_count;
+    hdr.bt_count = emeta->bt_count;
+    memcpy(&hdr.info, &emeta->info, sizeof(ZedInfo));
+    memcpy(&hdr.pose, &emeta->pose, sizeof(ZedPose));
+    memcpy(&hdr.sens, &emeta->sens, sizeof(ZedSensors));
+
+    gsize obj_bytes = (gsize) emeta->obj_count * sizeof(ZedObjectData);
+    guint8 *ptr = gst_byte_array_interface_append(data, sizeof(hdr) + obj_bytes);
+    if (!ptr) {
+        return FALSE;
+    }
+    memcpy(ptr, &hdr, sizeof(hdr));
+    memcpy(ptr + sizeof(hdr), emeta->objects, obj_bytes);
+
+    *version = ZED_META_SERIAL_VERSION;
+    return TRUE;
+}
+
+static GstMeta *gst_zed_src_meta_deserialize(const GstMetaInfo *info, GstBuffer *buffer, const guint8 *data, gsize size, guint8 version) {
+    GST_TRACE("gst_zed_src_meta_deserialize");
+
+    if (version != ZED_META_SERIAL_VERSION) {
+        GST_WARNING("Unsupported serialized GstZedSrcMeta version: %u", version);
+        return NULL;
+    }
+
+    ZedMetaSerialHeader hdr;
+    if (size < sizeof(hdr)) {
+        GST_WARNING("Serialized GstZedSrcMeta too small: %" G_GSIZE_FORMAT " bytes", size);
+        return NULL;
+    }
+    memcpy(&hdr, data, sizeof(hdr));
+
+    if (hdr.info_size != sizeof(ZedInfo) || hdr.pose_size != sizeof(ZedPose) || hdr.sens_size != sizeof(ZedSensors) ||
+        hdr.obj_size != sizeof(ZedObjectData)) {
+        GST_WARNING("Serialized GstZedSrcMeta layout does not match this version of the library");
+        return NULL;
+    }
+
+    guint64 obj_count = (guint64) hdr.od_count + hdr.bt_count;
+    if (obj_count > G_MAXUINT32 || size - sizeof(hdr) != obj_count * sizeof(ZedObjectData)) {
+        GST_WARNING("Invalid serialized GstZedSrcMeta object count: %u + %u", hdr.od_count, hdr.bt_count);
+        return NULL;
+    }
+
+    const ZedObjectData *objects = (const ZedObjectData *) (data + sizeof(hdr));
+    GstZedSrcMeta *meta = gst_buffer_add_zed_src_meta_full(buffer, hdr.info, hdr.pose, hdr.sens, hdr.od_enabled, hdr.od_count, objects, hdr.bt_count,
+                                                           objects + hdr.od_count, hdr.frame_id);
+
+    return (GstMeta *) meta;
 }
+// <---- Serialization
+#endif
 
 const GstMetaInfo *gst_zed_src_meta_get_info(void) {
     GST_TRACE("gst_zed_src_meta_get_info");
@@ -126,21 +421,33 @@ const GstMetaInfo *gst_zed_src_meta_get_info(void) {
     static const GstMetaInfo *meta_info = NULL;
 
     if (g_once_init_enter(&meta_info)) {
+#if GST_CHECK_VERSION(1, 24, 0)
+        // Serializable metadata can cross process boundaries (`unixfdsink`, `gdppay`, ...)
+        GstMetaInfo *info = gst_meta_info_new(GST_ZED_SRC_META_API_TYPE, "GstZedSrcMeta", sizeof(GstZedSrcMeta));
+        info->init_func = gst_zed_src_meta_init;
+        info->free_func = gst_zed_src_meta_free;
+        info->transform_func = gst_zed_src_meta_transform;
+        info->serialize_func = gst_zed_src_meta_serialize;
+        info->deserialize_func = gst_zed_src_meta_deserialize;
+        const GstMetaInfo *mi = gst_meta_info_register(info);
+#else
         const GstMetaInfo *mi = gst_meta_register(GST_ZED_SRC_META_API_TYPE, "GstZedSrcMeta", sizeof(GstZedSrcMeta), gst_zed_src_meta_init,
                                                   gst_zed_src_meta_free, gst_zed_src_meta_transform);
+#endif
         g_once_init_leave(&meta_info, mi);
     }
 
     return meta_info;
 }
 
-GstZedSrcMeta *gst_buffer_add_zed_src_meta(GstBuffer *buffer, ZedInfo &info, ZedPose &pose, ZedSensors &sens, gboolean od_enabled, guint8 obj_count,
-                                           ZedObjectData *objects, guint64 frame_id) {
-    GST_TRACE("gst_buffer_add_zed_src_meta");
+GstZedSrcMeta *gst_buffer_add_zed_src_meta_full(GstBuffer *buffer, ZedInfo &info, ZedPose &pose, ZedSensors &sens, gboolean od_enabled, guint32 od_count,
+                                                const ZedObjectData *od_objects, guint32 bt_count, const ZedObjectData *bt_objects, guint64 frame_id) {
+    GST_TRACE("gst_buffer_add_zed_src_meta_full");
     GST_DEBUG("Add GstZedSrcMeta");
 
     GstZedSrcMeta *meta;
     g_return_val_if_fail(GST_IS_BUFFER(buffer), NULL);
+    g_return_val_if_fail(od_count <= G_MAXUINT32 - bt_count, NULL);
 
     meta = (GstZedSrcMeta *) gst_buffer_add_meta(buffer, GST_ZED_SRC_META_INFO, NULL);
 
@@ -149,11 +456,98 @@ GstZedSrcMeta *gst_buffer_add_zed_src_meta(GstBuffer *buffer, ZedInfo &info, Zed
     memcpy(&meta->sens, &sens, sizeof(ZedSensors));
 
     meta->od_enabled = od_enabled;
-    meta->obj_count = obj_count;
-
-    memcpy(&meta->objects, objects, obj_count * sizeof(ZedObjectData));
+    meta->od_count = od_count;
+    meta->bt_count = bt_count;
+    meta->obj_count = od_count + bt_count;
+
+    // The objects array is sized on the actual number of detections
+    if (meta->obj_count > 0) {
+        meta->objects = g_new0(ZedObjectData, meta->obj_count);
+        if (od_objects && od_count > 0) {
+            memcpy(meta->objects, od_objects, od_count * sizeof(ZedObjectData));
+        }
+        if (bt_objects && bt_count > 0) {
+            memcpy(meta->objects + od_count, bt_objects, bt_count * sizeof(ZedObjectData));
+        }
+    }
 
     meta->frame_id = frame_id;
 
     return meta;
 }
+
+GstZedSrcMeta *gst_buffer_add_zed_src_meta(GstBuffer *buffer, ZedInfo &info, ZedPose &pose, ZedSensors &sens, gboolean od_enabled, guint32 obj_count,
+                                           const ZedObjectData *objects, guint64 frame_id) {
+    guint32 od_count = obj_count;
+    if (objects) {
+        od_count = 0;
+        while (od_count < obj_count && !objects[od_count].skeletons_avail) {
+            od_count++;
+        }
+    }
+
+    return gst_buffer_add_zed_src_meta_full(buffer, info, pose, sens, od_enabled, od_count, objects, obj_count - od_count,
+                                            objects ? objects + od_count : NULL, frame_id);
+}
+
+// ----> Data records
+gsize gst_zed_src_meta_record_size(const GstZedSrcMeta *meta) {
+    g_return_val_if_fail(meta != NULL, 0);
+
+    return sizeof(GstZedSrcMeta) + (gsize) meta->obj_count * sizeof(ZedObjectData);
+}
+
+gsize gst_zed_src_meta_write_record(const GstZedSrcMeta *meta, guint8 *data, gsize size) {
+    g_return_val_if_fail(meta != NULL && data != NULL, 0);
+
+    gsize rec_size = gst_zed_src_meta_record_size(meta);
+    if (size < rec_size) {
+        return 0;
+    }
+
+    memcpy(data, meta, sizeof(GstZedSrcMeta));
+    // The pointers are only meaningful in this process
+    GstZedSrcMeta *rec = (GstZedSrcMeta *) data;
+    rec->objects = NULL;
+    rec->objects_soa = NULL;
+
+    if (meta->obj_count > 0) {
+        memcpy(data + sizeof(GstZedSrcMeta), meta->objects, meta->obj_count * sizeof(ZedObjectData));
+    }
+
+    return rec_size;
+}
+
+gboolean gst_zed_src_meta_parse_record(const guint8 *data, gsize size, GstZedSrcMeta *meta) {
+    g_return_val_if_fail(data != NULL && meta != NULL, FALSE);
+
+    if (size < sizeof(GstZedSrcMeta)) {
+        GST_WARNING("GstZedSrcMeta record too small: %" G_GSIZE_FORMAT " bytes", size);
+        return FALSE;
+    }
+
+    memcpy(meta, data, sizeof(GstZedSrcMeta));
+    // Not attached to a buffer: a view is released by `gst_zed_src_meta_clear_parsed`
+    meta->objects_soa = NULL;
+
+    if ((guint64) meta->od_count + meta->bt_count != meta->obj_count || size != gst_zed_src_meta_record_size(meta)) {
+        GST_WARNING("Malformed GstZedSrcMeta record: %u objects in %" G_GSIZE_FORMAT " bytes", meta->obj_count, size);
+        meta->objects = NULL;
+        return FALSE;
+    }
+
+    meta->objects = meta->obj_count > 0 ? (ZedObjectData *) (data + sizeof(GstZedSrcMeta)) : NULL;
+
+    return TRUE;
+}
+
+void gst_zed_src_meta_clear_parsed(GstZedSrcMeta *meta) {
+    g_return_if_fail(meta != NULL);
+
+    gst_zed_src_meta_reset_objects_soa(meta);
+    meta->objects = NULL;
+    meta->obj_count = 0;
+    meta->od_count = 0;
+    meta->bt_count = 0;
+}
+// <---- Data records
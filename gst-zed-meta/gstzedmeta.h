@@ -36,6 +36,7 @@ typedef struct _ZedMag ZedMag;
 typedef struct _ZedEnv ZedEnv;
 typedef struct _ZedCamTemp ZedCamTemp;
 typedef struct _ZedObjectData ZedObjectData;
+typedef struct _GstZedObjectsSoA GstZedObjectsSoA;
 
 struct _ZedInfo {
     gint cam_model;
@@ -186,9 +187,43 @@ struct _GstZedSrcMeta {
     ZedSensors sens;
 
     gboolean od_enabled;
-    guint8 obj_count;
+    guint32 obj_count;   // od_count + bt_count
     guint64 frame_id;
-    ZedObjectData objects[256];
+
+    // `obj_count` detected objects, allocated with the metadata: the `od_count` results of the
+    // Object Detection module first, then the `bt_count` results of the Body Tracking module
+    ZedObjectData *objects;
+    guint32 od_count;
+    guint32 bt_count;
+
+    // Lazily built by `gst_zed_src_meta_get_objects_soa`, do not access directly
+    GstZedObjectsSoA *objects_soa;
+};
+
+static inline ZedObjectData *gst_zed_src_meta_od_objects(GstZedSrcMeta *meta) {
+    return meta->objects;
+}
+
+static inline ZedObjectData *gst_zed_src_meta_bt_objects(GstZedSrcMeta *meta) {
+    return meta->objects ? meta->objects + meta->od_count : NULL;
+}
+
+/* Structure-of-arrays view of the detected objects, for vectorized processing.
+ * Every array holds `count` valid values followed by zero padding up to `padded_count`
+ * (multiple of GST_ZED_OBJECTS_SOA_LANES), and starts on a 64 bytes boundary.
+ */
+#define GST_ZED_OBJECTS_SOA_LANES 16
+
+struct _GstZedObjectsSoA {
+    guint count;
+    guint padded_count;
+
+    gint *id;
+    gint *label;   // OBJECT_CLASS
+    gfloat *confidence;
+    gfloat *position[3];   // position[0][i] is the X coordinate of the object `i`
+    gfloat *velocity[3];
+    gfloat *bbox_2d[4];   // X, Y of the top left corner, width, height [pixels]
 };
 
 namespace skeleton {
@@ -567,9 +602,70 @@ GST_EXPORT
 const GstMetaInfo *gst_zed_src_meta_get_info(void);
 #define GST_ZED_SRC_META_INFO (gst_zed_src_meta_get_info())
 
+/* Add the metadata to the buffer, copying the Object Detection and the Body Tracking results */
+GST_EXPORT
+GstZedSrcMeta *gst_buffer_add_zed_src_meta_full(GstBuffer *buffer, ZedInfo &info, ZedPose &pose, ZedSensors &sens, gboolean od_enabled, guint32 od_count,
+                                                const ZedObjectData *od_objects, guint32 bt_count, const ZedObjectData *bt_objects, guint64 frame_id);
+
+/* Add the metadata to the buffer, copying `obj_count` objects. The leading objects without
+ * skeleton are the Object Detection results, the following ones the Body Tracking results.
+ */
+GST_EXPORT
+GstZedSrcMeta *gst_buffer_add_zed_src_meta(GstBuffer *buffer, ZedInfo &info, ZedPose &pose, ZedSensors &sens, gboolean od_enabled, guint32 obj_count,
+                                           const ZedObjectData *objects, guint64 frame_id);
+
+/* Flat data record of the metadata, as pushed by `zeddemux` on its data pad: the GstZedSrcMeta
+ * structure followed by its `obj_count` objects.
+ */
+GST_EXPORT
+gsize gst_zed_src_meta_record_size(const GstZedSrcMeta *meta);
+
+/* Write the record of `meta` into `data`, returns the number of bytes written or 0 if `size`
+ * is too small.
+ */
+GST_EXPORT
+gsize gst_zed_src_meta_write_record(const GstZedSrcMeta *meta, guint8 *data, gsize size);
+
+/* Parse a record: `meta` receives a copy of the structure with `objects` pointing inside `data`.
+ * The parsed metadata does not own its objects and must not outlive `data`.
+ * Returns FALSE if the record is truncated or malformed.
+ */
+GST_EXPORT
+gboolean gst_zed_src_meta_parse_record(const guint8 *data, gsize size, GstZedSrcMeta *meta);
+
+/* Release the structure-of-arrays view built on a metadata filled by
+ * `gst_zed_src_meta_parse_record`, which is not freed with a buffer.
+ */
+GST_EXPORT
+void gst_zed_src_meta_clear_parsed(GstZedSrcMeta *meta);
+
+/* Rescale the 2D coordinates of the detected objects (bounding boxes, head bounding boxes and
+ * valid skeleton keypoints) and the grab frame size. Called by the meta transform function when
+ * a scaler (`videoscale`, `nvvidconv`, ...) resizes the frame.
+ */
+GST_EXPORT
+void gst_zed_src_meta_scale(GstZedSrcMeta *meta, gdouble scale_x, gdouble scale_y);
+
+/* Move the 2D coordinates of the detected objects into the reference of the crop rectangle
+ * [x, y, width, height] of the single grab frame. Boxes are clamped to the rectangle and the
+ * keypoints falling outside of it are marked as not valid.
+ * GStreamer does not define a generic crop meta transform, elements cropping the frame
+ * must call this function on the metadata of the output buffer.
+ */
+GST_EXPORT
+void gst_zed_src_meta_crop(GstZedSrcMeta *meta, guint x, guint y, guint width, guint height);
+
+/* Return the structure-of-arrays view of the detected objects. The view is built once, on the
+ * first call from any thread, and owned by the metadata. It reflects the objects at the time of
+ * the first call: it is rebuilt by `gst_zed_src_meta_scale` and `gst_zed_src_meta_crop`, other
+ * modifications of `objects` require a call to `gst_zed_src_meta_reset_objects_soa`. As the
+ * objects themselves, the view must only be reset on metadata of writable buffers.
+ */
+GST_EXPORT
+const GstZedObjectsSoA *gst_zed_src_meta_get_objects_soa(GstZedSrcMeta *meta);
+
 GST_EXPORT
-GstZedSrcMeta *gst_buffer_add_zed_src_meta(GstBuffer *buffer, ZedInfo &info, ZedPose &pose, ZedSensors &sens, gboolean od_enabled, guint8 obj_count,
-                                           ZedObjectData *objects, guint64 frame_id);
+void gst_zed_src_meta_reset_objects_soa(GstZedSrcMeta *meta);
 
 G_END_DECLS
 
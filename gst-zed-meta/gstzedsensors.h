@@ -0,0 +1,57 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef __GST_ZED_SENSORS_H__
+#define __GST_ZED_SENSORS_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Buffers of the `sensors` pad of `zedsrc`: a packed array of GstZedSensorsSample, one per IMU
+ * sample, in acquisition order. The number of samples is the buffer size divided by
+ * sizeof(GstZedSensorsSample). The buffer PTS is the running time of the first sample and its
+ * duration spans up to the last one.
+ */
+#define GST_ZED_SENSORS_CAPS_NAME "application/x-zed-sensors"
+
+typedef enum {
+    GST_ZED_SENSORS_IMU = (1 << 0),    // acc/gyro hold a new IMU sample (always set)
+    GST_ZED_SENSORS_MAG = (1 << 1),    // mag holds a new magnetometer sample
+    GST_ZED_SENSORS_BARO = (1 << 2),   // pressure holds a new barometer sample
+} GstZedSensorsFlags;
+
+typedef struct {
+    guint64 timestamp;      // IMU timestamp of the ZED SDK (sl::Timestamp) [ns]
+    guint64 running_time;   // IMU timestamp in pipeline running time [ns]
+    gfloat acc[3];          // linear acceleration [m/s²]
+    gfloat gyro[3];         // angular velocity [deg/s]
+    gfloat mag[3];          // calibrated magnetic field [uT], last sample
+    gfloat pressure;        // atmospheric pressure [hPa], last sample
+    guint32 flags;          // GstZedSensorsFlags
+    guint32 reserved;
+} GstZedSensorsSample;
+
+G_STATIC_ASSERT(sizeof(GstZedSensorsSample) == 64);
+
+G_END_DECLS
+
+#endif /* __GST_ZED_SENSORS_H__ */
@@ -0,0 +1,130 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzedtimingmeta.h"
+
+#ifndef GST_DISABLE_GST_DEBUG
+#define GST_CAT_DEFAULT ensure_debug_category()
+static GstDebugCategory *ensure_debug_category(void) {
+    static gsize cat_gonce = 0;
+
+    if (g_once_init_enter(&cat_gonce)) {
+        gsize cat_done;
+
+        cat_done = (gsize) _gst_debug_category_new("zedtimingmeta", 0, "zedtimingmeta");
+
+        g_once_init_leave(&cat_gonce, cat_done);
+    }
+
+    return (GstDebugCategory *) cat_gonce;
+}
+#else
+#define ensure_debug_category() /* NOOP */
+#endif                          /* GST_DISABLE_GST_DEBUG */
+
+GType gst_zed_timing_meta_api_get_type() {
+    static GType type;
+
+    // No tags: the timing is not affected by any video transformation
+    static const gchar *tags[] = {NULL};
+
+    if (g_once_init_enter(&type)) {
+        GType _type = gst_meta_api_type_register("GstZedTimingMetaAPI", tags);
+
+        g_once_init_leave(&type, _type);
+    }
+
+    return type;
+}
+
+static gboolean gst_zed_timing_meta_init(GstMeta *meta, gpointer params, GstBuffer *buffer) {
+    GstZedTimingMeta *tmeta = (GstZedTimingMeta *) meta;
+
+    gst_zed_timing_reset(&tmeta->timing);
+    tmeta->timing.fill_start = GST_CLOCK_TIME_NONE;
+    return TRUE;
+}
+
+static gboolean gst_zed_timing_meta_transform(GstBuffer *transbuf, GstMeta *meta,
+                                              GstBuffer *buffer, GQuark type, gpointer data) {
+    GstZedTimingMeta *tmeta = (GstZedTimingMeta *) meta;
+
+    return gst_buffer_add_zed_timing_meta(transbuf, &tmeta->timing) != NULL;
+}
+
+static void gst_zed_timing_meta_free(GstMeta *meta, GstBuffer *buffer) {}
+
+const GstMetaInfo *gst_zed_timing_meta_get_info(void) {
+    static const GstMetaInfo *meta_info = NULL;
+
+    if (g_once_init_enter(&meta_info)) {
+        const GstMetaInfo *mi = gst_meta_register(
+            GST_ZED_TIMING_META_API_TYPE, "GstZedTimingMeta", sizeof(GstZedTimingMeta),
+            gst_zed_timing_meta_init, gst_zed_timing_meta_free, gst_zed_timing_meta_transform);
+        g_once_init_leave(&meta_info, mi);
+    }
+
+    return meta_info;
+}
+
+GstZedTimingMeta *gst_buffer_add_zed_timing_meta(GstBuffer *buffer, const ZedTiming *timing) {
+    g_return_val_if_fail(GST_IS_BUFFER(buffer), NULL);
+    g_return_val_if_fail(timing != NULL, NULL);
+
+    GstZedTimingMeta *meta =
+        (GstZedTimingMeta *) gst_buffer_add_meta(buffer, GST_ZED_TIMING_META_INFO, NULL);
+    if (meta) {
+        meta->timing = *timing;
+    }
+
+    return meta;
+}
+
+void gst_zed_timing_reset(ZedTiming *timing) {
+    g_return_if_fail(timing != NULL);
+
+    timing->frame_id = 0;
+    timing->camera_timestamp = GST_CLOCK_TIME_NONE;
+    timing->fill_start = gst_util_get_timestamp();
+    for (int s = 0; s < GST_ZED_TIMING_STAGE_COUNT; s++) {
+        timing->start[s] = GST_CLOCK_TIME_NONE;
+        timing->end[s] = GST_CLOCK_TIME_NONE;
+    }
+}
+
+const gchar *gst_zed_timing_stage_name(GstZedTimingStage stage) {
+    switch (stage) {
+    case GST_ZED_TIMING_GRAB:
+        return "grab";
+    case GST_ZED_TIMING_RETRIEVE:
+        return "retrieve";
+    case GST_ZED_TIMING_COPY:
+        return "copy";
+    case GST_ZED_TIMING_OBJECTS:
+        return "objects";
+    case GST_ZED_TIMING_BODIES:
+        return "bodies";
+    case GST_ZED_TIMING_METADATA:
+        return "metadata";
+    default:
+        return "unknown";
+    }
+}
@@ -0,0 +1,107 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef GSTZEDTIMINGMETA_H
+#define GSTZEDTIMINGMETA_H
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GstZedTimingMeta GstZedTimingMeta;
+typedef struct _ZedTiming ZedTiming;
+
+/* Processing stages of a ZED source element */
+typedef enum {
+    GST_ZED_TIMING_GRAB = 0,   // sl::Camera::grab
+    GST_ZED_TIMING_RETRIEVE,   // image and measure retrieval
+    GST_ZED_TIMING_COPY,       // copy of the data into the GstBuffer
+    GST_ZED_TIMING_OBJECTS,    // sl::Camera::retrieveObjects
+    GST_ZED_TIMING_BODIES,     // sl::Camera::retrieveBodies
+    GST_ZED_TIMING_METADATA,   // GstZedSrcMeta building, OBJECTS and BODIES included
+    GST_ZED_TIMING_STAGE_COUNT
+} GstZedTimingStage;
+
+struct _ZedTiming {
+    guint64 frame_id;                // same as GstZedSrcMeta::frame_id
+    GstClockTime camera_timestamp;   // image timestamp from the camera [ns]
+    GstClockTime fill_start;         // monotonic time of the beginning of the buffer production
+    // Monotonic time of the beginning and of the end of each stage [ns]
+    // GST_CLOCK_TIME_NONE if the stage was not executed
+    GstClockTime start[GST_ZED_TIMING_STAGE_COUNT];
+    GstClockTime end[GST_ZED_TIMING_STAGE_COUNT];
+};
+
+struct _GstZedTimingMeta {
+    GstMeta meta;
+
+    ZedTiming timing;
+};
+
+GST_EXPORT
+GType gst_zed_timing_meta_api_get_type(void);
+#define GST_ZED_TIMING_META_API_TYPE (gst_zed_timing_meta_api_get_type())
+
+#define gst_buffer_get_zed_timing_meta(b)                                                          \
+    ((GstZedTimingMeta *) gst_buffer_get_meta((b), GST_ZED_TIMING_META_API_TYPE))
+
+GST_EXPORT
+const GstMetaInfo *gst_zed_timing_meta_get_info(void);
+#define GST_ZED_TIMING_META_INFO (gst_zed_timing_meta_get_info())
+
+GST_EXPORT
+GstZedTimingMeta *gst_buffer_add_zed_timing_meta(GstBuffer *buffer, const ZedTiming *timing);
+
+/* Reset all the stages and set `fill_start` to the current monotonic time */
+GST_EXPORT
+void gst_zed_timing_reset(ZedTiming *timing);
+
+/* Stage markers, no-op if `timing` is NULL so that the instrumentation costs nothing
+ * when the timing metadata is disabled
+ */
+static inline void gst_zed_timing_begin(ZedTiming *timing, GstZedTimingStage stage) {
+    if (timing) {
+        timing->start[stage] = gst_util_get_timestamp();
+    }
+}
+
+static inline void gst_zed_timing_end(ZedTiming *timing, GstZedTimingStage stage) {
+    if (timing) {
+        timing->end[stage] = gst_util_get_timestamp();
+    }
+}
+
+/* Duration of a stage [ns], GST_CLOCK_TIME_NONE if the stage was not executed */
+static inline GstClockTime gst_zed_timing_duration(const ZedTiming *timing,
+                                                   GstZedTimingStage stage) {
+    if (!GST_CLOCK_TIME_IS_VALID(timing->start[stage]) ||
+        !GST_CLOCK_TIME_IS_VALID(timing->end[stage])) {
+        return GST_CLOCK_TIME_NONE;
+    }
+    return timing->end[stage] - timing->start[stage];
+}
+
+GST_EXPORT
+const gchar *gst_zed_timing_stage_name(GstZedTimingStage stage);
+
+G_END_DECLS
+
+#endif
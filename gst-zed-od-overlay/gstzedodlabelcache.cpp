@@ -0,0 +1,235 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzedodlabelcache.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define LABEL_FONT_FACE cv::FONT_HERSHEY_COMPLEX_SMALL
+#define LABEL_FONT_SCALE 0.75
+#define LABEL_OFFSET 5
+
+// Labels not used for this number of frames are evicted
+#define LABEL_MAX_AGE 30
+
+enum { LABEL_KIND_OBJECT, LABEL_KIND_DISTANCE };
+
+static const char *object_class_str(OBJECT_CLASS label) {
+    switch (label) {
+    case OBJECT_CLASS::PERSON:
+        return "PERSON";
+    case OBJECT_CLASS::VEHICLE:
+        return "VEHICLE";
+    case OBJECT_CLASS::ANIMAL:
+        return "ANIMAL";
+    case OBJECT_CLASS::BAG:
+        return "BAG";
+    case OBJECT_CLASS::ELECTRONICS:
+        return "ELECTRONICS";
+    case OBJECT_CLASS::FRUIT_VEGETABLE:
+        return "FRUIT_VEGETABLE";
+    case OBJECT_CLASS::LAST:
+    default:
+        return "UNDEFINED";
+    }
+}
+
+static const char *object_subclass_str(OBJECT_SUBCLASS sublabel) {
+    switch (sublabel) {
+    case OBJECT_SUBCLASS::PERSON:
+        return "";
+    case OBJECT_SUBCLASS::BICYCLE:
+        return " [Bicycle]";
+    case OBJECT_SUBCLASS::CAR:
+        return " [Car]";
+    case OBJECT_SUBCLASS::MOTORBIKE:
+        return " [Motorbike]";
+    case OBJECT_SUBCLASS::BUS:
+        return " [Bus]";
+    case OBJECT_SUBCLASS::TRUCK:
+        return " [Truck]";
+    case OBJECT_SUBCLASS::BOAT:
+        return " [Boat]";
+    case OBJECT_SUBCLASS::BACKPACK:
+        return " [Backpack]";
+    case OBJECT_SUBCLASS::HANDBAG:
+        return " [Handbag]";
+    case OBJECT_SUBCLASS::SUITCASE:
+        return " [Suitcase]";
+    case OBJECT_SUBCLASS::BIRD:
+        return " [Bird]";
+    case OBJECT_SUBCLASS::CAT:
+        return " [Cat]";
+    case OBJECT_SUBCLASS::DOG:
+        return " [Dog]";
+    case OBJECT_SUBCLASS::HORSE:
+        return " [Horse]";
+    case OBJECT_SUBCLASS::SHEEP:
+        return " [Sheep]";
+    case OBJECT_SUBCLASS::COW:
+        return " [Cow]";
+    case OBJECT_SUBCLASS::CELLPHONE:
+        return " [CellPhone]";
+    case OBJECT_SUBCLASS::LAPTOP:
+        return " [Laptop]";
+    case OBJECT_SUBCLASS::BANANA:
+        return " [Banana]";
+    case OBJECT_SUBCLASS::APPLE:
+        return " [Apple]";
+    case OBJECT_SUBCLASS::ORANGE:
+        return " [Orange]";
+    case OBJECT_SUBCLASS::CARROT:
+        return " [Carrot]";
+    default:
+        return " [-]";
+    }
+}
+
+GstZedOdLabelCache::GstZedOdLabelCache() : frame_(0), line_type_(cv::LINE_AA) {}
+
+guint32 GstZedOdLabelCache::pack_color(const cv::Scalar &color) {
+    return ((guint32) color[0] & 0xFF) | (((guint32) color[1] & 0xFF) << 8) |
+           (((guint32) color[2] & 0xFF) << 16);
+}
+
+const GstZedOdLabelCache::Sprite &GstZedOdLabelCache::object_label(const ZedObjectData &obj,
+                                                                   const cv::Scalar &color) {
+    Key key = {LABEL_KIND_OBJECT, obj.id, (gint) obj.label, (gint) obj.sublabel,
+               pack_color(color)};
+
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+        it->second.last_used = frame_;
+        return it->second;
+    }
+
+    // ----> Rasterize
+    char text[128];
+    snprintf(text, sizeof(text), "Id: %d - %s%s", obj.id, object_class_str(obj.label),
+             object_subclass_str(obj.sublabel));
+
+    int baseline = 0;
+    cv::Size txt_size = cv::getTextSize(text, LABEL_FONT_FACE, LABEL_FONT_SCALE, 1, &baseline);
+
+    Sprite &sprite = cache_[key];
+    sprite.alpha = cv::Mat::zeros(txt_size.height + 2 * LABEL_OFFSET + 1,
+                                  txt_size.width + 2 * LABEL_OFFSET + 1, CV_8UC1);
+    sprite.anchor = cv::Point(0, sprite.alpha.rows - 1);
+    sprite.color = color;
+    sprite.last_used = frame_;
+
+    cv::rectangle(sprite.alpha, cv::Point(0, 0),
+                  cv::Point(sprite.alpha.cols - 1, sprite.alpha.rows - 1), cv::Scalar(255), 1);
+    cv::putText(sprite.alpha, text, cv::Point(LABEL_OFFSET, sprite.alpha.rows - 1 - LABEL_OFFSET),
+                LABEL_FONT_FACE, LABEL_FONT_SCALE, cv::Scalar(255), 1, line_type_);
+    // <---- Rasterize
+
+    return sprite;
+}
+
+const GstZedOdLabelCache::Sprite &GstZedOdLabelCache::distance_label(gfloat distance_mm,
+                                                                     const cv::Scalar &color) {
+    // The label shows centimeters, so it only changes when the centimeter value changes
+    gint distance_cm = (gint) (fabsf(distance_mm) / 10.0f + 0.5f);
+    Key key = {LABEL_KIND_DISTANCE, 0, distance_cm, 0, pack_color(color)};
+
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+        it->second.last_used = frame_;
+        return it->second;
+    }
+
+    // ----> Rasterize
+    char text[64];
+    snprintf(text, sizeof(text), "%d.%02dm", distance_cm / 100, distance_cm % 100);
+
+    int baseline = 0;
+    cv::Size txt_size = cv::getTextSize(text, LABEL_FONT_FACE, LABEL_FONT_SCALE, 1, &baseline);
+
+    Sprite &sprite = cache_[key];
+    sprite.alpha = cv::Mat::zeros(txt_size.height + baseline + 1, txt_size.width + 1, CV_8UC1);
+    sprite.anchor = cv::Point(0, txt_size.height);
+    sprite.color = color;
+    sprite.last_used = frame_;
+
+    cv::putText(sprite.alpha, text, sprite.anchor, LABEL_FONT_FACE, LABEL_FONT_SCALE,
+                cv::Scalar(255), 1, line_type_);
+    // <---- Rasterize
+
+    return sprite;
+}
+
+cv::Rect GstZedOdLabelCache::blend(cv::Mat &image, const Sprite &sprite, cv::Point pos) {
+    cv::Rect dst_rect(pos.x - sprite.anchor.x, pos.y - sprite.anchor.y, sprite.alpha.cols,
+                      sprite.alpha.rows);
+    cv::Rect clipped = dst_rect & cv::Rect(0, 0, image.cols, image.rows);
+    if (clipped.empty()) {
+        return clipped;
+    }
+
+    const int cn = image.channels();
+    guint8 color[4];
+    for (int c = 0; c < 4; c++) {
+        color[c] = cv::saturate_cast<guint8>(sprite.color[c]);
+    }
+
+    for (int y = clipped.y; y < clipped.y + clipped.height; y++) {
+        const guint8 *a_row = sprite.alpha.ptr<guint8>(y - dst_rect.y) + (clipped.x - dst_rect.x);
+        guint8 *d_row = image.ptr<guint8>(y) + clipped.x * cn;
+
+        for (int x = 0; x < clipped.width; x++, d_row += cn) {
+            guint a = a_row[x];
+            if (a == 0) {
+                continue;
+            }
+            // The color is opaque, so this is also a valid "over" on a premultiplied layer
+            for (int c = 0; c < cn; c++) {
+                d_row[c] = (guint8) ((color[c] * a + d_row[c] * (255 - a) + 127) / 255);
+            }
+        }
+    }
+
+    return clipped;
+}
+
+void GstZedOdLabelCache::next_frame() {
+    frame_++;
+
+    for (auto it = cache_.begin(); it != cache_.end();) {
+        if (frame_ - it->second.last_used > LABEL_MAX_AGE) {
+            it = cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void GstZedOdLabelCache::clear() {
+    cache_.clear();
+}
+
+void GstZedOdLabelCache::set_line_type(int line_type) {
+    if (line_type != line_type_) {
+        line_type_ = line_type;
+        cache_.clear();
+    }
+}
@@ -0,0 +1,97 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef __GST_ZED_OD_LABEL_CACHE_H__
+#define __GST_ZED_OD_LABEL_CACHE_H__
+
+#include <gst-zed-meta/gstzedmeta.h>
+#include <opencv2/opencv.hpp>
+
+#include <unordered_map>
+
+// Cache of pre-rasterized overlay labels.
+//
+// Hershey text rendering with anti-aliasing is by far the most expensive
+// primitive used by the overlay. Each label is rasterized once into an
+// 8-bit coverage mask and then alpha-blended with its color on every frame
+// it is displayed. Entries not used for a while are evicted.
+class GstZedOdLabelCache {
+  public:
+    struct Sprite {
+        cv::Mat alpha;       // CV_8UC1 coverage mask
+        cv::Point anchor;    // position of the label origin inside the mask
+        cv::Scalar color;    // BGRA color, opaque
+        guint64 last_used;   // frame index of the last use
+    };
+
+    GstZedOdLabelCache();
+
+    // "Id: N - CLASS [Sub]" label framed by a rectangle. `anchor` is the bottom-left corner.
+    const Sprite &object_label(const ZedObjectData &obj, const cv::Scalar &color);
+    // "X.XXm" distance label. `anchor` is the text baseline origin.
+    const Sprite &distance_label(gfloat distance_mm, const cv::Scalar &color);
+
+    // Blend `sprite` into `image` (CV_8UC1 or CV_8UC4) with its anchor placed at `pos`.
+    // Return the area covered by the sprite.
+    static cv::Rect blend(cv::Mat &image, const Sprite &sprite, cv::Point pos);
+
+    // Mark the end of a frame and evict the labels that were not used recently
+    void next_frame();
+    void clear();
+
+    // cv::LINE_AA or cv::LINE_8. Changing it clears the cache.
+    void set_line_type(int line_type);
+
+    size_t size() const { return cache_.size(); }
+
+  private:
+    struct Key {
+        gint kind;
+        gint id;
+        gint value_a;
+        gint value_b;
+        guint32 color;
+
+        bool operator==(const Key &other) const {
+            return kind == other.kind && id == other.id && value_a == other.value_a &&
+                   value_b == other.value_b && color == other.color;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &k) const {
+            size_t h = (size_t) k.kind;
+            h = h * 31 + (size_t) k.id;
+            h = h * 31 + (size_t) k.value_a;
+            h = h * 31 + (size_t) k.value_b;
+            h = h * 31 + (size_t) k.color;
+            return h;
+        }
+    };
+
+    static guint32 pack_color(const cv::Scalar &color);
+
+    std::unordered_map<Key, Sprite, KeyHash> cache_;
+    guint64 frame_;
+    int line_type_;
+};
+
+#endif /* __GST_ZED_OD_LABEL_CACHE_H__ */
@@ -0,0 +1,311 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzedodlayer.h"
+
+#include <algorithm>
+#include <string.h>
+
+// x / 255 rounded, exact for 0 <= x <= 255 * 255
+static inline guint div255(guint x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Premultiplied "over" of `src` on `dst`, 4 bytes per pixel.
+// Branch free so that the compiler can vectorize it. The clamp absorbs the
+// rounding errors of the anti-aliased primitives drawn into the layer.
+static void blend_row_bgra(guint8 *__restrict dst, const guint8 *__restrict src, int width) {
+    for (int x = 0; x < width; x++) {
+        guint inv = 255 - src[4 * x + 3];
+        dst[4 * x + 0] = (guint8) std::min(src[4 * x + 0] + div255(dst[4 * x + 0] * inv), 255u);
+        dst[4 * x + 1] = (guint8) std::min(src[4 * x + 1] + div255(dst[4 * x + 1] * inv), 255u);
+        dst[4 * x + 2] = (guint8) std::min(src[4 * x + 2] + div255(dst[4 * x + 2] * inv), 255u);
+    }
+}
+
+// ----> BT.601 limited range on premultiplied BGRA
+// Conversion is linear, so it can be applied to premultiplied values: the
+// offsets are scaled by the pixel alpha.
+static inline guint premul_y(const guint8 *p) {
+    return (66 * p[2] + 129 * p[1] + 25 * p[0] + 16 * 256 * p[3] / 255 + 128) >> 8;
+}
+
+static inline gint premul_u(gint b, gint g, gint r, gint a) {
+    return (-38 * r - 74 * g + 112 * b + 128 * 256 * a / 255 + 128) >> 8;
+}
+
+static inline gint premul_v(gint b, gint g, gint r, gint a) {
+    return (112 * r - 94 * g - 18 * b + 128 * 256 * a / 255 + 128) >> 8;
+}
+// <---- BT.601 limited range on premultiplied BGRA
+
+GstZedOdLayer::GstZedOdLayer() : tiles_x_(0), tiles_y_(0), dirty_count_(0) {}
+
+void GstZedOdLayer::resize(int width, int height) {
+    layer_ = cv::Mat::zeros(height, width, CV_8UC4);
+
+    tiles_x_ = (width + GST_ZED_OD_LAYER_TILE_SIZE - 1) / GST_ZED_OD_LAYER_TILE_SIZE;
+    tiles_y_ = (height + GST_ZED_OD_LAYER_TILE_SIZE - 1) / GST_ZED_OD_LAYER_TILE_SIZE;
+    dirty_.assign(tiles_x_ * tiles_y_, 0);
+    dirty_count_ = 0;
+}
+
+cv::Rect GstZedOdLayer::tile_rect(int tx, int ty) const {
+    cv::Rect tile(tx * GST_ZED_OD_LAYER_TILE_SIZE, ty * GST_ZED_OD_LAYER_TILE_SIZE,
+                  GST_ZED_OD_LAYER_TILE_SIZE, GST_ZED_OD_LAYER_TILE_SIZE);
+    return tile & cv::Rect(0, 0, layer_.cols, layer_.rows);
+}
+
+void GstZedOdLayer::mark(const cv::Rect &rect) {
+    cv::Rect clipped = rect & cv::Rect(0, 0, layer_.cols, layer_.rows);
+    if (clipped.empty()) {
+        return;
+    }
+
+    int tx0 = clipped.x / GST_ZED_OD_LAYER_TILE_SIZE;
+    int ty0 = clipped.y / GST_ZED_OD_LAYER_TILE_SIZE;
+    int tx1 = (clipped.x + clipped.width - 1) / GST_ZED_OD_LAYER_TILE_SIZE;
+    int ty1 = (clipped.y + clipped.height - 1) / GST_ZED_OD_LAYER_TILE_SIZE;
+
+    for (int ty = ty0; ty <= ty1; ty++) {
+        for (int tx = tx0; tx <= tx1; tx++) {
+            guint8 &flag = dirty_[ty * tiles_x_ + tx];
+            if (!flag) {
+                flag = 1;
+                dirty_count_++;
+            }
+        }
+    }
+}
+
+gboolean GstZedOdLayer::blend(GstVideoFrame *frame, int y_begin, int y_end) const {
+    GstVideoFormat format = GST_VIDEO_FRAME_FORMAT(frame);
+
+    switch (format) {
+    case GST_VIDEO_FORMAT_BGRA:
+    case GST_VIDEO_FORMAT_BGRx:
+    case GST_VIDEO_FORMAT_NV12:
+    case GST_VIDEO_FORMAT_I420:
+    case GST_VIDEO_FORMAT_GRAY8:
+    case GST_VIDEO_FORMAT_GRAY16_LE:
+        break;
+    default:
+        return FALSE;
+    }
+
+    if (dirty_count_ == 0) {
+        return TRUE;
+    }
+
+    std::vector<cv::Rect> runs;
+    dirty_runs(runs);
+
+    cv::Rect frame_rect(0, 0, GST_VIDEO_FRAME_WIDTH(frame), GST_VIDEO_FRAME_HEIGHT(frame));
+    frame_rect &=
+        cv::Rect(0, y_begin, frame_rect.width, std::min(y_end, frame_rect.height) - y_begin);
+
+    for (const cv::Rect &dirty : runs) {
+        cv::Rect run = dirty & frame_rect;
+        if (run.empty()) {
+            continue;
+        }
+
+        guint8 *p0 = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA(frame, 0);
+        gint s0 = GST_VIDEO_FRAME_PLANE_STRIDE(frame, 0);
+
+        switch (format) {
+        case GST_VIDEO_FORMAT_BGRA:
+        case GST_VIDEO_FORMAT_BGRx:
+            for (int y = run.y; y < run.y + run.height; y++) {
+                blend_row_bgra(p0 + y * s0 + 4 * run.x, layer_.ptr<guint8>(y) + 4 * run.x,
+                               run.width);
+            }
+            break;
+        case GST_VIDEO_FORMAT_GRAY8:
+            blend_gray8(p0, s0, run);
+            break;
+        case GST_VIDEO_FORMAT_GRAY16_LE:
+            blend_gray16(p0, s0, run);
+            break;
+        case GST_VIDEO_FORMAT_NV12: {
+            guint8 *uv = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA(frame, 1);
+            gint s1 = GST_VIDEO_FRAME_PLANE_STRIDE(frame, 1);
+            blend_gray8(p0, s0, run);
+            blend_chroma(uv, s1, uv + 1, s1, 2, run);
+            break;
+        }
+        case GST_VIDEO_FORMAT_I420:
+            blend_gray8(p0, s0, run);
+            blend_chroma((guint8 *) GST_VIDEO_FRAME_PLANE_DATA(frame, 1),
+                         GST_VIDEO_FRAME_PLANE_STRIDE(frame, 1),
+                         (guint8 *) GST_VIDEO_FRAME_PLANE_DATA(frame, 2),
+                         GST_VIDEO_FRAME_PLANE_STRIDE(frame, 2), 1, run);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return TRUE;
+}
+
+void GstZedOdLayer::blend_gray8(guint8 *data, gint stride, const cv::Rect &run) const {
+    for (int y = run.y; y < run.y + run.height; y++) {
+        const guint8 *src = layer_.ptr<guint8>(y) + 4 * run.x;
+        guint8 *dst = data + y * stride + run.x;
+        for (int x = 0; x < run.width; x++, src += 4) {
+            guint inv = 255 - src[3];
+            dst[x] = (guint8) std::min(premul_y(src) + div255(dst[x] * inv), 255u);
+        }
+    }
+}
+
+void GstZedOdLayer::blend_gray16(guint8 *data, gint stride, const cv::Rect &run) const {
+    for (int y = run.y; y < run.y + run.height; y++) {
+        const guint8 *src = layer_.ptr<guint8>(y) + 4 * run.x;
+        guint16 *dst = (guint16 *) (data + y * stride) + run.x;
+        for (int x = 0; x < run.width; x++, src += 4) {
+            guint inv = 255 - src[3];
+            guint val = premul_y(src) * 257 + (dst[x] * inv + 127) / 255;
+            dst[x] = (guint16) std::min(val, 65535u);
+        }
+    }
+}
+
+void GstZedOdLayer::blend_chroma(guint8 *u, gint u_stride, guint8 *v, gint v_stride,
+                                 gint pixel_stride, const cv::Rect &run) const {
+    // 4:2:0 subsampling: each chroma sample covers a 2x2 block of the layer.
+    // Tiles are even aligned, only the last row/column of an odd image is partial.
+    int cy0 = run.y / 2;
+    int cy1 = (run.y + run.height + 1) / 2;
+    int cx0 = run.x / 2;
+    int cx1 = (run.x + run.width + 1) / 2;
+
+    for (int cy = cy0; cy < cy1; cy++) {
+        const guint8 *row0 = layer_.ptr<guint8>(2 * cy);
+        const guint8 *row1 = layer_.ptr<guint8>(std::min(2 * cy + 1, layer_.rows - 1));
+        guint8 *u_row = u + cy * u_stride;
+        guint8 *v_row = v + cy * v_stride;
+
+        for (int cx = cx0; cx < cx1; cx++) {
+            int x0 = 4 * (2 * cx);
+            int x1 = 4 * std::min(2 * cx + 1, layer_.cols - 1);
+
+            gint a = row0[x0 + 3] + row0[x1 + 3] + row1[x0 + 3] + row1[x1 + 3];
+            if (a == 0) {
+                continue;
+            }
+            gint b = row0[x0 + 0] + row0[x1 + 0] + row1[x0 + 0] + row1[x1 + 0];
+            gint g = row0[x0 + 1] + row0[x1 + 1] + row1[x0 + 1] + row1[x1 + 1];
+            gint r = row0[x0 + 2] + row0[x1 + 2] + row1[x0 + 2] + row1[x1 + 2];
+
+            // Average of the 4 samples
+            a = (a + 2) >> 2;
+            b = (b + 2) >> 2;
+            g = (g + 2) >> 2;
+            r = (r + 2) >> 2;
+
+            guint inv = 255 - a;
+            guint8 &du = u_row[cx * pixel_stride];
+            guint8 &dv = v_row[cx * pixel_stride];
+            du = (guint8) CLAMP(premul_u(b, g, r, a) + (gint) div255(du * inv), 0, 255);
+            dv = (guint8) CLAMP(premul_v(b, g, r, a) + (gint) div255(dv * inv), 0, 255);
+        }
+    }
+}
+
+void GstZedOdLayer::dirty_runs(std::vector<cv::Rect> &runs) const {
+    runs.clear();
+
+    for (int ty = 0; ty < tiles_y_; ty++) {
+        int tx = 0;
+        while (tx < tiles_x_) {
+            if (!dirty_[ty * tiles_x_ + tx]) {
+                tx++;
+                continue;
+            }
+            int start = tx;
+            while (tx < tiles_x_ && dirty_[ty * tiles_x_ + tx]) {
+                tx++;
+            }
+            runs.push_back(tile_rect(start, ty) | tile_rect(tx - 1, ty));
+        }
+    }
+}
+
+GstVideoOverlayComposition *GstZedOdLayer::composition() const {
+    if (dirty_count_ == 0) {
+        return NULL;
+    }
+
+    std::vector<cv::Rect> runs;
+    dirty_runs(runs);
+
+    GstVideoOverlayComposition *comp = NULL;
+
+    for (const cv::Rect &run : runs) {
+        gsize stride = run.width * 4;
+        GstBuffer *pixels = gst_buffer_new_allocate(NULL, stride * run.height, NULL);
+
+        GstMapInfo map;
+        gst_buffer_map(pixels, &map, GST_MAP_WRITE);
+        for (int y = 0; y < run.height; y++) {
+            memcpy(map.data + y * stride, layer_.ptr<guint8>(run.y + y) + 4 * run.x, stride);
+        }
+        gst_buffer_unmap(pixels, &map);
+
+        // The layer is BGRA in memory, i.e. the composition ARGB native format on little endian
+        gst_buffer_add_video_meta(pixels, GST_VIDEO_FRAME_FLAG_NONE,
+                                  GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, run.width, run.height);
+
+        GstVideoOverlayRectangle *rect = gst_video_overlay_rectangle_new_raw(
+            pixels, run.x, run.y, run.width, run.height,
+            GST_VIDEO_OVERLAY_FORMAT_FLAG_PREMULTIPLIED_ALPHA);
+        gst_buffer_unref(pixels);
+
+        if (comp == NULL) {
+            comp = gst_video_overlay_composition_new(rect);
+        } else {
+            gst_video_overlay_composition_add_rectangle(comp, rect);
+        }
+        gst_video_overlay_rectangle_unref(rect);
+    }
+
+    return comp;
+}
+
+void GstZedOdLayer::clear() {
+    if (dirty_count_ == 0) {
+        return;
+    }
+
+    for (int ty = 0; ty < tiles_y_; ty++) {
+        for (int tx = 0; tx < tiles_x_; tx++) {
+            if (dirty_[ty * tiles_x_ + tx]) {
+                layer_(tile_rect(tx, ty)).setTo(cv::Scalar::all(0));
+            }
+        }
+    }
+
+    std::fill(dirty_.begin(), dirty_.end(), 0);
+    dirty_count_ = 0;
+}
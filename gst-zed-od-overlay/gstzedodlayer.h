@@ -0,0 +1,87 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef __GST_ZED_OD_LAYER_H__
+#define __GST_ZED_OD_LAYER_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <opencv2/opencv.hpp>
+
+#include <vector>
+
+#define GST_ZED_OD_LAYER_TILE_SIZE 64
+
+// Sparse overlay layer.
+//
+// The annotations are drawn into a premultiplied BGRA layer with the size of
+// the image. The layer is split in square tiles and only the tiles covered
+// by an annotation are marked as dirty, so that blending and clearing scale
+// with the annotated area instead of with the frame size.
+class GstZedOdLayer {
+  public:
+    GstZedOdLayer();
+
+    // Reallocate the layer for a new image size. The layer is fully cleared.
+    void resize(int width, int height);
+
+    cv::Mat &image() { return layer_; }
+    int width() const { return layer_.cols; }
+    int height() const { return layer_.rows; }
+
+    // Mark the tiles covered by `rect` as dirty
+    void mark(const cv::Rect &rect);
+    bool is_dirty() const { return dirty_count_ > 0; }
+
+    // Blend the dirty tiles into a mapped frame. Supported formats are BGRA, BGRx,
+    // NV12, I420, GRAY8 and GRAY16_LE; YUV and gray values are computed only for
+    // the covered pixels (BT.601 limited range). Frame alpha (if any) is left
+    // untouched. Only the rows in [`y_begin`, `y_end`) are processed: they must be tile
+    // aligned, so that disjoint ranges can be blended concurrently.
+    // Return FALSE for other formats.
+    gboolean blend(GstVideoFrame *frame, int y_begin = 0, int y_end = G_MAXINT) const;
+
+    // Horizontal runs of dirty tiles, clipped to the layer size
+    void dirty_runs(std::vector<cv::Rect> &runs) const;
+
+    // Build an overlay composition with one rectangle per dirty run.
+    // Return NULL if there is nothing to draw.
+    GstVideoOverlayComposition *composition() const;
+
+    // Clear the dirty tiles and reset the dirty flags
+    void clear();
+
+  private:
+    cv::Rect tile_rect(int tx, int ty) const;
+
+    void blend_gray8(guint8 *data, gint stride, const cv::Rect &run) const;
+    void blend_gray16(guint8 *data, gint stride, const cv::Rect &run) const;
+    void blend_chroma(guint8 *u, gint u_stride, guint8 *v, gint v_stride, gint pixel_stride,
+                      const cv::Rect &run) const;
+
+    cv::Mat layer_;   // CV_8UC4, premultiplied alpha
+    int tiles_x_;
+    int tiles_y_;
+    std::vector<guint8> dirty_;
+    int dirty_count_;
+};
+
+#endif /* __GST_ZED_OD_LAYER_H__ */
@@ -27,13 +27,20 @@
 #include <gst/gst.h>
 #include <gst/video/video.h>
 
+#include "gstzedodlabelcache.h"
+#include "gstzedodlayer.h"
 #include "gstzedodoverlay.h"
 
 GST_DEBUG_CATEGORY_STATIC(gst_zed_od_overlay_debug);
 #define GST_CAT_DEFAULT gst_zed_od_overlay_debug
 
-static void draw_objects(GstZedOdOverlay *filter, cv::Mat &image, guint8 obj_count,
-                         ZedObjectData *objs, gfloat scaleW, gfloat scaleH);
+typedef enum { GST_ZED_OD_TASK_RASTERIZE, GST_ZED_OD_TASK_BLEND } GstZedOdTaskType;
+
+static void prepare_objects(GstZedOdOverlay *filter, guint32 obj_count, ZedObjectData *objs,
+                            gfloat scaleW, gfloat scaleH);
+static void ensure_render_pool(GstZedOdOverlay *filter);
+static gboolean run_bands(GstZedOdOverlay *filter, GstZedOdTaskType type, gfloat scaleW,
+                          gfloat scaleH, GstVideoFrame *frame);
 gboolean gst_zedoddisplaysink_event(GstBaseTransform *base, GstEvent *event);
 
 /* Filter signals and args */
@@ -42,78 +49,109 @@ enum {
     LAST_SIGNAL
 };
 
-enum { PROP_0 };
+enum {
+    PROP_0,
+    PROP_OVERLAY_MODE,
+    PROP_ALLOW_MISSING_META,
+    PROP_RENDER_THREADS,
+    PROP_ANTI_ALIASING
+};
+
+#define DEFAULT_PROP_OVERLAY_MODE GST_ZED_OD_OVERLAY_MODE_BLEND
+#define DEFAULT_PROP_ALLOW_MISSING_META FALSE
+#define DEFAULT_PROP_RENDER_THREADS 1
+#define DEFAULT_PROP_ANTI_ALIASING TRUE
+
+#define GST_TYPE_ZED_OD_OVERLAY_MODE (gst_zed_od_overlay_mode_get_type())
+static GType gst_zed_od_overlay_mode_get_type(void) {
+    static GType zed_od_overlay_mode_type = 0;
+
+    if (!zed_od_overlay_mode_type) {
+        static GEnumValue pattern_types[] = {
+            {GST_ZED_OD_OVERLAY_MODE_BLEND, "Blend the annotations into the video frames",
+             "BLEND"},
+            {GST_ZED_OD_OVERLAY_MODE_COMPOSITION_META,
+             "Attach the annotations as GstVideoOverlayCompositionMeta, frames are not modified",
+             "COMPOSITION_META"},
+            {0, NULL, NULL},
+        };
+
+        zed_od_overlay_mode_type = g_enum_register_static("GstZedOdOverlayMode", pattern_types);
+    }
+
+    return zed_od_overlay_mode_type;
+}
 
 static GstStaticPadTemplate sink_template =
     GST_STATIC_PAD_TEMPLATE("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
                             GST_STATIC_CAPS(("video/x-raw, "   // Double stream VGA
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)672, "
                                              "height = (int)752 , "
                                              "framerate = (fraction) { 15, 30, 60, 100 }"
                                              ";"
                                              "video/x-raw, "   // Double stream HD720
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1280, "
                                              "height = (int)1440, "
                                              "framerate = (fraction) { 15, 30, 60 }"
                                              ";"
                                              "video/x-raw, "   // Double stream HD1080
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1920, "
                                              "height = (int)2160, "
                                              "framerate = (fraction) { 15, 30, 60 }"
                                              ";"
                                              "video/x-raw, "   // Double stream HD2K
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)2208, "
                                              "height = (int)2484, "
                                              "framerate = (fraction)15"
                                              ";"
                                              "video/x-raw, "   // Double stream HD1200 (GMSL2)
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1920, "
                                              "height = (int)2400, "
                                              "framerate = (fraction) { 15, 30, 60 }"
                                              ";"
                                              "video/x-raw, "   // Double stream SVGA (GMSL2)
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)960, "
                                              "height = (int)1200, "
                                              "framerate = (fraction) { 15, 30, 60, 120 }"
                                              ";"
                                              "video/x-raw, "   // Color VGA
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)672, "
                                              "height =  (int)376, "
                                              "framerate = (fraction) { 15, 30, 60, 100 }"
                                              ";"
                                              "video/x-raw, "   // Color HD720
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1280, "
                                              "height =  (int)720, "
                                              "framerate =  (fraction)  { 15, 30, 60}"
                                              ";"
                                              "video/x-raw, "   // Color HD1080
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1920, "
                                              "height = (int)1080, "
                                              "framerate = (fraction) { 15, 30, 60 }"
                                              ";"
                                              "video/x-raw, "   // Color HD2K
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)2208, "
                                              "height = (int)1242, "
                                              "framerate = (fraction)15"
                                              ";"
                                              "video/x-raw, "   // Color HD1200 (GMSL2)
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1920, "
                                              "height = (int)1200, "
                                              "framerate = (fraction) { 15, 30, 60 }"
                                              ";"
                                              "video/x-raw, "   // Color SVGA (GMSL2)
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)960, "
                                              "height = (int)600, "
                                              "framerate = (fraction) { 15, 30, 60, 120 }"
@@ -157,73 +195,73 @@ static GstStaticPadTemplate sink_template =
 static GstStaticPadTemplate src_template =
     GST_STATIC_PAD_TEMPLATE("src", GST_PAD_SRC, GST_PAD_ALWAYS,
                             GST_STATIC_CAPS(("video/x-raw, "   // Double stream VGA
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)672, "
                                              "height = (int)752 , "
                                              "framerate = (fraction) { 15, 30, 60, 100 }"
                                              ";"
                                              "video/x-raw, "   // Double stream HD720
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1280, "
                                              "height = (int)1440, "
                                              "framerate = (fraction) { 15, 30, 60 }"
                                              ";"
                                              "video/x-raw, "   // Double stream HD1080
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1920, "
                                              "height = (int)2160, "
                                              "framerate = (fraction) { 15, 30, 60 }"
                                              ";"
                                              "video/x-raw, "   // Double stream HD2K
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)2208, "
                                              "height = (int)2484, "
                                              "framerate = (fraction)15"
                                              ";"
                                              "video/x-raw, "   // Double stream HD1200 (GMSL2)
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1920, "
                                              "height = (int)2400, "
                                              "framerate = (fraction) { 15, 30, 60 }"
                                              ";"
                                              "video/x-raw, "   // Double stream SVGA (GMSL2)
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)960, "
                                              "height = (int)1200, "
                                              "framerate = (fraction) { 15, 30, 60, 120 }"
                                              ";"
                                              "video/x-raw, "   // Color VGA
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)672, "
                                              "height =  (int)376, "
                                              "framerate = (fraction) { 15, 30, 60, 100 }"
                                              ";"
                                              "video/x-raw, "   // Color HD720
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1280, "
                                              "height =  (int)720, "
                                              "framerate =  (fraction)  { 15, 30, 60}"
                                              ";"
                                              "video/x-raw, "   // Color HD1080
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1920, "
                                              "height = (int)1080, "
                                              "framerate = (fraction) { 15, 30, 60 }"
                                              ";"
                                              "video/x-raw, "   // Color HD2K
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)2208, "
                                              "height = (int)1242, "
                                              "framerate = (fraction)15"
                                              ";"
                                              "video/x-raw, "   // Color HD1200 (GMSL2)
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)1920, "
                                              "height = (int)1200, "
                                              "framerate = (fraction) { 15, 30, 60 }"
                                              ";"
                                              "video/x-raw, "   // Color SVGA (GMSL2)
-                                             "format = (string)BGRA, "
+                                             "format = (string){ BGRA, BGRx, NV12, I420, GRAY8 }, "
                                              "width = (int)960, "
                                              "height = (int)600, "
                                              "framerate = (fraction) { 15, 30, 60, 120 }"
@@ -272,6 +310,9 @@ static void gst_zed_od_overlay_set_property(GObject *object, guint prop_id, cons
 static void gst_zed_od_overlay_get_property(GObject *object, guint prop_id, GValue *value,
                                             GParamSpec *pspec);
 
+static void gst_zed_od_overlay_finalize(GObject *object);
+
+static void gst_zed_od_overlay_before_transform(GstBaseTransform *base, GstBuffer *buffer);
 static GstFlowReturn gst_zed_od_overlay_transform_ip(GstBaseTransform *base, GstBuffer *outbuf);
 
 /* GObject vmethod implementations */
@@ -286,6 +327,38 @@ static void gst_zed_od_overlay_class_init(GstZedOdOverlayClass *klass) {
 
     gobject_class->set_property = gst_zed_od_overlay_set_property;
     gobject_class->get_property = gst_zed_od_overlay_get_property;
+    gobject_class->finalize = gst_zed_od_overlay_finalize;
+
+    g_object_class_install_property(
+        gobject_class, PROP_OVERLAY_MODE,
+        g_param_spec_enum("overlay-mode", "Overlay mode",
+                          "How the annotations are applied to the video frames",
+                          GST_TYPE_ZED_OD_OVERLAY_MODE, DEFAULT_PROP_OVERLAY_MODE,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_ALLOW_MISSING_META,
+        g_param_spec_boolean("allow-missing-meta", "Allow missing metadata",
+                             "Forward buffers without ZED metadata unchanged instead of "
+                             "raising an error",
+                             DEFAULT_PROP_ALLOW_MISSING_META,
+                             (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_RENDER_THREADS,
+        g_param_spec_uint("render-threads", "Rendering threads",
+                          "Number of threads rasterizing and blending the annotations, each one "
+                          "processing a horizontal band of the image",
+                          1, 64, DEFAULT_PROP_RENDER_THREADS,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_ANTI_ALIASING,
+        g_param_spec_boolean("anti-aliasing", "Anti-aliasing",
+                             "Draw anti-aliased skeletons and labels. Disable it for a faster "
+                             "rendering of dense scenes",
+                             DEFAULT_PROP_ANTI_ALIASING,
+                             (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
     gst_element_class_set_details_simple(gstelement_class, "ZedOdOverlay", "Generic/Filter",
                                          "Draws the results of ZED Object Detection module",
@@ -296,6 +369,8 @@ static void gst_zed_od_overlay_class_init(GstZedOdOverlayClass *klass) {
     gst_element_class_add_pad_template(gstelement_class,
                                        gst_static_pad_template_get(&sink_template));
 
+    GST_BASE_TRANSFORM_CLASS(klass)->before_transform =
+        GST_DEBUG_FUNCPTR(gst_zed_od_overlay_before_transform);
     GST_BASE_TRANSFORM_CLASS(klass)->transform_ip =
         GST_DEBUG_FUNCPTR(gst_zed_od_overlay_transform_ip);
 
@@ -312,6 +387,44 @@ static void gst_zed_od_overlay_class_init(GstZedOdOverlayClass *klass) {
 static void gst_zed_od_overlay_init(GstZedOdOverlay *filter) {
     filter->img_left_w = 0;
     filter->img_left_h = 0;
+    gst_video_info_init(&filter->vinfo);
+
+    filter->label_cache = new GstZedOdLabelCache();
+    filter->layer = new GstZedOdLayer();
+    filter->items = new std::vector<GstZedOdItem>();
+
+    filter->render_pool = NULL;
+    filter->render_pool_size = 0;
+    filter->render_pending = 0;
+    g_mutex_init(&filter->render_lock);
+    g_cond_init(&filter->render_cond);
+
+    filter->overlay_mode = DEFAULT_PROP_OVERLAY_MODE;
+    filter->allow_missing_meta = DEFAULT_PROP_ALLOW_MISSING_META;
+    filter->render_threads = DEFAULT_PROP_RENDER_THREADS;
+    filter->anti_aliasing = DEFAULT_PROP_ANTI_ALIASING;
+
+    filter->skel_format_warned = FALSE;
+}
+
+static void gst_zed_od_overlay_finalize(GObject *object) {
+    GstZedOdOverlay *filter = GST_ZED_OD_OVERLAY(object);
+
+    if (filter->render_pool) {
+        g_thread_pool_free(filter->render_pool, FALSE, TRUE);
+        filter->render_pool = NULL;
+    }
+    g_mutex_clear(&filter->render_lock);
+    g_cond_clear(&filter->render_cond);
+
+    delete filter->items;
+    filter->items = NULL;
+    delete filter->label_cache;
+    filter->label_cache = NULL;
+    delete filter->layer;
+    filter->layer = NULL;
+
+    G_OBJECT_CLASS(parent_class)->finalize(object);
 }
 
 static void gst_zed_od_overlay_set_property(GObject *object, guint prop_id, const GValue *value,
@@ -319,6 +432,18 @@ static void gst_zed_od_overlay_set_property(GObject *object, guint prop_id, cons
     GstZedOdOverlay *filter = GST_ZED_OD_OVERLAY(object);
 
     switch (prop_id) {
+    case PROP_OVERLAY_MODE:
+        filter->overlay_mode = (GstZedOdOverlayMode) g_value_get_enum(value);
+        break;
+    case PROP_ALLOW_MISSING_META:
+        filter->allow_missing_meta = g_value_get_boolean(value);
+        break;
+    case PROP_RENDER_THREADS:
+        filter->render_threads = g_value_get_uint(value);
+        break;
+    case PROP_ANTI_ALIASING:
+        filter->anti_aliasing = g_value_get_boolean(value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -330,6 +455,18 @@ static void gst_zed_od_overlay_get_property(GObject *object, guint prop_id, GVal
     GstZedOdOverlay *filter = GST_ZED_OD_OVERLAY(object);
 
     switch (prop_id) {
+    case PROP_OVERLAY_MODE:
+        g_value_set_enum(value, filter->overlay_mode);
+        break;
+    case PROP_ALLOW_MISSING_META:
+        g_value_set_boolean(value, filter->allow_missing_meta);
+        break;
+    case PROP_RENDER_THREADS:
+        g_value_set_uint(value, filter->render_threads);
+        break;
+    case PROP_ANTI_ALIASING:
+        g_value_set_boolean(value, filter->anti_aliasing);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -346,6 +483,9 @@ gboolean gst_zedoddisplaysink_event(GstBaseTransform *base, GstEvent *event) {
     GST_TRACE_OBJECT(filter, "Event %d [%d]", type, GST_EVENT_CAPS);
 
     switch (type) {
+    case GST_EVENT_STREAM_START:
+        filter->skel_format_warned = FALSE;
+        break;
     case GST_EVENT_EOS:
         break;
     case GST_EVENT_CAPS: {
@@ -356,6 +496,7 @@ gboolean gst_zedoddisplaysink_event(GstBaseTransform *base, GstEvent *event) {
 
         GstVideoInfo vinfo_in;
         gst_video_info_from_caps(&vinfo_in, caps);
+        filter->vinfo = vinfo_in;
         filter->img_left_w = vinfo_in.width;
         filter->img_left_h = vinfo_in.height;
         if (vinfo_in.height == 752 || vinfo_in.height == 1440 || vinfo_in.height == 2160 ||
@@ -363,6 +504,8 @@ gboolean gst_zedoddisplaysink_event(GstBaseTransform *base, GstEvent *event) {
             filter->img_left_h /= 2;   // Only half buffer size if the stream is composite
         }
 
+        filter->layer->resize(filter->img_left_w, filter->img_left_h);
+
         break;
     }
     default:
@@ -372,59 +515,118 @@ gboolean gst_zedoddisplaysink_event(GstBaseTransform *base, GstEvent *event) {
     return GST_BASE_TRANSFORM_CLASS(parent_class)->sink_event(base, event);
 }
 
+/* Called before the output buffer is prepared: when there is nothing to draw the
+ * element switches to passthrough, so the buffer is neither made writable nor mapped.
+ */
+static void gst_zed_od_overlay_before_transform(GstBaseTransform *base, GstBuffer *buffer) {
+    GstZedOdOverlay *filter = GST_ZED_OD_OVERLAY(base);
+
+    GstZedSrcMeta *meta = (GstZedSrcMeta *) gst_buffer_get_meta(buffer, GST_ZED_SRC_META_API_TYPE);
+
+    gboolean passthrough;
+    if (meta == NULL) {
+        // Let `transform_ip` raise the error if missing metadata is not allowed
+        passthrough = filter->allow_missing_meta;
+    } else {
+        passthrough = !meta->od_enabled || meta->obj_count == 0;
+    }
+
+    GST_LOG_OBJECT(filter, "Passthrough: %s", passthrough ? "TRUE" : "FALSE");
+    gst_base_transform_set_passthrough(base, passthrough);
+}
+
 /* this function does the actual processing
  */
 static GstFlowReturn gst_zed_od_overlay_transform_ip(GstBaseTransform *base, GstBuffer *outbuf) {
     GstZedOdOverlay *filter = GST_ZED_OD_OVERLAY(base);
     GST_TRACE_OBJECT(filter, "transform_ip");
 
-    GstMapInfo map_buf;
-
     if (GST_CLOCK_TIME_IS_VALID(GST_BUFFER_TIMESTAMP(outbuf)))
         gst_object_sync_values(GST_OBJECT(filter), GST_BUFFER_TIMESTAMP(outbuf));
 
-    if (FALSE == gst_buffer_map(outbuf, &map_buf, GstMapFlags(GST_MAP_READ | GST_MAP_WRITE))) {
-        GST_WARNING_OBJECT(filter, "Could not map buffer for write/read");
-        return GST_FLOW_OK;
-    }
-
-    // Get left image (upper half memory buffer)
-    cv::Mat ocv_left = cv::Mat(filter->img_left_h, filter->img_left_w, CV_8UC4, map_buf.data);
-
     // Metadata
     GstZedSrcMeta *meta = (GstZedSrcMeta *) gst_buffer_get_meta(outbuf, GST_ZED_SRC_META_API_TYPE);
 
     if (meta == NULL)   // Metadata not found
     {
+        if (filter->allow_missing_meta) {
+            return GST_FLOW_OK;
+        }
         GST_ELEMENT_ERROR(filter, RESOURCE, FAILED,
                           ("No ZED metadata [GstZedSrcMeta] found in the stream'"), (NULL));
         return GST_FLOW_ERROR;
     }
 
+    // Nothing to draw (see `before_transform`): the render pool and the label cache are not used
+    if (gst_base_transform_is_passthrough(base)) {
+        return GST_FLOW_OK;
+    }
+
     GST_LOG_OBJECT(filter, "Cam. Model: %d", meta->info.cam_model);
     GST_LOG_OBJECT(filter, "Stream type: %d", meta->info.stream_type);
     GST_LOG_OBJECT(filter, "Grab frame Size: %d x %d", meta->info.grab_single_frame_width,
                    meta->info.grab_single_frame_height);
     GST_LOG_OBJECT(filter, "Filter frame Size: %d x %d", filter->img_left_w, filter->img_left_h);
 
-    gboolean rescaled = FALSE;
+    // Scalers handling the video size tag already rescaled the metadata: the factors are not 1
+    // only if the frame was resized by an element that blindly copied it
     gfloat scaleW = 1.0f;
     gfloat scaleH = 1.0f;
     if (meta->info.grab_single_frame_width != filter->img_left_w ||
         meta->info.grab_single_frame_height != filter->img_left_h) {
-        rescaled = TRUE;
         scaleW = ((gfloat) filter->img_left_w) / meta->info.grab_single_frame_width;
         scaleH = ((gfloat) filter->img_left_h) / meta->info.grab_single_frame_height;
     }
 
+    // ----> Render the annotations into the sparse layer
+    ensure_render_pool(filter);
+    filter->label_cache->set_line_type(filter->anti_aliasing ? cv::LINE_AA : cv::LINE_8);
+
     if (meta->od_enabled) {
-        GST_LOG_OBJECT(filter, "Detected %d objects", meta->obj_count);
-        // Draw 2D detections
-        draw_objects(filter, ocv_left, meta->obj_count, meta->objects, scaleW, scaleH);
+        GST_LOG_OBJECT(filter, "Detected %u objects", meta->obj_count);
+        // Geometry and labels are resolved on the streaming thread, then the
+        // bands of the layer are rasterized in parallel
+        prepare_objects(filter, meta->obj_count, meta->objects, scaleW, scaleH);
+        run_bands(filter, GST_ZED_OD_TASK_RASTERIZE, scaleW, scaleH, NULL);
+    }
+    filter->label_cache->next_frame();
+    // <---- Render the annotations into the sparse layer
+
+    if (!filter->layer->is_dirty()) {
+        // All the objects are out of the image
+        return GST_FLOW_OK;
+    }
+
+    // ----> Apply the layer
+    if (filter->overlay_mode == GST_ZED_OD_OVERLAY_MODE_COMPOSITION_META) {
+        GstVideoOverlayComposition *comp = filter->layer->composition();
+        if (comp) {
+            gst_buffer_add_video_overlay_composition_meta(outbuf, comp);
+            gst_video_overlay_composition_unref(comp);
+        }
+    } else {
+        GstVideoFrame frame;
+
+        if (FALSE == gst_video_frame_map(&frame, &filter->vinfo, outbuf,
+                                         GstMapFlags(GST_MAP_READ | GST_MAP_WRITE))) {
+            GST_WARNING_OBJECT(filter, "Could not map buffer for write/read");
+            filter->layer->clear();
+            return GST_FLOW_OK;
+        }
+
+        // The layer covers the left image, i.e. the upper half of composite streams.
+        // Drawing is done natively in the frame format, without color conversion of the frame.
+        if (!run_bands(filter, GST_ZED_OD_TASK_BLEND, scaleW, scaleH, &frame)) {
+            GST_WARNING_OBJECT(filter, "Unsupported format: %s",
+                               gst_video_format_to_string(GST_VIDEO_FRAME_FORMAT(&frame)));
+        }
+
+        GST_TRACE("Buffer unmap");
+        gst_video_frame_unmap(&frame);
     }
 
-    GST_TRACE("Buffer unmap");
-    gst_buffer_unmap(outbuf, &map_buf);
+    filter->layer->clear();
+    // <---- Apply the layer
 
     return GST_FLOW_OK;
 }
@@ -441,357 +643,337 @@ GST_PLUGIN_DEFINE(GST_VERSION_MAJOR, GST_VERSION_MINOR, zedodoverlay,
                   "ZED Object Detection Overlay", plugin_init, GST_PACKAGE_VERSION,
                   GST_PACKAGE_LICENSE, GST_PACKAGE_NAME, GST_PACKAGE_ORIGIN)
 
-static void draw_objects(GstZedOdOverlay *filter, cv::Mat &image, guint8 obj_count,
-                         ZedObjectData *objs, gfloat scaleW, gfloat scaleH) {
-    for (int i = 0; i < obj_count; i++) {
-        cv::Scalar color = cv::Scalar::all(125);
+// ----> Rendering
+
+// Geometry of an object, computed on the streaming thread before rasterization
+struct GstZedOdItem {
+    const ZedObjectData *obj;
+    cv::Scalar color;
+    cv::Rect bounds;   // area covered in the layer
+    cv::Point2f tl;
+    cv::Point2f br;
+    const GstZedOdLabelCache::Sprite *label;
+    cv::Point label_pos;
+    const GstZedOdLabelCache::Sprite *dist_label;
+    cv::Point dist_pos;
+};
+
+// Horizontal band of the layer processed by a single thread
+typedef struct {
+    GstZedOdOverlay *filter;
+    GstZedOdTaskType type;
+    gint y_begin;
+    gint y_end;
+    gfloat scaleW;
+    gfloat scaleH;
+    gint line_type;
+    GstVideoFrame *frame;
+    gboolean result;
+} GstZedOdTask;
+
+static cv::Rect sprite_rect(const GstZedOdLabelCache::Sprite &sprite, cv::Point pos) {
+    return cv::Rect(pos - sprite.anchor, sprite.alpha.size());
+}
+
+static void prepare_objects(GstZedOdOverlay *filter, guint32 obj_count, ZedObjectData *objs,
+                            gfloat scaleW, gfloat scaleH) {
+    filter->items->clear();
+
+    filter->items->reserve(obj_count);
+    for (guint32 i = 0; i < obj_count; i++) {
+        GstZedOdItem item;
+        item.obj = &objs[i];
+        item.label = NULL;
+        item.dist_label = NULL;
+
+        // Opaque colors: the layer alpha is the coverage of the primitives
+        item.color = cv::Scalar(125, 125, 125, 255);
         if (objs[i].id >= 0) {
-            color = cv::Scalar((objs[i].id * 232 + 232) % 255, (objs[i].id * 176 + 176) % 255,
-                               (objs[i].id * 59 + 59) % 255);
+            item.color =
+                cv::Scalar((objs[i].id * 232 + 232) % 255, (objs[i].id * 176 + 176) % 255,
+                           (objs[i].id * 59 + 59) % 255, 255);
         }
 
-        cv::Rect roi_render(0, 0, image.size().width, image.size().height);
-
-        GST_LOG_OBJECT(filter, "Object: %d", i);
+        GST_LOG_OBJECT(filter, "Object: %u", i);
         GST_LOG_OBJECT(filter, " * Id: %d [%d]", (int) objs[i].label, (int) objs[i].sublabel);
         GST_LOG_OBJECT(filter, " * Pos: %g,%g,%g", objs[i].position[0], objs[i].position[1],
                        objs[i].position[2]);
+        GST_LOG_OBJECT(filter, "Scale: %g, %g", scaleW, scaleH);
 
         if (objs[i].skeletons_avail == FALSE) {
-            GST_LOG_OBJECT(filter, "Scale: %g, %g", scaleW, scaleH);
-
             // ----> Bounding box
-
-            cv::Point2f tl;
-            tl.x = objs[i].bounding_box_2d[0][0] * scaleW;
-            tl.y = objs[i].bounding_box_2d[0][1] * scaleH;
-            cv::Point2f br;
-            br.x = objs[i].bounding_box_2d[2][0] * scaleW;
-            br.y = objs[i].bounding_box_2d[2][1] * scaleH;
-            cv::rectangle(image, tl, br, color, 3);
-
+            item.tl.x = objs[i].bounding_box_2d[0][0] * scaleW;
+            item.tl.y = objs[i].bounding_box_2d[0][1] * scaleH;
+            item.br.x = objs[i].bounding_box_2d[2][0] * scaleW;
+            item.br.y = objs[i].bounding_box_2d[2][1] * scaleH;
+
+            // Thickness 3 is drawn up to 2 pixels outside of the box
+            item.bounds = cv::Rect(cv::Point(item.tl), cv::Point(item.br)) + cv::Size(5, 5) -
+                          cv::Point(2, 2);
             // <---- Bounding box
 
             // ----> Text info
-            int baseline = 0;
-            int font_face = cv::FONT_HERSHEY_COMPLEX_SMALL;
-            double font_scale = 0.75;
+            // Labels are rasterized once and blended from the cache on the next frames
+            item.label = &filter->label_cache->object_label(objs[i], item.color);
 
-            std::stringstream txt_info;
-            txt_info << "Id: " << objs[i].id << " - ";
+            item.label_pos = cv::Point(item.tl.x, item.tl.y);
+            if (item.label_pos.y - item.label->alpha.rows < 0) {
+                // Not enough space above the box: draw the label inside it
+                item.label_pos.y = item.tl.y + item.label->alpha.rows;
+            }
+            item.bounds |= sprite_rect(*item.label, item.label_pos);
 
-            switch (objs[i].label) {
-            case OBJECT_CLASS::PERSON:
-                txt_info << "PERSON";
-                break;
-            case OBJECT_CLASS::VEHICLE:
-                txt_info << "VEHICLE";
-                break;
-            case OBJECT_CLASS::ANIMAL:
-                txt_info << "ANIMAL";
+            if (!std::isnan(objs[i].position[0]) && !std::isnan(objs[i].position[1]) &&
+                !std::isnan(objs[i].position[2])) {
+                float dist = sqrtf(objs[i].position[0] * objs[i].position[0] +
+                                   objs[i].position[1] * objs[i].position[1] +
+                                   objs[i].position[2] * objs[i].position[2]);
+                item.dist_label = &filter->label_cache->distance_label(dist, item.color);
+                item.dist_pos = cv::Point2i(item.tl.x + (item.br.x - item.tl.x) / 2 - 20,
+                                            item.tl.y + (item.br.y - item.tl.y) / 2 - 12);
+                item.bounds |= sprite_rect(*item.dist_label, item.dist_pos);
+            }
+            // <---- Text info
+        } else {
+            GST_LOG_OBJECT(filter, "Format: %d", objs[i].skel_format);
+
+            if (objs[i].skel_format != 18 && objs[i].skel_format != 34 &&
+                objs[i].skel_format != 38 && objs[i].skel_format != 70) {
+                // Skip this skeleton, reporting the bad format once per stream
+                if (!filter->skel_format_warned) {
+                    GST_ELEMENT_WARNING(filter, RESOURCE, FAILED, ("Wrong skeleton model format"),
+                                        ("Received skeleton format: %d, skeleton not drawn",
+                                         objs[i].skel_format));
+                    filter->skel_format_warned = TRUE;
+                }
+                continue;
+            }
+
+            // Every bone ends on a joint, so the joints bounds cover the whole skeleton
+            gfloat min_x = G_MAXFLOAT, min_y = G_MAXFLOAT, max_x = -1.f, max_y = -1.f;
+            for (int j = 0; j < objs[i].skel_format; j++) {
+                if (objs[i].keypoint_2d[j][0] >= 0 && objs[i].keypoint_2d[j][1] >= 0) {
+                    min_x = std::min(min_x, objs[i].keypoint_2d[j][0] * scaleW);
+                    min_y = std::min(min_y, objs[i].keypoint_2d[j][1] * scaleH);
+                    max_x = std::max(max_x, objs[i].keypoint_2d[j][0] * scaleW);
+                    max_y = std::max(max_y, objs[i].keypoint_2d[j][1] * scaleH);
+                }
+            }
+            if (max_x < 0) {
+                continue;   // No valid keypoint
+            }
+
+            // Joint radius + anti-aliasing
+            const int margin = 5;
+            item.bounds = cv::Rect(cv::Point((int) min_x - margin, (int) min_y - margin),
+                                   cv::Point((int) max_x + margin + 1, (int) max_y + margin + 1));
+        }
+
+        filter->layer->mark(item.bounds);
+        filter->items->push_back(item);
+    }
+}
+
+template <typename T>
+static void draw_skeleton(GstZedOdOverlay *filter, cv::Mat &band, const cv::Point2f &offset,
+                          const GstZedOdItem &item,
+                          const std::vector<std::pair<T, T>> &bones, int joint_count,
+                          gfloat scaleW, gfloat scaleH, int line_type) {
+    const ZedObjectData &obj = *item.obj;
+    cv::Rect roi_render(0, 0, filter->layer->width(), filter->layer->height());
+
+    // ----> Bones
+    for (const auto &parts : bones) {
+        int idx_a = static_cast<int>(parts.first);
+        int idx_b = static_cast<int>(parts.second);
+        if (obj.keypoint_2d[idx_a][0] >= 0 && obj.keypoint_2d[idx_a][1] >= 0 &&
+            obj.keypoint_2d[idx_b][0] >= 0 && obj.keypoint_2d[idx_b][1] >= 0) {
+            cv::Point2f kp_a(obj.keypoint_2d[idx_a][0] * scaleW,
+                             obj.keypoint_2d[idx_a][1] * scaleH);
+            cv::Point2f kp_b(obj.keypoint_2d[idx_b][0] * scaleW,
+                             obj.keypoint_2d[idx_b][1] * scaleH);
+            GST_LOG_OBJECT(filter, "kp_a: %g, %g", kp_a.x, kp_a.y);
+            GST_LOG_OBJECT(filter, "kp_b: %g, %g", kp_b.x, kp_b.y);
+
+            if (roi_render.contains(kp_a) && roi_render.contains(kp_b))
+                cv::line(band, kp_a + offset, kp_b + offset, item.color, 1, line_type);
+        }
+    }
+    // <---- Bones
+
+    // ----> Joints
+    for (int j = 0; j < joint_count; j++) {
+        if (obj.keypoint_2d[j][0] >= 0 && obj.keypoint_2d[j][1] >= 0) {
+            cv::Point2f cv_kp(obj.keypoint_2d[j][0] * scaleW, obj.keypoint_2d[j][1] * scaleH);
+            GST_LOG_OBJECT(filter, "Joint: %g, %g", cv_kp.x, cv_kp.y);
+
+            if (roi_render.contains(cv_kp)) {
+                cv::circle(band, cv_kp + offset, 3, item.color + cv::Scalar(50, 50, 50), -1,
+                           line_type);
+            }
+        }
+    }
+    // <---- Joints
+}
+
+// Rasterize the items intersecting rows [y_begin, y_end) of the layer
+static void rasterize_band(GstZedOdTask *task) {
+    GstZedOdOverlay *filter = task->filter;
+
+    cv::Mat band = filter->layer->image()(
+        cv::Rect(0, task->y_begin, filter->layer->width(), task->y_end - task->y_begin));
+    cv::Point offset(0, -task->y_begin);
+    cv::Point2f offset_f(0.f, (gfloat) -task->y_begin);
+
+    for (const GstZedOdItem &item : *filter->items) {
+        if (item.bounds.y >= task->y_end || item.bounds.y + item.bounds.height <= task->y_begin) {
+            continue;
+        }
+
+        const ZedObjectData &obj = *item.obj;
+
+        if (obj.skeletons_avail == FALSE) {
+            cv::rectangle(band, item.tl + offset_f, item.br + offset_f, item.color, 3);
+
+            GstZedOdLabelCache::blend(band, *item.label, item.label_pos + offset);
+            if (item.dist_label) {
+                GstZedOdLabelCache::blend(band, *item.dist_label, item.dist_pos + offset);
+            }
+        } else {
+            switch (obj.skel_format) {
+            case 18:
+                draw_skeleton(filter, band, offset_f, item, skeleton::BODY_18_BONES, 18,
+                              task->scaleW, task->scaleH, task->line_type);
                 break;
-            case OBJECT_CLASS::BAG:
-                txt_info << "BAG";
+            case 34:
+                draw_skeleton(filter, band, offset_f, item, skeleton::BODY_34_BONES, 34,
+                              task->scaleW, task->scaleH, task->line_type);
                 break;
-            case OBJECT_CLASS::ELECTRONICS:
-                txt_info << "ELECTRONICS";
+            case 38:
+                draw_skeleton(filter, band, offset_f, item, skeleton::BODY_38_BONES, 38,
+                              task->scaleW, task->scaleH, task->line_type);
                 break;
-            case OBJECT_CLASS::FRUIT_VEGETABLE:
-                txt_info << "FRUIT_VEGETABLE";
+            case 70:
+                draw_skeleton(filter, band, offset_f, item, skeleton::BODY_70_BONES, 70,
+                              task->scaleW, task->scaleH, task->line_type);
                 break;
-            case OBJECT_CLASS::LAST:
             default:
-                txt_info << "UNDEFINED";
                 break;
             }
+        }
+    }
+}
 
-            if (!objs[i].skeletons_avail) {
-                switch (objs[i].sublabel) {
-                case OBJECT_SUBCLASS::PERSON:
-                    // txt_info << " [Person]";
-                    break;
-                case OBJECT_SUBCLASS::BICYCLE:
-                    txt_info << " [Bicycle]";
-                    break;
-                case OBJECT_SUBCLASS::CAR:
-                    txt_info << " [Car]";
-                    break;
-                case OBJECT_SUBCLASS::MOTORBIKE:
-                    txt_info << " [Motorbike]";
-                    break;
-                case OBJECT_SUBCLASS::BUS:
-                    txt_info << " [Bus]";
-                    break;
-                case OBJECT_SUBCLASS::TRUCK:
-                    txt_info << " [Truck]";
-                    break;
-                case OBJECT_SUBCLASS::BOAT:
-                    txt_info << " [Boat]";
-                    break;
-                case OBJECT_SUBCLASS::BACKPACK:
-                    txt_info << " [Backpack]";
-                    break;
-                case OBJECT_SUBCLASS::HANDBAG:
-                    txt_info << " [Handbag]";
-                    break;
-                case OBJECT_SUBCLASS::SUITCASE:
-                    txt_info << " [Suitcase]";
-                    break;
-                case OBJECT_SUBCLASS::BIRD:
-                    txt_info << " [Bird]";
-                    break;
-                case OBJECT_SUBCLASS::CAT:
-                    txt_info << " [Cat]";
-                    break;
-                case OBJECT_SUBCLASS::DOG:
-                    txt_info << " [Dog]";
-                    break;
-                case OBJECT_SUBCLASS::HORSE:
-                    txt_info << " [Horse]";
-                    break;
-                case OBJECT_SUBCLASS::SHEEP:
-                    txt_info << " [Sheep]";
-                    break;
-                case OBJECT_SUBCLASS::COW:
-                    txt_info << " [Cow]";
-                    break;
-                case OBJECT_SUBCLASS::CELLPHONE:
-                    txt_info << " [CellPhone]";
-                    break;
-                case OBJECT_SUBCLASS::LAPTOP:
-                    txt_info << " [Laptop]";
-                    break;
-                case OBJECT_SUBCLASS::BANANA:
-                    txt_info << " [Banana]";
-                    break;
-                case OBJECT_SUBCLASS::APPLE:
-                    txt_info << " [Apple]";
-                    break;
-                case OBJECT_SUBCLASS::ORANGE:
-                    txt_info << " [Orange]";
-                    break;
-                case OBJECT_SUBCLASS::CARROT:
-                    txt_info << " [Carrot]";
-                    break;
-                default:
-                    txt_info << " [-]";
-                    break;
-                }
-            }
+static void run_task(GstZedOdTask *task) {
+    switch (task->type) {
+    case GST_ZED_OD_TASK_RASTERIZE:
+        rasterize_band(task);
+        task->result = TRUE;
+        break;
+    case GST_ZED_OD_TASK_BLEND:
+        task->result = task->filter->layer->blend(task->frame, task->y_begin, task->y_end);
+        break;
+    }
+}
 
-            cv::Size txt_size =
-                cv::getTextSize(txt_info.str(), font_face, font_scale, 1, &baseline);
+static void render_worker(gpointer data, gpointer user_data) {
+    GstZedOdOverlay *filter = GST_ZED_OD_OVERLAY(user_data);
 
-            int offset = 5;
+    run_task((GstZedOdTask *) data);
 
-            cv::Point txt_tl;
-            cv::Point txt_br;
-            cv::Point txt_pos;
+    g_mutex_lock(&filter->render_lock);
+    filter->render_pending--;
+    if (filter->render_pending == 0) {
+        g_cond_signal(&filter->render_cond);
+    }
+    g_mutex_unlock(&filter->render_lock);
+}
 
-            txt_tl.x = tl.x;
-            txt_tl.y = tl.y - (txt_size.height + 2 * offset);
+static void ensure_render_pool(GstZedOdOverlay *filter) {
+    guint workers = filter->render_threads > 1 ? filter->render_threads - 1 : 0;
 
-            txt_br.x = tl.x + (txt_size.width + 2 * offset);
-            txt_br.y = tl.y;
+    if (filter->render_pool && filter->render_pool_size == workers) {
+        return;
+    }
 
-            txt_pos.x = txt_tl.x + offset;
-            txt_pos.y = txt_br.y - offset;
+    if (filter->render_pool) {
+        g_thread_pool_free(filter->render_pool, FALSE, TRUE);
+        filter->render_pool = NULL;
+        filter->render_pool_size = 0;
+    }
 
-            if (!roi_render.contains(txt_tl)) {
-                txt_tl.y = tl.y + (txt_size.height + 2 * baseline);
-                txt_pos.y = txt_tl.y - offset;
-            }
+    if (workers == 0) {
+        return;
+    }
 
-            cv::rectangle(image, txt_tl, txt_br, color, 1);
-            cv::putText(image, txt_info.str(), txt_pos, font_face, font_scale, color, 1,
-                        cv::LINE_AA);
+    GError *error = NULL;
+    filter->render_pool = g_thread_pool_new(render_worker, filter, workers, TRUE, &error);
+    if (filter->render_pool == NULL) {
+        GST_WARNING_OBJECT(filter, "Cannot start the rendering threads: %s",
+                           error ? error->message : "unknown error");
+        g_clear_error(&error);
+        return;
+    }
+    filter->render_pool_size = workers;
 
-            if (!std::isnan(objs[i].position[0]) && !std::isnan(objs[i].position[1]) &&
-                !std::isnan(objs[i].position[2])) {
-                float dist = sqrtf(objs[i].position[0] * objs[i].position[0] +
-                                   objs[i].position[1] * objs[i].position[1] +
-                                   objs[i].position[2] * objs[i].position[2]);
-                char text[64];
-                snprintf(text, sizeof(text), "%.2fm", fabsf(dist / 1000.0f));
-                putText(image, text,
-                        cv::Point2i(tl.x + (br.x - tl.x) / 2 - 20, tl.y + (br.y - tl.y) / 2 - 12),
-                        cv::FONT_HERSHEY_COMPLEX_SMALL, 0.75, color, 1);
-            }
-            // <---- Text info
-        } else {
-            GST_LOG_OBJECT(filter, "Scale: %g, %g", scaleW, scaleH);
-            GST_LOG_OBJECT(filter, "Format: %d", objs[i].skel_format);
-            // ----> Skeletons
-            {
-                switch (objs[i].skel_format) {
-                case 18:
-                    // ----> Bones
-                    for (const auto &parts : skeleton::BODY_18_BONES) {
-                        if (objs[i].keypoint_2d[skeleton::getIdx_18(parts.first)][0] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_18(parts.first)][1] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_18(parts.second)][0] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_18(parts.second)][1] >= 0) {
-                            cv::Point2f kp_a;
-                            kp_a.x =
-                                objs[i].keypoint_2d[skeleton::getIdx_18(parts.first)][0] * scaleW;
-                            kp_a.y =
-                                objs[i].keypoint_2d[skeleton::getIdx_18(parts.first)][1] * scaleH;
-                            GST_LOG_OBJECT(filter, "kp_a: %g, %g", kp_a.x, kp_a.y);
-
-                            cv::Point2f kp_b;
-                            kp_b.x =
-                                objs[i].keypoint_2d[skeleton::getIdx_18(parts.second)][0] * scaleW;
-                            kp_b.y =
-                                objs[i].keypoint_2d[skeleton::getIdx_18(parts.second)][1] * scaleH;
-                            GST_LOG_OBJECT(filter, "kp_b: %g, %g", kp_b.x, kp_b.y);
-
-                            if (roi_render.contains(kp_a) && roi_render.contains(kp_b))
-                                cv::line(image, kp_a, kp_b, color, 1, cv::LINE_AA);
-                        }
-                    }
-                    // <---- Bones
-                    // ----> Joints
-                    for (int j = 0; j < 18; j++) {
-                        if (objs[i].keypoint_2d[j][0] >= 0 && objs[i].keypoint_2d[j][1] >= 0) {
-                            cv::Point2f cv_kp;
-                            cv_kp.x = objs[i].keypoint_2d[j][0] * scaleW;
-                            cv_kp.y = objs[i].keypoint_2d[j][1] * scaleH;
-                            if (roi_render.contains(cv_kp)) {
-                                cv::circle(image, cv_kp, 3, color + cv::Scalar(50, 50, 50), -1,
-                                           cv::LINE_AA);
-                            }
-                        }
-                    }
-                    // <---- Joints
-                    break;
-                case 34:
-                    // ----> Bones
-                    for (const auto &parts : skeleton::BODY_34_BONES) {
-                        if (objs[i].keypoint_2d[skeleton::getIdx_34(parts.first)][0] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_34(parts.first)][1] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_34(parts.second)][0] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_34(parts.second)][1] >= 0) {
-                            cv::Point2f kp_a;
-                            kp_a.x =
-                                objs[i].keypoint_2d[skeleton::getIdx_34(parts.first)][0] * scaleW;
-                            kp_a.y =
-                                objs[i].keypoint_2d[skeleton::getIdx_34(parts.first)][1] * scaleH;
-                            GST_LOG_OBJECT(filter, "kp_a: %g, %g", kp_a.x, kp_a.y);
-
-                            cv::Point2f kp_b;
-                            kp_b.x =
-                                objs[i].keypoint_2d[skeleton::getIdx_34(parts.second)][0] * scaleW;
-                            kp_b.y =
-                                objs[i].keypoint_2d[skeleton::getIdx_34(parts.second)][1] * scaleH;
-                            GST_LOG_OBJECT(filter, "kp_b: %g, %g", kp_b.x, kp_b.y);
-
-                            if (roi_render.contains(kp_a) && roi_render.contains(kp_b))
-                                cv::line(image, kp_a, kp_b, color, 1, cv::LINE_AA);
-                        }
-                    }
-                    // <---- Bones
-                    // ----> Joints
-                    for (int j = 0; j < 34; j++) {
-                        if (objs[i].keypoint_2d[j][0] >= 0 && objs[i].keypoint_2d[j][1] >= 0) {
-                            cv::Point2f cv_kp;
-                            cv_kp.x = objs[i].keypoint_2d[j][0] * scaleW;
-                            cv_kp.y = objs[i].keypoint_2d[j][1] * scaleH;
-                            if (roi_render.contains(cv_kp)) {
-                                cv::circle(image, cv_kp, 3, color + cv::Scalar(50, 50, 50), -1,
-                                           cv::LINE_AA);
-                            }
-                        }
-                    }
-                    // <---- Joints
-                    break;
-                case 38:
-                    // ----> Bones
-                    for (const auto &parts : skeleton::BODY_38_BONES) {
-                        if (objs[i].keypoint_2d[skeleton::getIdx_38(parts.first)][0] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_38(parts.first)][1] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_38(parts.second)][0] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_38(parts.second)][1] >= 0) {
-                            cv::Point2f kp_a;
-                            kp_a.x =
-                                objs[i].keypoint_2d[skeleton::getIdx_38(parts.first)][0] * scaleW;
-                            kp_a.y =
-                                objs[i].keypoint_2d[skeleton::getIdx_38(parts.first)][1] * scaleH;
-                            GST_LOG_OBJECT(filter, "kp_a: %g, %g", kp_a.x, kp_a.y);
-
-                            cv::Point2f kp_b;
-                            kp_b.x =
-                                objs[i].keypoint_2d[skeleton::getIdx_38(parts.second)][0] * scaleW;
-                            kp_b.y =
-                                objs[i].keypoint_2d[skeleton::getIdx_38(parts.second)][1] * scaleH;
-                            GST_LOG_OBJECT(filter, "kp_b: %g, %g", kp_b.x, kp_b.y);
-
-                            if (roi_render.contains(kp_a) && roi_render.contains(kp_b))
-                                cv::line(image, kp_a, kp_b, color, 1, cv::LINE_AA);
-                        }
-                    }
-                    // <---- Bones
-                    // ----> Joints
-                    for (int j = 0; j < 38; j++) {
-                        if (objs[i].keypoint_2d[j][0] >= 0 && objs[i].keypoint_2d[j][1] >= 0) {
-                            cv::Point2f cv_kp;
-                            cv_kp.x = objs[i].keypoint_2d[j][0] * scaleW;
-                            cv_kp.y = objs[i].keypoint_2d[j][1] * scaleH;
-                            if (roi_render.contains(cv_kp)) {
-                                cv::circle(image, cv_kp, 3, color + cv::Scalar(50, 50, 50), -1,
-                                           cv::LINE_AA);
-                            }
-                        }
-                    }
-                    // <---- Joints
-                    break;
-                case 70:
-                    // ----> Bones
-                    for (const auto &parts : skeleton::BODY_70_BONES) {
-                        if (objs[i].keypoint_2d[skeleton::getIdx_70(parts.first)][0] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_70(parts.first)][1] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_70(parts.second)][0] >= 0 &&
-                            objs[i].keypoint_2d[skeleton::getIdx_70(parts.second)][1] >= 0) {
-                            cv::Point2f kp_a;
-                            kp_a.x =
-                                objs[i].keypoint_2d[skeleton::getIdx_70(parts.first)][0] * scaleW;
-                            kp_a.y =
-                                objs[i].keypoint_2d[skeleton::getIdx_70(parts.first)][1] * scaleH;
-                            GST_LOG_OBJECT(filter, "kp_a: %g, %g", kp_a.x, kp_a.y);
-
-                            cv::Point2f kp_b;
-                            kp_b.x =
-                                objs[i].keypoint_2d[skeleton::getIdx_70(parts.second)][0] * scaleW;
-                            kp_b.y =
-                                objs[i].keypoint_2d[skeleton::getIdx_70(parts.second)][1] * scaleH;
-                            GST_LOG_OBJECT(filter, "kp_b: %g, %g", kp_b.x, kp_b.y);
-
-                            if (roi_render.contains(kp_a) && roi_render.contains(kp_b))
-                                cv::line(image, kp_a, kp_b, color, 1, cv::LINE_AA);
-                        }
-                    }
-                    // <---- Bones
-                    // ----> Joints
-                    for (int j = 0; j < 70; j++) {
-                        if (objs[i].keypoint_2d[j][0] >= 0 && objs[i].keypoint_2d[j][1] >= 0) {
-                            cv::Point2f cv_kp;
-                            cv_kp.x = objs[i].keypoint_2d[j][0] * scaleW;
-                            cv_kp.y = objs[i].keypoint_2d[j][1] * scaleH;
-                            GST_LOG_OBJECT(filter, "Joint: %g, %g", cv_kp.x, cv_kp.y);
-
-                            if (roi_render.contains(cv_kp)) {
-                                cv::circle(image, cv_kp, 3, color + cv::Scalar(50, 50, 50), -1,
-                                           cv::LINE_AA);
-                            }
-                        }
-                    }
-                    // <---- Joints
-                    break;
-                default:
-                    GST_ELEMENT_ERROR(filter, RESOURCE, FAILED, ("Wrong skeleton model format"),
-                                      ("Received skeleton format: %d", objs[i].skel_format));
-                }
-            }
-            // <---- Skeletons
+    GST_DEBUG_OBJECT(filter, "Rendering with %u threads", workers + 1);
+}
+
+/* Split the layer in tile aligned horizontal bands, one per rendering thread, and run
+ * them. The first band is processed by the calling thread. Return FALSE if a task failed.
+ */
+static gboolean run_bands(GstZedOdOverlay *filter, GstZedOdTaskType type, gfloat scaleW,
+                          gfloat scaleH, GstVideoFrame *frame) {
+    gint height = filter->layer->height();
+    gint tiles = (height + GST_ZED_OD_LAYER_TILE_SIZE - 1) / GST_ZED_OD_LAYER_TILE_SIZE;
+    gint bands = filter->render_pool ? MIN((gint) filter->render_pool_size + 1, tiles) : 1;
+    bands = MAX(bands, 1);
+    gint band_h = ((tiles + bands - 1) / bands) * GST_ZED_OD_LAYER_TILE_SIZE;
+
+    std::vector<GstZedOdTask> tasks;
+    for (gint y = 0; y < height; y += band_h) {
+        GstZedOdTask task;
+        task.filter = filter;
+        task.type = type;
+        task.y_begin = y;
+        task.y_end = MIN(y + band_h, height);
+        task.scaleW = scaleW;
+        task.scaleH = scaleH;
+        task.line_type = filter->anti_aliasing ? cv::LINE_AA : cv::LINE_8;
+        task.frame = frame;
+        task.result = FALSE;
+        tasks.push_back(task);
+    }
+
+    if (tasks.empty()) {
+        return TRUE;
+    }
+
+    if (tasks.size() > 1) {
+        g_mutex_lock(&filter->render_lock);
+        filter->render_pending = tasks.size() - 1;
+        g_mutex_unlock(&filter->render_lock);
+
+        for (size_t t = 1; t < tasks.size(); t++) {
+            g_thread_pool_push(filter->render_pool, &tasks[t], NULL);
         }
     }
+
+    run_task(&tasks[0]);
+
+    if (tasks.size() > 1) {
+        g_mutex_lock(&filter->render_lock);
+        while (filter->render_pending > 0) {
+            g_cond_wait(&filter->render_cond, &filter->render_lock);
+        }
+        g_mutex_unlock(&filter->render_lock);
+    }
+
+    gboolean result = TRUE;
+    for (const GstZedOdTask &task : tasks) {
+        result &= task.result;
+    }
+    return result;
 }
+
+// <---- Rendering
@@ -24,10 +24,22 @@
 
 #include <gst/base/gstbasetransform.h>
 #include <gst/gst.h>
+#include <gst/video/video.h>
+
+#include <vector>
+
+class GstZedOdLabelCache;
+class GstZedOdLayer;
+struct GstZedOdItem;
 
 G_BEGIN_DECLS
 
 #define GST_TYPE_ZED_OD_OVERLAY (gst_zed_od_overlay_get_type())
+typedef enum {
+    GST_ZED_OD_OVERLAY_MODE_BLEND = 0,
+    GST_ZED_OD_OVERLAY_MODE_COMPOSITION_META = 1,
+} GstZedOdOverlayMode;
+
 G_DECLARE_FINAL_TYPE(GstZedOdOverlay, gst_zed_od_overlay, GST, ZED_OD_OVERLAY, GstBaseTransform)
 
 struct _GstZedOdOverlay {
@@ -35,6 +47,28 @@ struct _GstZedOdOverlay {
 
     guint img_left_w;
     guint img_left_h;
+    GstVideoInfo vinfo;
+
+    GstZedOdLabelCache *label_cache;
+    GstZedOdLayer *layer;
+
+    // Objects to draw in the current frame
+    std::vector<GstZedOdItem> *items;
+
+    // Rendering workers, used when `render_threads` > 1
+    GThreadPool *render_pool;
+    guint render_pool_size;
+    GMutex render_lock;
+    GCond render_cond;
+    guint render_pending;
+
+    // Properties
+    GstZedOdOverlayMode overlay_mode;
+    gboolean allow_missing_meta;
+    guint render_threads;
+    gboolean anti_aliasing;
+
+    gboolean skel_format_warned;   // unsupported skeleton formats already reported
 };
 
 G_END_DECLS
@@ -0,0 +1,234 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzedcalibration.h"
+
+#include <string.h>
+
+GST_DEBUG_CATEGORY_STATIC(gst_zed_calibration_debug);
+#define GST_CAT_DEFAULT gst_zed_calibration_debug
+
+static const struct {
+    const gchar *name;
+    guint width;
+    guint height;
+} zed_resolutions[] = {
+    {"2K", 2208, 1242}, {"FHD", 1920, 1080}, {"FHD1200", 1920, 1200},
+    {"HD", 1280, 720},  {"SVGA", 960, 600},  {"VGA", 672, 376},
+};
+
+/* Left camera intrinsics of a ZED calibration file, an INI file with one [LEFT_CAM_<resolution>]
+ * group per resolution. The group of the depth map resolution is used, or the largest one with
+ * the same aspect ratio for decimated depth maps.
+ */
+static gboolean parse_zed_calibration(const gchar *contents, guint width, guint height,
+                                      gdouble k[4], guint *calib_width, guint *calib_height) {
+    GKeyFile *key_file = g_key_file_new();
+    gboolean ok = FALSE;
+
+    if (!g_key_file_load_from_data(key_file, contents, -1, G_KEY_FILE_NONE, NULL)) {
+        g_key_file_free(key_file);
+        return FALSE;
+    }
+
+    gint best = -1;
+    for (guint i = 0; i < G_N_ELEMENTS(zed_resolutions); i++) {
+        guint w = zed_resolutions[i].width;
+        guint h = zed_resolutions[i].height;
+        gchar *group = g_strdup_printf("LEFT_CAM_%s", zed_resolutions[i].name);
+        gboolean found = g_key_file_has_group(key_file, group);
+        g_free(group);
+
+        if (!found) {
+            continue;
+        }
+        if (w == width && h == height) {
+            best = (gint) i;
+            break;
+        }
+        // Sizes rounded by a decimation keep the aspect ratio up to one pixel
+        gint64 skew = (gint64) width * h - (gint64) height * w;
+        if (ABS(skew) <= (gint64) (w + h) && (best < 0 || w > zed_resolutions[best].width)) {
+            best = (gint) i;
+        }
+    }
+
+    if (best >= 0) {
+        gchar *group = g_strdup_printf("LEFT_CAM_%s", zed_resolutions[best].name);
+        const gchar *keys[4] = {"fx", "fy", "cx", "cy"};
+        GError *error = NULL;
+
+        ok = TRUE;
+        for (guint i = 0; i < 4 && ok; i++) {
+            k[i] = g_key_file_get_double(key_file, group, keys[i], &error);
+            if (error) {
+                g_clear_error(&error);
+                ok = FALSE;
+            }
+        }
+        g_free(group);
+        *calib_width = zed_resolutions[best].width;
+        *calib_height = zed_resolutions[best].height;
+    }
+
+    g_key_file_free(key_file);
+    return ok;
+}
+
+/* Numbers of the first `[ ... ]` list following the top level `key:` entry, as written by the
+ * OpenCV FileStorage YAML writer for matrices (`data: [ ... ]`) and sizes.
+ */
+static guint parse_yaml_list(const gchar *contents, const gchar *key, gdouble *values,
+                             guint max) {
+    gsize key_len = strlen(key);
+    const gchar *p = contents;
+
+    while ((p = strstr(p, key)) != NULL) {
+        if ((p == contents || p[-1] == '\n') && p[key_len] == ':') {
+            break;
+        }
+        p += key_len;
+    }
+    if (p == NULL || (p = strchr(p, '[')) == NULL) {
+        return 0;
+    }
+    p++;
+
+    guint count = 0;
+    while (count < max) {
+        gchar *end;
+        gdouble value = g_ascii_strtod(p, &end);
+        if (end == p) {
+            break;
+        }
+        values[count++] = value;
+        p = end;
+        while (g_ascii_isspace(*p) || *p == ',') {
+            p++;
+        }
+    }
+    return count;
+}
+
+/* Left camera intrinsics of an OpenCV calibration file, as used by the `opencv-calibration-file`
+ * property of `zedsrc`: `Size` is the calibrated resolution and `K_LEFT` the camera matrix.
+ */
+static gboolean parse_opencv_calibration(const gchar *contents, gdouble k[4], guint *calib_width,
+                                         guint *calib_height) {
+    gdouble size[2];
+    gdouble matrix[9];
+
+    if (parse_yaml_list(contents, "Size", size, 2) != 2 ||
+        parse_yaml_list(contents, "K_LEFT", matrix, 9) != 9 || size[0] < 1 || size[1] < 1) {
+        return FALSE;
+    }
+
+    k[0] = matrix[0];
+    k[1] = matrix[4];
+    k[2] = matrix[2];
+    k[3] = matrix[5];
+    *calib_width = (guint) size[0];
+    *calib_height = (guint) size[1];
+    return TRUE;
+}
+
+static gboolean load_calibration_file(GstElement *element, const gchar *path, guint width,
+                                      guint height, gfloat k[4]) {
+    gchar *contents = NULL;
+    GError *error = NULL;
+
+    if (!g_file_get_contents(path, &contents, NULL, &error)) {
+        GST_ELEMENT_ERROR(element, RESOURCE, OPEN_READ,
+                          ("Cannot read the calibration file '%s'", path), ("%s", error->message));
+        g_clear_error(&error);
+        return FALSE;
+    }
+
+    gdouble calib[4];
+    guint calib_width = 0, calib_height = 0;
+    gboolean ok = g_str_has_prefix(contents, "%YAML")
+                      ? parse_opencv_calibration(contents, calib, &calib_width, &calib_height)
+                      : parse_zed_calibration(contents, width, height, calib, &calib_width,
+                                              &calib_height);
+    g_free(contents);
+
+    if (!ok) {
+        GST_ELEMENT_ERROR(element, LIBRARY, SETTINGS,
+                          ("No left camera intrinsics for %ux%u depth maps in '%s'", width, height,
+                           path),
+                          (NULL));
+        return FALSE;
+    }
+
+    // Depth maps smaller than the calibrated resolution are decimated or scaled frames
+    gdouble sx = (gdouble) width / calib_width;
+    gdouble sy = (gdouble) height / calib_height;
+    k[0] = (gfloat) (calib[0] * sx);
+    k[1] = (gfloat) (calib[1] * sy);
+    k[2] = (gfloat) ((calib[2] + 0.5) * sx - 0.5);
+    k[3] = (gfloat) ((calib[3] + 0.5) * sy - 0.5);
+
+    GST_INFO_OBJECT(element, "Intrinsics of %ux%u images read from '%s'", calib_width,
+                    calib_height, path);
+    return TRUE;
+}
+
+gboolean gst_zed_calibration_get_intrinsics(GstElement *element, const GstStructure *s,
+                                            guint width, guint height, const gfloat props[4],
+                                            const gchar *path, gfloat k[4]) {
+    static gsize debug_init = 0;
+    if (g_once_init_enter(&debug_init)) {
+        GST_DEBUG_CATEGORY_INIT(gst_zed_calibration_debug, "zedcalibration", 0,
+                                "ZED calibration files");
+        g_once_init_leave(&debug_init, 1);
+    }
+
+    gdouble caps_k[4];
+
+    if (gst_structure_get_double(s, "fx", &caps_k[0]) &&
+        gst_structure_get_double(s, "fy", &caps_k[1]) &&
+        gst_structure_get_double(s, "cx", &caps_k[2]) &&
+        gst_structure_get_double(s, "cy", &caps_k[3])) {
+        for (guint i = 0; i < 4; i++) {
+            k[i] = (gfloat) caps_k[i];
+        }
+        GST_INFO_OBJECT(element, "Intrinsics read from the caps");
+        return TRUE;
+    }
+
+    if (props[0] > 0.f && props[1] > 0.f) {
+        k[0] = props[0];
+        k[1] = props[1];
+        k[2] = props[2] > 0.f ? props[2] : (width - 1) * 0.5f;
+        k[3] = props[3] > 0.f ? props[3] : (height - 1) * 0.5f;
+        GST_INFO_OBJECT(element, "Intrinsics read from the properties");
+        return TRUE;
+    }
+
+    if (path != NULL && path[0] != '\0') {
+        return load_calibration_file(element, path, width, height, k);
+    }
+
+    GST_ELEMENT_ERROR(element, LIBRARY, SETTINGS, ("No camera intrinsics"),
+                      ("Set the 'fx' and 'fy' or the 'calibration-file' properties, or the 'fx', "
+                       "'fy', 'cx' and 'cy' fields of the input caps"));
+    return FALSE;
+}
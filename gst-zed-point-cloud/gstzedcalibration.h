@@ -0,0 +1,44 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef GST_ZED_CALIBRATION_H
+#define GST_ZED_CALIBRATION_H
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/* Intrinsics (fx, fy, cx, cy) in pixels of the `width` x `height` depth maps received by
+ * `element`, looked up in this order:
+ *   - the `fx`, `fy`, `cx` and `cy` double fields of the caps structure `s`,
+ *   - `props` when its focal lengths are set, a principal point of 0 being the image center,
+ *   - the calibration file `path`: a ZED calibration file (SN<serial>.conf, one [LEFT_CAM_<res>]
+ *     group per resolution) or an OpenCV YAML file with `Size` and `K_LEFT`, the intrinsics
+ *     being rescaled to the depth map size.
+ * Posts an error message on `element` and returns FALSE when none is usable.
+ */
+gboolean gst_zed_calibration_get_intrinsics(GstElement *element, const GstStructure *s,
+                                            guint width, guint height, const gfloat props[4],
+                                            const gchar *path, gfloat k[4]);
+
+G_END_DECLS
+
+#endif   // GST_ZED_CALIBRATION_H
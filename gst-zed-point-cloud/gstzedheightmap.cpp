@@ -0,0 +1,847 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzedheightmap.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "gst-zed-meta/gstzedmeta.h"
+#include "gst-zed-meta/gstzedtimingmeta.h"
+#include "gstzedcalibration.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_zed_height_map_debug);
+#define GST_CAT_DEFAULT gst_zed_height_map_debug
+
+enum {
+    PROP_0,
+    PROP_CALIBRATION_FILE,
+    PROP_FX,
+    PROP_FY,
+    PROP_CX,
+    PROP_CY,
+    PROP_COORD_SYS,
+    PROP_RESOLUTION,
+    PROP_SIZE,
+    PROP_MIN_HEIGHT,
+    PROP_MAX_HEIGHT,
+    PROP_MAX_RANGE,
+    PROP_OUTPUT_RATE,
+};
+
+#define DEFAULT_PROP_CALIBRATION_FILE ""
+#define DEFAULT_PROP_INTRINSIC 0.f
+#define DEFAULT_PROP_COORD_SYS 0
+#define DEFAULT_PROP_RESOLUTION 0.05f
+#define DEFAULT_PROP_SIZE 20.f
+#define DEFAULT_PROP_MIN_HEIGHT -2.f
+#define DEFAULT_PROP_MAX_HEIGHT 2.f
+#define DEFAULT_PROP_MAX_RANGE 10.f
+#define DEFAULT_PROP_OUTPUT_RATE 0.0
+
+#define CHUNK GST_ZED_HEIGHT_MAP_CHUNK
+#define MAX_CHUNKS (8192 / CHUNK)
+
+// sl::POSITIONAL_TRACKING_STATE::OK
+#define POS_TRACKING_STATE_OK 1
+
+/* Axes of the `zedsrc` coordinate systems (sl::COORDINATE_SYSTEM): `cam` maps the image frame
+ * of the depth maps (X right, Y down, Z forward) to the camera frame of the coordinate system,
+ * `up` is the vertical axis and `ground` the two horizontal ones.
+ */
+static const struct {
+    gfloat cam[3][3];
+    guint up;
+    guint ground[2];
+} coord_systems[] = {
+    {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}, 1, {0, 2}},     // IMAGE, Y down
+    {{{1, 0, 0}, {0, -1, 0}, {0, 0, 1}}, 1, {0, 2}},    // LEFT_HANDED_Y_UP
+    {{{1, 0, 0}, {0, -1, 0}, {0, 0, -1}}, 1, {0, 2}},   // RIGHT_HANDED_Y_UP
+    {{{1, 0, 0}, {0, 0, 1}, {0, -1, 0}}, 2, {0, 1}},    // RIGHT_HANDED_Z_UP
+    {{{0, 0, 1}, {1, 0, 0}, {0, -1, 0}}, 2, {0, 1}},    // LEFT_HANDED_Z_UP
+    {{{0, 0, 1}, {-1, 0, 0}, {0, -1, 0}}, 2, {0, 1}},   // RIGHT_HANDED_Z_UP_X_FWD
+};
+
+#define GST_TYPE_ZED_HEIGHT_MAP_COORD_SYS (gst_zed_height_map_coord_sys_get_type())
+static GType gst_zed_height_map_coord_sys_get_type(void) {
+    static GType zed_height_map_coord_sys_type = 0;
+
+    if (!zed_height_map_coord_sys_type) {
+        static GEnumValue pattern_types[] = {
+            {0, "Standard coordinates system in computer vision. Used in OpenCV.", "Image"},
+            {1, "Left-Handed with Y up and Z forward. Used in Unity with DirectX.",
+             "Left handed, Y up"},
+            {2, "Right-Handed with Y pointing up and Z backward. Used in OpenGL.",
+             "Right handed, Y up"},
+            {3, "Right-Handed with Z pointing up and Y forward. Used in 3DSMax.",
+             "Right handed, Z up"},
+            {4, "Left-Handed with Z axis pointing up and X forward. Used in Unreal Engine.",
+             "Left handed, Z up"},
+            {5, "Right-Handed with Z pointing up and X forward. Used in ROS (REP 103).",
+             "Right handed, Z up, X fwd"},
+            {0, NULL, NULL},
+        };
+
+        zed_height_map_coord_sys_type =
+            g_enum_register_static("GstZedHeightMapCoordSys", pattern_types);
+    }
+
+    return zed_height_map_coord_sys_type;
+}
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE(
+    "sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string)GRAY16_LE, "
+                    "width = (int)[ 1, 8192 ], "
+                    "height = (int)[ 1, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE(
+    "src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string)GRAY16_LE, "
+                    "width = (int)[ 32, 8192 ], "
+                    "height = (int)[ 32, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]; " GST_ZED_HEIGHT_MAP_CAPS_NAME ", "
+                    "width = (int)[ 32, 8192 ], "
+                    "height = (int)[ 32, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+#define gst_zed_height_map_parent_class parent_class
+G_DEFINE_TYPE(GstZedHeightMap, gst_zed_height_map, GST_TYPE_BASE_TRANSFORM);
+
+static void gst_zed_height_map_set_property(GObject *object, guint prop_id, const GValue *value,
+                                            GParamSpec *pspec);
+static void gst_zed_height_map_get_property(GObject *object, guint prop_id, GValue *value,
+                                            GParamSpec *pspec);
+static void gst_zed_height_map_finalize(GObject *object);
+
+static GstCaps *gst_zed_height_map_transform_caps(GstBaseTransform *base,
+                                                  GstPadDirection direction, GstCaps *caps,
+                                                  GstCaps *filter);
+static gboolean gst_zed_height_map_transform_size(GstBaseTransform *base,
+                                                  GstPadDirection direction, GstCaps *caps,
+                                                  gsize size, GstCaps *othercaps,
+                                                  gsize *othersize);
+static gboolean gst_zed_height_map_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                            GstCaps *outcaps);
+static gboolean gst_zed_height_map_sink_event(GstBaseTransform *base, GstEvent *event);
+static gboolean gst_zed_height_map_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                  GstMeta *meta, GstBuffer *inbuf);
+static GstFlowReturn gst_zed_height_map_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                  GstBuffer *outbuf);
+static gboolean gst_zed_height_map_stop(GstBaseTransform *base);
+
+static void gst_zed_height_map_class_init(GstZedHeightMapClass *klass) {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass *gstelement_class = GST_ELEMENT_CLASS(klass);
+    GstBaseTransformClass *trans_class = GST_BASE_TRANSFORM_CLASS(klass);
+
+    gobject_class->set_property = gst_zed_height_map_set_property;
+    gobject_class->get_property = gst_zed_height_map_get_property;
+    gobject_class->finalize = gst_zed_height_map_finalize;
+
+    g_object_class_install_property(
+        gobject_class, PROP_CALIBRATION_FILE,
+        g_param_spec_string("calibration-file", "Calibration file",
+                            "ZED calibration file (SN<serial>.conf) or OpenCV calibration file "
+                            "(YAML with Size and K_LEFT) used when no intrinsics are given by the "
+                            "caps or the fx/fy properties",
+                            DEFAULT_PROP_CALIBRATION_FILE,
+                            (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_FX,
+        g_param_spec_float("fx", "Horizontal focal length",
+                           "Horizontal focal length of the depth map in pixels, 0 to use the "
+                           "calibration file",
+                           0.f, G_MAXFLOAT, DEFAULT_PROP_INTRINSIC,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_FY,
+        g_param_spec_float("fy", "Vertical focal length",
+                           "Vertical focal length of the depth map in pixels, 0 to use the "
+                           "calibration file",
+                           0.f, G_MAXFLOAT, DEFAULT_PROP_INTRINSIC,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_CX,
+        g_param_spec_float("cx", "Principal point X",
+                           "Horizontal position of the principal point in pixels, 0 for the "
+                           "center of the depth map",
+                           0.f, G_MAXFLOAT, DEFAULT_PROP_INTRINSIC,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_CY,
+        g_param_spec_float("cy", "Principal point Y",
+                           "Vertical position of the principal point in pixels, 0 for the "
+                           "center of the depth map",
+                           0.f, G_MAXFLOAT, DEFAULT_PROP_INTRINSIC,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_COORD_SYS,
+        g_param_spec_enum("coordinate-system", "SDK Coordinate System",
+                          "Coordinate system of the pose, as set on zedsrc",
+                          GST_TYPE_ZED_HEIGHT_MAP_COORD_SYS, DEFAULT_PROP_COORD_SYS,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_RESOLUTION,
+        g_param_spec_float("resolution", "Resolution", "Size of the cells of the map in meters",
+                           0.01f, 10.f, DEFAULT_PROP_RESOLUTION,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_SIZE,
+        g_param_spec_float("size", "Size",
+                           "Side of the square area mapped around the camera in meters, rounded "
+                           "up to chunks of 32 cells",
+                           1.f, 10000.f, DEFAULT_PROP_SIZE,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_MIN_HEIGHT,
+        g_param_spec_float("min-height", "Minimum height",
+                           "Lowest height mapped, in meters above the world origin", -1000.f,
+                           1000.f, DEFAULT_PROP_MIN_HEIGHT,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_MAX_HEIGHT,
+        g_param_spec_float("max-height", "Maximum height",
+                           "Highest height mapped, in meters above the world origin. Higher "
+                           "points, as ceilings, are ignored",
+                           -1000.f, 1000.f, DEFAULT_PROP_MAX_HEIGHT,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_MAX_RANGE,
+        g_param_spec_float("max-range", "Maximum range",
+                           "Farthest depth used to update the map in meters", 0.1f, 65.f,
+                           DEFAULT_PROP_MAX_RANGE,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_OUTPUT_RATE,
+        g_param_spec_double("output-rate", "Output rate",
+                            "Rate of the output maps in Hz, 0 to output a map for every depth "
+                            "map. The map is updated with every depth map in any case",
+                            0.0, 1000.0, DEFAULT_PROP_OUTPUT_RATE,
+                            (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    gst_element_class_set_static_metadata(
+        gstelement_class, "ZED Height Map", "Filter/Converter/Video",
+        "Build a rolling 2.5D height map around the camera from depth maps and ZED poses",
+        "Stereolabs <support@stereolabs.com>");
+
+    gst_element_class_add_static_pad_template(gstelement_class, &sink_template);
+    gst_element_class_add_static_pad_template(gstelement_class, &src_template);
+
+    trans_class->transform_caps = GST_DEBUG_FUNCPTR(gst_zed_height_map_transform_caps);
+    trans_class->transform_size = GST_DEBUG_FUNCPTR(gst_zed_height_map_transform_size);
+    trans_class->set_caps = GST_DEBUG_FUNCPTR(gst_zed_height_map_set_caps);
+    trans_class->sink_event = GST_DEBUG_FUNCPTR(gst_zed_height_map_sink_event);
+    trans_class->transform_meta = GST_DEBUG_FUNCPTR(gst_zed_height_map_transform_meta);
+    trans_class->transform = GST_DEBUG_FUNCPTR(gst_zed_height_map_transform);
+    trans_class->stop = GST_DEBUG_FUNCPTR(gst_zed_height_map_stop);
+    trans_class->passthrough_on_same_caps = FALSE;
+
+    GST_DEBUG_CATEGORY_INIT(gst_zed_height_map_debug, "zedheightmap", 0, "ZED Height Map");
+}
+
+static void gst_zed_height_map_init(GstZedHeightMap *map) {
+    gst_video_info_init(&map->in_info);
+    gst_video_info_init(&map->out_info);
+    map->image_output = TRUE;
+
+    map->ray_x = NULL;
+    map->ray_y = NULL;
+
+    map->chunks = 0;
+    map->cell_size = DEFAULT_PROP_RESOLUTION;
+    map->arena = NULL;
+    map->slot_coords = NULL;
+    map->window[0] = 0;
+    map->window[1] = 0;
+    map->stamp = 0;
+    map->next_output = GST_CLOCK_TIME_NONE;
+    map->pose_warned = FALSE;
+
+    map->calibration_file = g_string_new(DEFAULT_PROP_CALIBRATION_FILE);
+    map->fx = DEFAULT_PROP_INTRINSIC;
+    map->fy = DEFAULT_PROP_INTRINSIC;
+    map->cx = DEFAULT_PROP_INTRINSIC;
+    map->cy = DEFAULT_PROP_INTRINSIC;
+    map->coord_sys = DEFAULT_PROP_COORD_SYS;
+    map->resolution = DEFAULT_PROP_RESOLUTION;
+    map->size = DEFAULT_PROP_SIZE;
+    map->min_height = DEFAULT_PROP_MIN_HEIGHT;
+    map->max_height = DEFAULT_PROP_MAX_HEIGHT;
+    map->max_range = DEFAULT_PROP_MAX_RANGE;
+    map->output_rate = DEFAULT_PROP_OUTPUT_RATE;
+}
+
+static void free_buffers(GstZedHeightMap *map) {
+    g_free(map->ray_x);
+    map->ray_x = NULL;
+    g_free(map->ray_y);
+    map->ray_y = NULL;
+    g_free(map->arena);
+    map->arena = NULL;
+    g_free(map->slot_coords);
+    map->slot_coords = NULL;
+    map->chunks = 0;
+}
+
+static void gst_zed_height_map_finalize(GObject *object) {
+    GstZedHeightMap *map = GST_ZED_HEIGHT_MAP(object);
+
+    free_buffers(map);
+    g_string_free(map->calibration_file, TRUE);
+
+    G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
+static void gst_zed_height_map_set_property(GObject *object, guint prop_id, const GValue *value,
+                                            GParamSpec *pspec) {
+    GstZedHeightMap *map = GST_ZED_HEIGHT_MAP(object);
+    gboolean reconfigure = FALSE;
+    const gchar *str;
+
+    GST_OBJECT_LOCK(map);
+    switch (prop_id) {
+    case PROP_CALIBRATION_FILE:
+        str = g_value_get_string(value);
+        g_string_assign(map->calibration_file, str ? str : "");
+        break;
+    case PROP_FX:
+        map->fx = g_value_get_float(value);
+        break;
+    case PROP_FY:
+        map->fy = g_value_get_float(value);
+        break;
+    case PROP_CX:
+        map->cx = g_value_get_float(value);
+        break;
+    case PROP_CY:
+        map->cy = g_value_get_float(value);
+        break;
+    case PROP_COORD_SYS:
+        map->coord_sys = g_value_get_enum(value);
+        break;
+    case PROP_RESOLUTION:
+        map->resolution = g_value_get_float(value);
+        reconfigure = TRUE;
+        break;
+    case PROP_SIZE:
+        map->size = g_value_get_float(value);
+        reconfigure = TRUE;
+        break;
+    case PROP_MIN_HEIGHT:
+        map->min_height = g_value_get_float(value);
+        break;
+    case PROP_MAX_HEIGHT:
+        map->max_height = g_value_get_float(value);
+        break;
+    case PROP_MAX_RANGE:
+        map->max_range = g_value_get_float(value);
+        break;
+    case PROP_OUTPUT_RATE:
+        map->output_rate = g_value_get_double(value);
+        reconfigure = TRUE;
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(map);
+
+    // The output size and rate follow the properties
+    if (reconfigure) {
+        gst_pad_mark_reconfigure(GST_BASE_TRANSFORM_SRC_PAD(map));
+    }
+}
+
+static void gst_zed_height_map_get_property(GObject *object, guint prop_id, GValue *value,
+                                            GParamSpec *pspec) {
+    GstZedHeightMap *map = GST_ZED_HEIGHT_MAP(object);
+
+    GST_OBJECT_LOCK(map);
+    switch (prop_id) {
+    case PROP_CALIBRATION_FILE:
+        g_value_set_string(value, map->calibration_file->str);
+        break;
+    case PROP_FX:
+        g_value_set_float(value, map->fx);
+        break;
+    case PROP_FY:
+        g_value_set_float(value, map->fy);
+        break;
+    case PROP_CX:
+        g_value_set_float(value, map->cx);
+        break;
+    case PROP_CY:
+        g_value_set_float(value, map->cy);
+        break;
+    case PROP_COORD_SYS:
+        g_value_set_enum(value, map->coord_sys);
+        break;
+    case PROP_RESOLUTION:
+        g_value_set_float(value, map->resolution);
+        break;
+    case PROP_SIZE:
+        g_value_set_float(value, map->size);
+        break;
+    case PROP_MIN_HEIGHT:
+        g_value_set_float(value, map->min_height);
+        break;
+    case PROP_MAX_HEIGHT:
+        g_value_set_float(value, map->max_height);
+        break;
+    case PROP_MAX_RANGE:
+        g_value_set_float(value, map->max_range);
+        break;
+    case PROP_OUTPUT_RATE:
+        g_value_set_double(value, map->output_rate);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(map);
+}
+
+static GstCaps *gst_zed_height_map_transform_caps(GstBaseTransform *base,
+                                                  GstPadDirection direction, GstCaps *caps,
+                                                  GstCaps *filter) {
+    GstZedHeightMap *map = GST_ZED_HEIGHT_MAP(base);
+    GstCaps *res = gst_caps_new_empty();
+
+    GST_OBJECT_LOCK(map);
+    guint chunks = (guint) ceilf(map->size / map->resolution / CHUNK);
+    gdouble rate = map->output_rate;
+    GST_OBJECT_UNLOCK(map);
+    gint cells = (gint) CLAMP(chunks, 1, MAX_CHUNKS) * CHUNK;
+
+    // Outputs decimated in time have their own frame rate
+    gint rate_n = 0, rate_d = 1;
+    if (rate > 0.0) {
+        gst_util_double_to_fraction(rate, &rate_n, &rate_d);
+    }
+
+    for (guint i = 0; i < gst_caps_get_size(caps); i++) {
+        const GValue *framerate = gst_structure_get_value(gst_caps_get_structure(caps, i),
+                                                          "framerate");
+        GstStructure *out[2];
+        guint count;
+
+        if (direction == GST_PAD_SINK) {
+            out[0] = gst_structure_new("video/x-raw", "format", G_TYPE_STRING, "GRAY16_LE",
+                                       "width", G_TYPE_INT, cells, "height", G_TYPE_INT, cells,
+                                       NULL);
+            out[1] = gst_structure_new(GST_ZED_HEIGHT_MAP_CAPS_NAME, "width", G_TYPE_INT, cells,
+                                       "height", G_TYPE_INT, cells, NULL);
+            count = 2;
+        } else {
+            out[0] = gst_structure_new("video/x-raw", "format", G_TYPE_STRING, "GRAY16_LE",
+                                       "width", GST_TYPE_INT_RANGE, 1, 8192, "height",
+                                       GST_TYPE_INT_RANGE, 1, 8192, NULL);
+            count = 1;
+        }
+
+        for (guint j = 0; j < count; j++) {
+            if (rate > 0.0 && direction == GST_PAD_SINK) {
+                gst_structure_set(out[j], "framerate", GST_TYPE_FRACTION, rate_n, rate_d, NULL);
+            } else if (rate > 0.0) {
+                gst_structure_set(out[j], "framerate", GST_TYPE_FRACTION_RANGE, 0, 1, G_MAXINT,
+                                  1, NULL);
+            } else if (framerate) {
+                gst_structure_set_value(out[j], "framerate", framerate);
+            }
+            res = gst_caps_merge_structure(res, out[j]);
+        }
+    }
+
+    if (filter) {
+        GstCaps *tmp = gst_caps_intersect_full(filter, res, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref(res);
+        res = tmp;
+    }
+
+    GST_DEBUG_OBJECT(base, "Transformed %" GST_PTR_FORMAT " into %" GST_PTR_FORMAT, caps, res);
+    return res;
+}
+
+static gboolean gst_zed_height_map_transform_size(GstBaseTransform *base,
+                                                  GstPadDirection direction, GstCaps *caps,
+                                                  gsize size, GstCaps *othercaps,
+                                                  gsize *othersize) {
+    const GstStructure *s = gst_caps_get_structure(othercaps, 0);
+    gint width, height;
+
+    if (direction != GST_PAD_SINK || !gst_structure_get_int(s, "width", &width) ||
+        !gst_structure_get_int(s, "height", &height)) {
+        return FALSE;
+    }
+
+    if (gst_structure_has_name(s, GST_ZED_HEIGHT_MAP_CAPS_NAME)) {
+        *othersize = sizeof(GstZedHeightMapHeader) + (gsize) width * height * sizeof(gfloat);
+        return TRUE;
+    }
+
+    GstVideoInfo vinfo;
+    if (!gst_video_info_from_caps(&vinfo, othercaps)) {
+        return FALSE;
+    }
+    *othersize = GST_VIDEO_INFO_SIZE(&vinfo);
+    return TRUE;
+}
+
+static void reset_map(GstZedHeightMap *map) {
+    for (guint s = 0; s < map->chunks * map->chunks; s++) {
+        map->slot_coords[2 * s] = G_MININT32;
+        map->slot_coords[2 * s + 1] = G_MININT32;
+    }
+    map->stamp = 0;
+    map->next_output = GST_CLOCK_TIME_NONE;
+}
+
+static gboolean gst_zed_height_map_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                            GstCaps *outcaps) {
+    GstZedHeightMap *map = GST_ZED_HEIGHT_MAP(base);
+    const GstStructure *out_s = gst_caps_get_structure(outcaps, 0);
+    gint cells;
+
+    if (!gst_video_info_from_caps(&map->in_info, incaps) ||
+        !gst_structure_get_int(out_s, "width", &cells)) {
+        GST_ERROR_OBJECT(map, "Invalid caps %" GST_PTR_FORMAT " -> %" GST_PTR_FORMAT, incaps,
+                         outcaps);
+        return FALSE;
+    }
+    map->image_output = gst_structure_has_name(out_s, "video/x-raw");
+    if (map->image_output && !gst_video_info_from_caps(&map->out_info, outcaps)) {
+        GST_ERROR_OBJECT(map, "Invalid output caps %" GST_PTR_FORMAT, outcaps);
+        return FALSE;
+    }
+
+    guint width = GST_VIDEO_INFO_WIDTH(&map->in_info);
+    guint height = GST_VIDEO_INFO_HEIGHT(&map->in_info);
+
+    GST_OBJECT_LOCK(map);
+    gfloat props[4] = {map->fx, map->fy, map->cx, map->cy};
+    gchar *path = g_strdup(map->calibration_file->str);
+    gfloat resolution = map->resolution;
+    GST_OBJECT_UNLOCK(map);
+
+    gfloat k[4];
+    gboolean ok = gst_zed_calibration_get_intrinsics(
+        GST_ELEMENT(map), gst_caps_get_structure(incaps, 0), width, height, props, path, k);
+    g_free(path);
+    if (!ok) {
+        return FALSE;
+    }
+
+    free_buffers(map);
+    map->ray_x = (gfloat *) g_malloc(width * sizeof(gfloat));
+    map->ray_y = (gfloat *) g_malloc(height * sizeof(gfloat));
+    for (guint x = 0; x < width; x++) {
+        map->ray_x[x] = (x - k[2]) / k[0];
+    }
+    for (guint y = 0; y < height; y++) {
+        map->ray_y[y] = (y - k[3]) / k[1];
+    }
+
+    map->chunks = (guint) cells / CHUNK;
+    map->cell_size = resolution;
+    map->arena = (GstZedHeightMapCell *) g_malloc((gsize) map->chunks * map->chunks * CHUNK *
+                                                  CHUNK * sizeof(GstZedHeightMapCell));
+    map->slot_coords = (gint32 *) g_malloc((gsize) map->chunks * map->chunks * 2 *
+                                           sizeof(gint32));
+    reset_map(map);
+
+    GST_INFO_OBJECT(map, "%dx%d cells of %.3f m, %u chunks of %ux%u cells", cells, cells,
+                    resolution, map->chunks * map->chunks, CHUNK, CHUNK);
+    return TRUE;
+}
+
+static gboolean gst_zed_height_map_sink_event(GstBaseTransform *base, GstEvent *event) {
+    GstZedHeightMap *map = GST_ZED_HEIGHT_MAP(base);
+
+    if (GST_EVENT_TYPE(event) == GST_EVENT_FLUSH_STOP) {
+        map->next_output = GST_CLOCK_TIME_NONE;
+    }
+
+    return GST_BASE_TRANSFORM_CLASS(parent_class)->sink_event(base, event);
+}
+
+static gboolean gst_zed_height_map_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                  GstMeta *meta, GstBuffer *inbuf) {
+    // The pose of the camera stays valid for the map centered on it
+    GType api = meta->info->api;
+    if (api == GST_ZED_SRC_META_API_TYPE || api == GST_ZED_TIMING_META_API_TYPE) {
+        return TRUE;
+    }
+    return GST_BASE_TRANSFORM_CLASS(parent_class)->transform_meta(base, outbuf, meta, inbuf);
+}
+
+static inline gint32 floor_div(gint32 value, gint32 divisor) {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+static inline guint32 positive_mod(gint32 value, guint32 divisor) {
+    gint32 m = value % (gint32) divisor;
+    return (guint32) (m < 0 ? m + (gint32) divisor : m);
+}
+
+/* Camera to world rotation of the pose, the orientation being the Euler angles of
+ * sl::Rotation::getEulerAngles, applied as R = Rz * Ry * Rx.
+ */
+static void pose_rotation(const gfloat euler[3], gfloat r[3][3]) {
+    gfloat cx = cosf(euler[0]), sx = sinf(euler[0]);
+    gfloat cy = cosf(euler[1]), sy = sinf(euler[1]);
+    gfloat cz = cosf(euler[2]), sz = sinf(euler[2]);
+
+    r[0][0] = cz * cy;
+    r[0][1] = cz * sy * sx - sz * cx;
+    r[0][2] = cz * sy * cx + sz * sx;
+    r[1][0] = sz * cy;
+    r[1][1] = sz * sy * sx + cz * cx;
+    r[1][2] = sz * sy * cx - cz * sx;
+    r[2][0] = -sy;
+    r[2][1] = cy * sx;
+    r[2][2] = cy * cx;
+}
+
+/* Update the cells hit by the valid depths of `frame`: the first observation of a cell in a depth
+ * map replaces its height, the next ones of the same depth map keep the highest one. Only the
+ * cells seen by the camera are touched; the other cells keep their last height until their chunk
+ * leaves the window.
+ */
+static void update_map(GstZedHeightMap *map, GstVideoFrame *frame, const ZedPose *pose) {
+    GST_OBJECT_LOCK(map);
+    gint coord_sys = CLAMP(map->coord_sys, 0, (gint) G_N_ELEMENTS(coord_systems) - 1);
+    gfloat min_height = map->min_height;
+    gfloat max_height = map->max_height;
+    guint max_depth = (guint) (map->max_range * 1000.f);
+    GST_OBJECT_UNLOCK(map);
+
+    // World axes: the depth (image frame) is rotated into the coordinate system camera frame,
+    // then into the world frame; the positions are in millimeters
+    gfloat r[3][3], m[3][3], t[3];
+    pose_rotation(pose->orient, r);
+    for (guint i = 0; i < 3; i++) {
+        for (guint j = 0; j < 3; j++) {
+            m[i][j] = r[i][0] * coord_systems[coord_sys].cam[0][j] +
+                      r[i][1] * coord_systems[coord_sys].cam[1][j] +
+                      r[i][2] * coord_systems[coord_sys].cam[2][j];
+        }
+        t[i] = pose->pos[i] * 0.001f;
+    }
+    guint up = coord_systems[coord_sys].up;
+    guint ga = coord_systems[coord_sys].ground[0];
+    guint gb = coord_systems[coord_sys].ground[1];
+    // The IMAGE coordinate system has its Y axis pointing down
+    gfloat up_sign = coord_sys == 0 ? -1.f : 1.f;
+
+    // Re-center the window on the camera
+    gfloat inv_cell = 1.f / map->cell_size;
+    gint32 chunks = (gint32) map->chunks;
+    map->window[0] = floor_div((gint32) floorf(t[ga] * inv_cell), CHUNK) - chunks / 2;
+    map->window[1] = floor_div((gint32) floorf(t[gb] * inv_cell), CHUNK) - chunks / 2;
+
+    if (++map->stamp == 0) {
+        map->stamp = 1;   // 0 marks the cells never observed
+    }
+    guint32 stamp = map->stamp;
+
+    // Projections of the rays on the height and ground axes, per unit of depth
+    const gfloat *ray_x = map->ray_x;
+    for (guint y = 0; y < (guint) GST_VIDEO_FRAME_HEIGHT(frame); y++) {
+        const guint16 *depth = (const guint16 *) ((const guint8 *) GST_VIDEO_FRAME_PLANE_DATA(
+                                                      frame, 0) +
+                                                  y * GST_VIDEO_FRAME_PLANE_STRIDE(frame, 0));
+        gfloat ry = map->ray_y[y];
+        gfloat row_h = up_sign * (m[up][1] * ry + m[up][2]);
+        gfloat row_a = m[ga][1] * ry + m[ga][2];
+        gfloat row_b = m[gb][1] * ry + m[gb][2];
+
+        for (guint x = 0; x < (guint) GST_VIDEO_FRAME_WIDTH(frame); x++) {
+            guint d = depth[x];
+            if (d == 0 || d > max_depth) {
+                continue;
+            }
+            gfloat z = d * 0.001f;
+            gfloat h = z * (up_sign * m[up][0] * ray_x[x] + row_h) + up_sign * t[up];
+            if (h < min_height || h > max_height) {
+                continue;
+            }
+
+            gint32 ca = (gint32) floorf((z * (m[ga][0] * ray_x[x] + row_a) + t[ga]) * inv_cell);
+            gint32 cb = (gint32) floorf((z * (m[gb][0] * ray_x[x] + row_b) + t[gb]) * inv_cell);
+            gint32 ka = floor_div(ca, CHUNK);
+            gint32 kb = floor_div(cb, CHUNK);
+            if ((guint32) (ka - map->window[0]) >= (guint32) chunks ||
+                (guint32) (kb - map->window[1]) >= (guint32) chunks) {
+                continue;
+            }
+
+            // Recycle the slot when it still holds a chunk that left the window
+            guint32 slot = positive_mod(ka, chunks) + positive_mod(kb, chunks) * chunks;
+            GstZedHeightMapCell *cells = map->arena + (gsize) slot * CHUNK * CHUNK;
+            if (map->slot_coords[2 * slot] != ka || map->slot_coords[2 * slot + 1] != kb) {
+                for (guint c = 0; c < CHUNK * CHUNK; c++) {
+                    cells[c].stamp = 0;
+                }
+                map->slot_coords[2 * slot] = ka;
+                map->slot_coords[2 * slot + 1] = kb;
+            }
+
+            GstZedHeightMapCell *cell = &cells[(cb - kb * CHUNK) * CHUNK + (ca - ka * CHUNK)];
+            if (cell->stamp != stamp) {
+                cell->stamp = stamp;
+                cell->height = h;
+            } else if (h > cell->height) {
+                cell->height = h;
+            }
+        }
+    }
+}
+
+/* Write the window, chunk by chunk, as GRAY16_LE heights in millimeters offset by 32768 (0 for
+ * the unknown cells) or as float32 heights in meters (NaN for the unknown cells).
+ */
+static void render_map(GstZedHeightMap *map, guint8 *data, gsize stride) {
+    gint32 chunks = (gint32) map->chunks;
+
+    for (gint32 kb = 0; kb < chunks; kb++) {
+        for (gint32 ka = 0; ka < chunks; ka++) {
+            gint32 wa = map->window[0] + ka;
+            gint32 wb = map->window[1] + kb;
+            guint32 slot = positive_mod(wa, chunks) + positive_mod(wb, chunks) * chunks;
+            gboolean valid =
+                map->slot_coords[2 * slot] == wa && map->slot_coords[2 * slot + 1] == wb;
+            const GstZedHeightMapCell *cells = map->arena + (gsize) slot * CHUNK * CHUNK;
+
+            for (guint lb = 0; lb < CHUNK; lb++) {
+                guint8 *row = data + ((gsize) kb * CHUNK + lb) * stride;
+                const GstZedHeightMapCell *src = cells + lb * CHUNK;
+
+                if (map->image_output) {
+                    guint16 *dst = (guint16 *) row + ka * CHUNK;
+                    for (guint la = 0; la < CHUNK; la++) {
+                        if (!valid || src[la].stamp == 0) {
+                            dst[la] = 0;
+                            continue;
+                        }
+                        gint v = (gint) lrintf(src[la].height * 1000.f) + 32768;
+                        dst[la] = (guint16) CLAMP(v, 1, G_MAXUINT16);
+                    }
+                } else {
+                    gfloat *dst = (gfloat *) row + ka * CHUNK;
+                    for (guint la = 0; la < CHUNK; la++) {
+                        dst[la] = valid && src[la].stamp != 0 ? src[la].height : NAN;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static GstFlowReturn gst_zed_height_map_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                  GstBuffer *outbuf) {
+    GstZedHeightMap *map = GST_ZED_HEIGHT_MAP(base);
+
+    GST_OBJECT_LOCK(map);
+    gdouble rate = map->output_rate;
+    GST_OBJECT_UNLOCK(map);
+
+    // ----> Map update
+    GstZedSrcMeta *meta = gst_buffer_get_zed_src_meta(inbuf);
+    if (meta && meta->pose.pose_avail && meta->pose.pos_tracking_state == POS_TRACKING_STATE_OK) {
+        GstVideoFrame frame;
+        if (!gst_video_frame_map(&frame, &map->in_info, inbuf, GST_MAP_READ)) {
+            GST_ELEMENT_ERROR(map, RESOURCE, FAILED, ("Failed to map input buffer"), (NULL));
+            return GST_FLOW_ERROR;
+        }
+        update_map(map, &frame, &meta->pose);
+        gst_video_frame_unmap(&frame);
+    } else if (!map->pose_warned) {
+        GST_WARNING_OBJECT(map, "No valid pose in the ZED metadata, the map is not updated. "
+                                "Enable the positional tracking of zedsrc");
+        map->pose_warned = TRUE;
+    }
+    // <---- Map update
+
+    // ----> Output rate
+    GstClockTime pts = GST_BUFFER_PTS(inbuf);
+    if (rate > 0.0 && GST_CLOCK_TIME_IS_VALID(pts)) {
+        if (GST_CLOCK_TIME_IS_VALID(map->next_output) && pts < map->next_output) {
+            return GST_BASE_TRANSFORM_FLOW_DROPPED;
+        }
+        map->next_output = pts + (GstClockTime) (GST_SECOND / rate);
+    }
+    // <---- Output rate
+
+    if (map->image_output) {
+        GstVideoFrame out_frame;
+        if (!gst_video_frame_map(&out_frame, &map->out_info, outbuf, GST_MAP_WRITE)) {
+            GST_ELEMENT_ERROR(map, RESOURCE, FAILED, ("Failed to map output buffer"), (NULL));
+            return GST_FLOW_ERROR;
+        }
+        render_map(map, (guint8 *) GST_VIDEO_FRAME_PLANE_DATA(&out_frame, 0),
+                   GST_VIDEO_FRAME_PLANE_STRIDE(&out_frame, 0));
+        gst_video_frame_unmap(&out_frame);
+        return GST_FLOW_OK;
+    }
+
+    GstMapInfo out_map;
+    if (!gst_buffer_map(outbuf, &out_map, GST_MAP_WRITE)) {
+        GST_ELEMENT_ERROR(map, RESOURCE, FAILED, ("Failed to map output buffer"), (NULL));
+        return GST_FLOW_ERROR;
+    }
+    guint cells = map->chunks * CHUNK;
+    GstZedHeightMapHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GST_ZED_HEIGHT_MAP_MAGIC, sizeof(header.magic));
+    header.width = GUINT32_TO_LE(cells);
+    header.height = GUINT32_TO_LE(cells);
+    header.resolution = map->cell_size;
+    header.origin[0] = map->window[0] * CHUNK * map->cell_size;
+    header.origin[1] = map->window[1] * CHUNK * map->cell_size;
+    memcpy(out_map.data, &header, sizeof(header));
+    render_map(map, out_map.data + sizeof(header), cells * sizeof(gfloat));
+    gst_buffer_unmap(outbuf, &out_map);
+
+    return GST_FLOW_OK;
+}
+
+static gboolean gst_zed_height_map_stop(GstBaseTransform *base) {
+    GstZedHeightMap *map = GST_ZED_HEIGHT_MAP(base);
+
+    free_buffers(map);
+    map->pose_warned = FALSE;
+    return TRUE;
+}
@@ -0,0 +1,99 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef __GST_ZED_HEIGHT_MAP_H__
+#define __GST_ZED_HEIGHT_MAP_H__
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+/* Height map buffers: a GstZedHeightMapHeader followed by `height` rows of `width` little endian
+ * float32 heights in meters, NaN for the cells never observed. Cell (i, j) covers
+ * [origin[0] + i * resolution, origin[0] + (i + 1) * resolution) on the first ground axis and
+ * [origin[1] + j * resolution, origin[1] + (j + 1) * resolution) on the second one.
+ */
+#define GST_ZED_HEIGHT_MAP_CAPS_NAME "application/x-zed-height-map"
+#define GST_ZED_HEIGHT_MAP_MAGIC "ZHMP"
+
+typedef struct {
+    gchar magic[4];
+    guint32 width;       // cells on the first ground axis
+    guint32 height;      // cells on the second ground axis
+    gfloat resolution;   // cell size [m]
+    gfloat origin[2];    // world ground coordinates of the corner of the cell (0, 0) [m]
+    guint32 reserved[2];
+} GstZedHeightMapHeader;
+
+// Side of the square chunks of cells the map is made of
+#define GST_ZED_HEIGHT_MAP_CHUNK 32
+
+typedef struct {
+    gfloat height;
+    guint32 stamp;   // update of the last observation, 0 if never observed
+} GstZedHeightMapCell;
+
+#define GST_TYPE_ZED_HEIGHT_MAP (gst_zed_height_map_get_type())
+G_DECLARE_FINAL_TYPE(GstZedHeightMap, gst_zed_height_map, GST, ZED_HEIGHT_MAP, GstBaseTransform)
+
+struct _GstZedHeightMap {
+    GstBaseTransform element;
+
+    GstVideoInfo in_info;
+    GstVideoInfo out_info;
+    gboolean image_output;   // GRAY16_LE image instead of the float32 stream
+
+    // Normalized image coordinates, (u - cx) / fx per column and (v - cy) / fy per row
+    gfloat *ray_x;
+    gfloat *ray_y;
+
+    // Rolling window of `chunks` x `chunks` chunks centered on the camera. The cells of a chunk
+    // are contiguous in `arena`; the world chunk (a, b) lives in the slot
+    // (a mod chunks, b mod chunks), recycled when the window moves past it.
+    guint chunks;
+    gfloat cell_size;
+    GstZedHeightMapCell *arena;
+    gint32 *slot_coords;   // world chunk coordinates held by each slot, 2 per slot
+    gint32 window[2];      // world chunk coordinates of the first chunk of the window
+    guint32 stamp;
+    GstClockTime next_output;
+    gboolean pose_warned;
+
+    // Properties
+    GString *calibration_file;
+    gfloat fx;
+    gfloat fy;
+    gfloat cx;
+    gfloat cy;
+    gint coord_sys;
+    gfloat resolution;
+    gfloat size;
+    gfloat min_height;
+    gfloat max_height;
+    gfloat max_range;
+    gdouble output_rate;
+};
+
+G_END_DECLS
+
+#endif /* __GST_ZED_HEIGHT_MAP_H__ */
@@ -0,0 +1,664 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzedpointcloud.h"
+
+#include <string.h>
+
+#include "gst-zed-meta/gstzedmeta.h"
+#include "gst-zed-meta/gstzedtimingmeta.h"
+#include "gstzedcalibration.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_zed_point_cloud_debug);
+#define GST_CAT_DEFAULT gst_zed_point_cloud_debug
+
+enum {
+    PROP_0,
+    PROP_CALIBRATION_FILE,
+    PROP_FX,
+    PROP_FY,
+    PROP_CX,
+    PROP_CY,
+    PROP_MAX_DEPTH,
+    PROP_VOXEL_SIZE,
+    PROP_THREADS,
+};
+
+#define DEFAULT_PROP_CALIBRATION_FILE ""
+#define DEFAULT_PROP_INTRINSIC 0.f
+#define DEFAULT_PROP_MAX_DEPTH 20000
+#define DEFAULT_PROP_VOXEL_SIZE 0.f
+#define DEFAULT_PROP_THREADS 1
+
+#define MAX_THREADS 64
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE(
+    "sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS("video/x-raw, "
+                    "format = (string){ GRAY16_LE, BGRA }, "
+                    "width = (int)[ 1, 8192 ], "
+                    "height = (int)[ 1, 8192 ], "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE(
+    "src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS(GST_ZED_POINT_CLOUD_CAPS_NAME ", "
+                    "format = (string){ XYZ, XYZRGB }, "
+                    "framerate = (fraction)[ 0/1, MAX ]"));
+
+// Rows of the frame converted by one thread
+typedef struct {
+    GstZedPointCloud *pc;
+    const guint8 *data;
+    gsize stride;
+    guint max_depth;
+    gfloat *out;   // room for one point per pixel of the band
+    guint y_begin;
+    guint y_end;
+    guint count;   // points written to `out`
+} GstZedPointCloudBand;
+
+#define gst_zed_point_cloud_parent_class parent_class
+G_DEFINE_TYPE(GstZedPointCloud, gst_zed_point_cloud, GST_TYPE_BASE_TRANSFORM);
+
+static void gst_zed_point_cloud_set_property(GObject *object, guint prop_id, const GValue *value,
+                                             GParamSpec *pspec);
+static void gst_zed_point_cloud_get_property(GObject *object, guint prop_id, GValue *value,
+                                             GParamSpec *pspec);
+static void gst_zed_point_cloud_finalize(GObject *object);
+
+static GstCaps *gst_zed_point_cloud_transform_caps(GstBaseTransform *base,
+                                                   GstPadDirection direction, GstCaps *caps,
+                                                   GstCaps *filter);
+static gboolean gst_zed_point_cloud_transform_size(GstBaseTransform *base,
+                                                   GstPadDirection direction, GstCaps *caps,
+                                                   gsize size, GstCaps *othercaps,
+                                                   gsize *othersize);
+static gboolean gst_zed_point_cloud_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                             GstCaps *outcaps);
+static gboolean gst_zed_point_cloud_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                   GstMeta *meta, GstBuffer *inbuf);
+static GstFlowReturn gst_zed_point_cloud_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                   GstBuffer *outbuf);
+static gboolean gst_zed_point_cloud_stop(GstBaseTransform *base);
+
+static void ensure_pool(GstZedPointCloud *pc, guint threads);
+static guint run_bands(GstZedPointCloud *pc, GstVideoFrame *frame, guint max_depth,
+                       gfloat *points);
+
+static void gst_zed_point_cloud_class_init(GstZedPointCloudClass *klass) {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass *gstelement_class = GST_ELEMENT_CLASS(klass);
+    GstBaseTransformClass *trans_class = GST_BASE_TRANSFORM_CLASS(klass);
+
+    gobject_class->set_property = gst_zed_point_cloud_set_property;
+    gobject_class->get_property = gst_zed_point_cloud_get_property;
+    gobject_class->finalize = gst_zed_point_cloud_finalize;
+
+    g_object_class_install_property(
+        gobject_class, PROP_CALIBRATION_FILE,
+        g_param_spec_string("calibration-file", "Calibration file",
+                            "ZED calibration file (SN<serial>.conf) or OpenCV calibration file "
+                            "(YAML with Size and K_LEFT) used when no intrinsics are given by the "
+                            "caps or the fx/fy properties",
+                            DEFAULT_PROP_CALIBRATION_FILE,
+                            (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_FX,
+        g_param_spec_float("fx", "Horizontal focal length",
+                           "Horizontal focal length of the depth map in pixels, 0 to use the "
+                           "calibration file",
+                           0.f, G_MAXFLOAT, DEFAULT_PROP_INTRINSIC,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_FY,
+        g_param_spec_float("fy", "Vertical focal length",
+                           "Vertical focal length of the depth map in pixels, 0 to use the "
+                           "calibration file",
+                           0.f, G_MAXFLOAT, DEFAULT_PROP_INTRINSIC,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_CX,
+        g_param_spec_float("cx", "Principal point X",
+                           "Horizontal position of the principal point in pixels, 0 for the "
+                           "center of the depth map",
+                           0.f, G_MAXFLOAT, DEFAULT_PROP_INTRINSIC,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_CY,
+        g_param_spec_float("cy", "Principal point Y",
+                           "Vertical position of the principal point in pixels, 0 for the "
+                           "center of the depth map",
+                           0.f, G_MAXFLOAT, DEFAULT_PROP_INTRINSIC,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_MAX_DEPTH,
+        g_param_spec_uint("max-depth", "Maximum depth",
+                          "Farthest depth converted to a point, in millimeters", 1, G_MAXUINT16,
+                          DEFAULT_PROP_MAX_DEPTH,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_VOXEL_SIZE,
+        g_param_spec_float("voxel-size", "Voxel size",
+                           "Size of the voxel grid downsampling in meters, the points of a voxel "
+                           "being replaced by their centroid. 0 to disable the downsampling",
+                           0.f, 10.f, DEFAULT_PROP_VOXEL_SIZE,
+                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_THREADS,
+        g_param_spec_uint("threads", "Threads",
+                          "Number of threads generating the points, each one processing a "
+                          "horizontal band of the depth map",
+                          1, MAX_THREADS, DEFAULT_PROP_THREADS,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    gst_element_class_set_static_metadata(
+        gstelement_class, "ZED Point Cloud", "Filter/Converter/Video",
+        "Convert ZED depth maps into XYZ or XYZRGB point clouds",
+        "Stereolabs <support@stereolabs.com>");
+
+    gst_element_class_add_static_pad_template(gstelement_class, &sink_template);
+    gst_element_class_add_static_pad_template(gstelement_class, &src_template);
+
+    trans_class->transform_caps = GST_DEBUG_FUNCPTR(gst_zed_point_cloud_transform_caps);
+    trans_class->transform_size = GST_DEBUG_FUNCPTR(gst_zed_point_cloud_transform_size);
+    trans_class->set_caps = GST_DEBUG_FUNCPTR(gst_zed_point_cloud_set_caps);
+    trans_class->transform_meta = GST_DEBUG_FUNCPTR(gst_zed_point_cloud_transform_meta);
+    trans_class->transform = GST_DEBUG_FUNCPTR(gst_zed_point_cloud_transform);
+    trans_class->stop = GST_DEBUG_FUNCPTR(gst_zed_point_cloud_stop);
+    trans_class->passthrough_on_same_caps = FALSE;
+
+    GST_DEBUG_CATEGORY_INIT(gst_zed_point_cloud_debug, "zedpointcloud", 0, "ZED Point Cloud");
+}
+
+static void gst_zed_point_cloud_init(GstZedPointCloud *pc) {
+    gst_video_info_init(&pc->vinfo);
+    pc->composite = FALSE;
+    pc->color = FALSE;
+    pc->width = 0;
+    pc->height = 0;
+
+    pc->ray_x = NULL;
+    pc->ray_y = NULL;
+    pc->scratch = NULL;
+    gst_zed_voxel_grid_init(&pc->grid);
+
+    pc->pool = NULL;
+    pc->pool_size = 0;
+    g_mutex_init(&pc->lock);
+    g_cond_init(&pc->cond);
+    pc->pending = 0;
+
+    pc->calibration_file = g_string_new(DEFAULT_PROP_CALIBRATION_FILE);
+    pc->fx = DEFAULT_PROP_INTRINSIC;
+    pc->fy = DEFAULT_PROP_INTRINSIC;
+    pc->cx = DEFAULT_PROP_INTRINSIC;
+    pc->cy = DEFAULT_PROP_INTRINSIC;
+    pc->max_depth = DEFAULT_PROP_MAX_DEPTH;
+    pc->voxel_size = DEFAULT_PROP_VOXEL_SIZE;
+    pc->threads = DEFAULT_PROP_THREADS;
+}
+
+static void free_buffers(GstZedPointCloud *pc) {
+    g_free(pc->ray_x);
+    pc->ray_x = NULL;
+    g_free(pc->ray_y);
+    pc->ray_y = NULL;
+    g_free(pc->scratch);
+    pc->scratch = NULL;
+    gst_zed_voxel_grid_clear(&pc->grid);
+}
+
+static void gst_zed_point_cloud_finalize(GObject *object) {
+    GstZedPointCloud *pc = GST_ZED_POINT_CLOUD(object);
+
+    if (pc->pool) {
+        g_thread_pool_free(pc->pool, FALSE, TRUE);
+        pc->pool = NULL;
+    }
+    g_mutex_clear(&pc->lock);
+    g_cond_clear(&pc->cond);
+    free_buffers(pc);
+    g_string_free(pc->calibration_file, TRUE);
+
+    G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
+static void gst_zed_point_cloud_set_property(GObject *object, guint prop_id, const GValue *value,
+                                             GParamSpec *pspec) {
+    GstZedPointCloud *pc = GST_ZED_POINT_CLOUD(object);
+    const gchar *str;
+
+    GST_OBJECT_LOCK(pc);
+    switch (prop_id) {
+    case PROP_CALIBRATION_FILE:
+        str = g_value_get_string(value);
+        g_string_assign(pc->calibration_file, str ? str : "");
+        break;
+    case PROP_FX:
+        pc->fx = g_value_get_float(value);
+        break;
+    case PROP_FY:
+        pc->fy = g_value_get_float(value);
+        break;
+    case PROP_CX:
+        pc->cx = g_value_get_float(value);
+        break;
+    case PROP_CY:
+        pc->cy = g_value_get_float(value);
+        break;
+    case PROP_MAX_DEPTH:
+        pc->max_depth = g_value_get_uint(value);
+        break;
+    case PROP_VOXEL_SIZE:
+        pc->voxel_size = g_value_get_float(value);
+        break;
+    case PROP_THREADS:
+        pc->threads = g_value_get_uint(value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(pc);
+}
+
+static void gst_zed_point_cloud_get_property(GObject *object, guint prop_id, GValue *value,
+                                             GParamSpec *pspec) {
+    GstZedPointCloud *pc = GST_ZED_POINT_CLOUD(object);
+
+    GST_OBJECT_LOCK(pc);
+    switch (prop_id) {
+    case PROP_CALIBRATION_FILE:
+        g_value_set_string(value, pc->calibration_file->str);
+        break;
+    case PROP_FX:
+        g_value_set_float(value, pc->fx);
+        break;
+    case PROP_FY:
+        g_value_set_float(value, pc->fy);
+        break;
+    case PROP_CX:
+        g_value_set_float(value, pc->cx);
+        break;
+    case PROP_CY:
+        g_value_set_float(value, pc->cy);
+        break;
+    case PROP_MAX_DEPTH:
+        g_value_set_uint(value, pc->max_depth);
+        break;
+    case PROP_VOXEL_SIZE:
+        g_value_set_float(value, pc->voxel_size);
+        break;
+    case PROP_THREADS:
+        g_value_set_uint(value, pc->threads);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+    GST_OBJECT_UNLOCK(pc);
+}
+
+static GstCaps *gst_zed_point_cloud_transform_caps(GstBaseTransform *base,
+                                                   GstPadDirection direction, GstCaps *caps,
+                                                   GstCaps *filter) {
+    GstCaps *res = gst_caps_new_empty();
+
+    for (guint i = 0; i < gst_caps_get_size(caps); i++) {
+        const GstStructure *s = gst_caps_get_structure(caps, i);
+        const gchar *format = gst_structure_get_string(s, "format");
+        const gchar *other;
+
+        // Only the composite BGRA stream carries the colors
+        if (direction == GST_PAD_SINK) {
+            other = g_strcmp0(format, "GRAY16_LE") == 0
+                        ? GST_ZED_POINT_CLOUD_CAPS_NAME ", format = (string)XYZ"
+                        : GST_ZED_POINT_CLOUD_CAPS_NAME ", format = (string){ XYZRGB, XYZ }";
+        } else {
+            other = g_strcmp0(format, "XYZRGB") == 0
+                        ? "video/x-raw, format = (string)BGRA, "
+                          "width = (int)[ 1, 8192 ], height = (int)[ 2, 8192 ]"
+                        : "video/x-raw, format = (string){ GRAY16_LE, BGRA }, "
+                          "width = (int)[ 1, 8192 ], height = (int)[ 1, 8192 ]";
+        }
+
+        GstStructure *out = gst_structure_from_string(other, NULL);
+        const GValue *framerate = gst_structure_get_value(s, "framerate");
+        if (framerate) {
+            gst_structure_set_value(out, "framerate", framerate);
+        }
+        res = gst_caps_merge_structure(res, out);
+    }
+
+    if (filter) {
+        GstCaps *tmp = gst_caps_intersect_full(filter, res, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref(res);
+        res = tmp;
+    }
+
+    GST_DEBUG_OBJECT(base, "Transformed %" GST_PTR_FORMAT " into %" GST_PTR_FORMAT, caps, res);
+    return res;
+}
+
+static gboolean gst_zed_point_cloud_transform_size(GstBaseTransform *base,
+                                                   GstPadDirection direction, GstCaps *caps,
+                                                   gsize size, GstCaps *othercaps,
+                                                   gsize *othersize) {
+    GstVideoInfo vinfo;
+
+    if (direction != GST_PAD_SINK || !gst_video_info_from_caps(&vinfo, caps)) {
+        return FALSE;
+    }
+
+    // Room for one point per pixel, the buffer is shrunk to the points actually generated
+    const gchar *format = gst_structure_get_string(gst_caps_get_structure(othercaps, 0), "format");
+    gsize pixels = (gsize) GST_VIDEO_INFO_WIDTH(&vinfo) * GST_VIDEO_INFO_HEIGHT(&vinfo);
+    if (GST_VIDEO_INFO_FORMAT(&vinfo) == GST_VIDEO_FORMAT_BGRA) {
+        pixels /= 2;
+    }
+    *othersize = pixels * (g_strcmp0(format, "XYZRGB") == 0 ? 4 : 3) * sizeof(gfloat);
+    return TRUE;
+}
+
+static gboolean gst_zed_point_cloud_set_caps(GstBaseTransform *base, GstCaps *incaps,
+                                             GstCaps *outcaps) {
+    GstZedPointCloud *pc = GST_ZED_POINT_CLOUD(base);
+
+    if (!gst_video_info_from_caps(&pc->vinfo, incaps)) {
+        GST_ERROR_OBJECT(pc, "Invalid input caps %" GST_PTR_FORMAT, incaps);
+        return FALSE;
+    }
+
+    const gchar *format = gst_structure_get_string(gst_caps_get_structure(outcaps, 0), "format");
+    pc->composite = GST_VIDEO_INFO_FORMAT(&pc->vinfo) == GST_VIDEO_FORMAT_BGRA;
+    pc->color = g_strcmp0(format, "XYZRGB") == 0;
+    pc->width = GST_VIDEO_INFO_WIDTH(&pc->vinfo);
+    pc->height = GST_VIDEO_INFO_HEIGHT(&pc->vinfo);
+
+    // The composite stream has the left image on the top half and the depth on the bottom half
+    if (pc->composite) {
+        if (pc->height % 2 != 0) {
+            GST_ERROR_OBJECT(pc, "Composite stream with an odd height: %u", pc->height);
+            return FALSE;
+        }
+        pc->height /= 2;
+    }
+
+    GST_OBJECT_LOCK(pc);
+    gfloat props[4] = {pc->fx, pc->fy, pc->cx, pc->cy};
+    gchar *path = g_strdup(pc->calibration_file->str);
+    GST_OBJECT_UNLOCK(pc);
+
+    gfloat k[4];
+    gboolean ok = gst_zed_calibration_get_intrinsics(
+        GST_ELEMENT(pc), gst_caps_get_structure(incaps, 0), pc->width, pc->height, props, path, k);
+    g_free(path);
+    if (!ok) {
+        return FALSE;
+    }
+    GST_INFO_OBJECT(pc, "%ux%u depth maps, fx %.2f fy %.2f cx %.2f cy %.2f", pc->width,
+                    pc->height, k[0], k[1], k[2], k[3]);
+
+    free_buffers(pc);
+    pc->ray_x = (gfloat *) g_malloc(pc->width * sizeof(gfloat));
+    pc->ray_y = (gfloat *) g_malloc(pc->height * sizeof(gfloat));
+    for (guint x = 0; x < pc->width; x++) {
+        pc->ray_x[x] = (x - k[2]) / k[0];
+    }
+    for (guint y = 0; y < pc->height; y++) {
+        pc->ray_y[y] = (y - k[3]) / k[1];
+    }
+
+    return TRUE;
+}
+
+static gboolean gst_zed_point_cloud_transform_meta(GstBaseTransform *base, GstBuffer *outbuf,
+                                                   GstMeta *meta, GstBuffer *inbuf) {
+    // The pose and sensors data stay valid for the points
+    GType api = meta->info->api;
+    if (api == GST_ZED_SRC_META_API_TYPE || api == GST_ZED_TIMING_META_API_TYPE) {
+        return TRUE;
+    }
+    return GST_BASE_TRANSFORM_CLASS(parent_class)->transform_meta(base, outbuf, meta, inbuf);
+}
+
+static GstFlowReturn gst_zed_point_cloud_transform(GstBaseTransform *base, GstBuffer *inbuf,
+                                                   GstBuffer *outbuf) {
+    GstZedPointCloud *pc = GST_ZED_POINT_CLOUD(base);
+    GstVideoFrame frame;
+    GstMapInfo map;
+
+    GST_OBJECT_LOCK(pc);
+    guint max_depth = pc->max_depth;
+    gfloat voxel_size = pc->voxel_size;
+    guint threads = pc->threads;
+    GST_OBJECT_UNLOCK(pc);
+
+    if (!gst_video_frame_map(&frame, &pc->vinfo, inbuf, GST_MAP_READ)) {
+        GST_ELEMENT_ERROR(pc, RESOURCE, FAILED, ("Failed to map input buffer"), (NULL));
+        return GST_FLOW_ERROR;
+    }
+    if (!gst_buffer_map(outbuf, &map, GST_MAP_WRITE)) {
+        gst_video_frame_unmap(&frame);
+        GST_ELEMENT_ERROR(pc, RESOURCE, FAILED, ("Failed to map output buffer"), (NULL));
+        return GST_FLOW_ERROR;
+    }
+
+    guint stride = pc->color ? 4 : 3;
+    gsize pixels = (gsize) pc->width * pc->height;
+    gfloat *points = (gfloat *) map.data;
+    if (voxel_size > 0.f) {
+        if (pc->scratch == NULL) {
+            pc->scratch = (gfloat *) g_malloc(pixels * 4 * sizeof(gfloat));
+        }
+        points = pc->scratch;
+    }
+
+    ensure_pool(pc, threads);
+    guint count = run_bands(pc, &frame, max_depth, points);
+
+    if (voxel_size > 0.f) {
+        gst_zed_voxel_grid_reset(&pc->grid, voxel_size, count);
+        guint dropped = gst_zed_voxel_grid_add(&pc->grid, points, count, stride, pc->color);
+        if (dropped > 0) {
+            GST_WARNING_OBJECT(pc, "Voxel grid full, %u points dropped", dropped);
+        }
+        count = gst_zed_voxel_grid_write(&pc->grid, (gfloat *) map.data, stride, pc->color);
+    }
+
+    gst_buffer_unmap(outbuf, &map);
+    gst_video_frame_unmap(&frame);
+
+    gst_buffer_set_size(outbuf, (gssize) count * stride * sizeof(gfloat));
+    GST_LOG_OBJECT(pc, "%u points", count);
+
+    return GST_FLOW_OK;
+}
+
+static gboolean gst_zed_point_cloud_stop(GstBaseTransform *base) {
+    GstZedPointCloud *pc = GST_ZED_POINT_CLOUD(base);
+
+    free_buffers(pc);
+    return TRUE;
+}
+
+// ----> Bands
+/* Back-project the valid pixels of the band, skipping the invalid ones. The points of a band are
+ * contiguous, starting at the band first pixel.
+ */
+static void run_band(GstZedPointCloudBand *band) {
+    GstZedPointCloud *pc = band->pc;
+    guint width = pc->width;
+    gboolean color = pc->color;
+    gfloat *out = band->out;
+
+    for (guint y = band->y_begin; y < band->y_end; y++) {
+        const gfloat *ray_x = pc->ray_x;
+        gfloat ray_y = pc->ray_y[y];
+
+        if (!pc->composite) {
+            const guint16 *depth = (const guint16 *) (band->data + y * band->stride);
+            for (guint x = 0; x < width; x++) {
+                guint d = depth[x];
+                if (d == 0 || d > band->max_depth) {
+                    continue;
+                }
+                gfloat z = d * 0.001f;
+                out[0] = ray_x[x] * z;
+                out[1] = ray_y * z;
+                out[2] = z;
+                out += 3;
+            }
+            continue;
+        }
+
+        // 32 bits depth in millimeters on the bottom half, BGRA left image on the top half
+        const guint8 *bgra = band->data + y * band->stride;
+        const guint32 *depth = (const guint32 *) (band->data + (pc->height + y) * band->stride);
+        for (guint x = 0; x < width; x++) {
+            guint32 d = depth[x];
+            if (d == 0 || d > band->max_depth) {
+                continue;
+            }
+            gfloat z = d * 0.001f;
+            out[0] = ray_x[x] * z;
+            out[1] = ray_y * z;
+            out[2] = z;
+            if (color) {
+                const guint8 *px = bgra + 4 * x;
+                guint32 rgb = ((guint32) px[2] << 16) | ((guint32) px[1] << 8) | px[0];
+                memcpy(&out[3], &rgb, sizeof(rgb));
+                out += 4;
+            } else {
+                out += 3;
+            }
+        }
+    }
+
+    band->count = (guint) ((out - band->out) / (color ? 4 : 3));
+}
+
+static void band_worker(gpointer data, gpointer user_data) {
+    GstZedPointCloud *pc = GST_ZED_POINT_CLOUD(user_data);
+
+    run_band((GstZedPointCloudBand *) data);
+
+    g_mutex_lock(&pc->lock);
+    pc->pending--;
+    if (pc->pending == 0) {
+        g_cond_signal(&pc->cond);
+    }
+    g_mutex_unlock(&pc->lock);
+}
+
+static void ensure_pool(GstZedPointCloud *pc, guint threads) {
+    guint workers = threads > 1 ? threads - 1 : 0;
+
+    if (pc->pool && pc->pool_size == workers) {
+        return;
+    }
+
+    if (pc->pool) {
+        g_thread_pool_free(pc->pool, FALSE, TRUE);
+        pc->pool = NULL;
+        pc->pool_size = 0;
+    }
+
+    if (workers == 0) {
+        return;
+    }
+
+    GError *error = NULL;
+    pc->pool = g_thread_pool_new(band_worker, pc, workers, TRUE, &error);
+    if (pc->pool == NULL) {
+        GST_WARNING_OBJECT(pc, "Cannot start the point cloud threads: %s",
+                           error ? error->message : "unknown error");
+        g_clear_error(&error);
+        return;
+    }
+    pc->pool_size = workers;
+
+    GST_DEBUG_OBJECT(pc, "Generating the points with %u threads", workers + 1);
+}
+
+/* Split the depth map in horizontal bands, one per thread, the first one being processed by the
+ * calling thread. The points of the bands are then moved next to each other. Returns the number
+ * of points written to `points`.
+ */
+static guint run_bands(GstZedPointCloud *pc, GstVideoFrame *frame, guint max_depth,
+                       gfloat *points) {
+    guint height = pc->height;
+    guint stride = pc->color ? 4 : 3;
+    guint bands = pc->pool ? MIN(pc->pool_size + 1, height) : 1;
+    bands = MAX(bands, 1);
+    guint band_h = (height + bands - 1) / bands;
+
+    GstZedPointCloudBand slices[MAX_THREADS];
+    guint count = 0;
+    for (guint y = 0; y < height; y += band_h) {
+        GstZedPointCloudBand *band = &slices[count++];
+        band->pc = pc;
+        band->data = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA(frame, 0);
+        band->stride = GST_VIDEO_FRAME_PLANE_STRIDE(frame, 0);
+        band->max_depth = max_depth;
+        band->out = points + (gsize) y * pc->width * stride;
+        band->y_begin = y;
+        band->y_end = MIN(y + band_h, height);
+        band->count = 0;
+    }
+
+    if (count > 1) {
+        g_mutex_lock(&pc->lock);
+        pc->pending = count - 1;
+        g_mutex_unlock(&pc->lock);
+
+        for (guint b = 1; b < count; b++) {
+            g_thread_pool_push(pc->pool, &slices[b], NULL);
+        }
+    }
+
+    run_band(&slices[0]);
+
+    if (count > 1) {
+        g_mutex_lock(&pc->lock);
+        while (pc->pending > 0) {
+            g_cond_wait(&pc->cond, &pc->lock);
+        }
+        g_mutex_unlock(&pc->lock);
+    }
+
+    guint total = slices[0].count;
+    for (guint b = 1; b < count; b++) {
+        memmove(points + (gsize) total * stride, slices[b].out,
+                (gsize) slices[b].count * stride * sizeof(gfloat));
+        total += slices[b].count;
+    }
+    return total;
+}
+// <---- Bands
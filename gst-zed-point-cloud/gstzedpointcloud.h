@@ -0,0 +1,82 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef __GST_ZED_POINT_CLOUD_H__
+#define __GST_ZED_POINT_CLOUD_H__
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#include "gstzedvoxelgrid.h"
+
+G_BEGIN_DECLS
+
+/* Point cloud buffers: a packed array of little endian float32 points in meters, in the left
+ * camera frame (X right, Y down, Z forward).
+ *   XYZ    : x, y, z (12 bytes per point)
+ *   XYZRGB : x, y, z, rgb (16 bytes per point), rgb being a 0x00RRGGBB value stored in the bits
+ *            of the fourth float, as the PCL PointXYZRGB type
+ * The number of points is the size of the buffer divided by the size of a point.
+ */
+#define GST_ZED_POINT_CLOUD_CAPS_NAME "application/x-zed-point-cloud"
+
+#define GST_TYPE_ZED_POINT_CLOUD (gst_zed_point_cloud_get_type())
+G_DECLARE_FINAL_TYPE(GstZedPointCloud, gst_zed_point_cloud, GST, ZED_POINT_CLOUD, GstBaseTransform)
+
+struct _GstZedPointCloud {
+    GstBaseTransform element;
+
+    GstVideoInfo vinfo;
+    gboolean composite;   // BGRA left image over the 32 bits depth (zedsrc stream-type=4)
+    gboolean color;       // XYZRGB output
+    guint width;          // size of the depth map
+    guint height;
+
+    // Normalized image coordinates, (u - cx) / fx per column and (v - cy) / fy per row
+    gfloat *ray_x;
+    gfloat *ray_y;
+
+    // Points before the voxel grid downsampling
+    gfloat *scratch;
+    GstZedVoxelGrid grid;
+
+    // Band workers, used when `threads` > 1
+    GThreadPool *pool;
+    guint pool_size;
+    GMutex lock;
+    GCond cond;
+    guint pending;
+
+    // Properties
+    GString *calibration_file;
+    gfloat fx;
+    gfloat fy;
+    gfloat cx;
+    gfloat cy;
+    guint max_depth;
+    gfloat voxel_size;
+    guint threads;
+};
+
+G_END_DECLS
+
+#endif /* __GST_ZED_POINT_CLOUD_H__ */
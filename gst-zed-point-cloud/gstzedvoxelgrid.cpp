@@ -0,0 +1,145 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#include "gstzedvoxelgrid.h"
+
+#include <math.h>
+#include <string.h>
+
+// Each voxel coordinate is stored on 21 bits, i.e. +/- 1 km with 1 mm voxels
+#define COORD_BITS 21
+#define COORD_MASK ((1u << COORD_BITS) - 1)
+#define COORD_MAX ((gint64) (1 << (COORD_BITS - 1)) - 1)
+
+static inline guint64 coord(gfloat v, gfloat inv_size) {
+    gint64 c = (gint64) floorf(v * inv_size);
+    c = CLAMP(c, -COORD_MAX - 1, COORD_MAX);
+    return (guint64) c & COORD_MASK;
+}
+
+static inline guint32 hash_slot(guint64 key, guint bits) {
+    // Fibonacci hashing: the high bits of the product mix all the bits of the key
+    return (guint32) ((key * G_GUINT64_CONSTANT(0x9E3779B97F4A7C15)) >> (64 - bits));
+}
+
+void gst_zed_voxel_grid_init(GstZedVoxelGrid *grid) {
+    memset(grid, 0, sizeof(*grid));
+}
+
+void gst_zed_voxel_grid_reset(GstZedVoxelGrid *grid, gfloat voxel_size, guint max_points) {
+    g_return_if_fail(voxel_size > 0.f);
+
+    grid->inv_size = 1.f / voxel_size;
+
+    if (max_points > grid->capacity) {
+        guint bits = 4;
+        while ((1u << bits) < 2 * max_points) {
+            bits++;
+        }
+        g_free(grid->table);
+        g_free(grid->voxels);
+        grid->table_bits = bits;
+        grid->table = (guint32 *) g_malloc0(sizeof(guint32) << bits);
+        grid->capacity = 1u << (bits - 1);
+        grid->voxels = (GstZedVoxel *) g_malloc(grid->capacity * sizeof(GstZedVoxel));
+        grid->count = 0;
+        return;
+    }
+
+    // Clearing the used slots only is much cheaper than clearing the whole table
+    for (guint i = 0; i < grid->count; i++) {
+        grid->table[grid->voxels[i].slot] = 0;
+    }
+    grid->count = 0;
+}
+
+guint gst_zed_voxel_grid_add(GstZedVoxelGrid *grid, const gfloat *points, guint count,
+                             guint stride, gboolean color) {
+    guint32 mask = (1u << grid->table_bits) - 1;
+
+    for (guint i = 0; i < count; i++, points += stride) {
+        guint64 key = (coord(points[0], grid->inv_size) << (2 * COORD_BITS)) |
+                      (coord(points[1], grid->inv_size) << COORD_BITS) |
+                      coord(points[2], grid->inv_size);
+
+        guint32 slot = hash_slot(key, grid->table_bits);
+        GstZedVoxel *voxel = NULL;
+        while (grid->table[slot] != 0) {
+            GstZedVoxel *v = &grid->voxels[grid->table[slot] - 1];
+            if (v->key == key) {
+                voxel = v;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+
+        if (voxel == NULL) {
+            if (grid->count == grid->capacity) {
+                return count - i;
+            }
+            voxel = &grid->voxels[grid->count++];
+            grid->table[slot] = grid->count;
+            memset(voxel, 0, sizeof(*voxel));
+            voxel->key = key;
+            voxel->slot = slot;
+        }
+
+        voxel->count++;
+        voxel->sum[0] += points[0];
+        voxel->sum[1] += points[1];
+        voxel->sum[2] += points[2];
+        if (color) {
+            guint32 rgb;
+            memcpy(&rgb, &points[3], sizeof(rgb));
+            voxel->rgb_sum[0] += (rgb >> 16) & 0xFF;
+            voxel->rgb_sum[1] += (rgb >> 8) & 0xFF;
+            voxel->rgb_sum[2] += rgb & 0xFF;
+        }
+    }
+
+    return 0;
+}
+
+guint gst_zed_voxel_grid_write(const GstZedVoxelGrid *grid, gfloat *out, guint stride,
+                               gboolean color) {
+    for (guint i = 0; i < grid->count; i++, out += stride) {
+        const GstZedVoxel *voxel = &grid->voxels[i];
+        gfloat inv_count = 1.f / voxel->count;
+
+        out[0] = voxel->sum[0] * inv_count;
+        out[1] = voxel->sum[1] * inv_count;
+        out[2] = voxel->sum[2] * inv_count;
+        if (color) {
+            guint32 half = voxel->count / 2;   // round to nearest
+            guint32 rgb = (((voxel->rgb_sum[0] + half) / voxel->count) << 16) |
+                          (((voxel->rgb_sum[1] + half) / voxel->count) << 8) |
+                          ((voxel->rgb_sum[2] + half) / voxel->count);
+            memcpy(&out[3], &rgb, sizeof(rgb));
+        }
+    }
+    return grid->count;
+}
+
+void gst_zed_voxel_grid_clear(GstZedVoxelGrid *grid) {
+    g_free(grid->table);
+    g_free(grid->voxels);
+    gst_zed_voxel_grid_init(grid);
+}
@@ -0,0 +1,75 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef GST_ZED_VOXEL_GRID_H
+#define GST_ZED_VOXEL_GRID_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Voxel grid downsampling of point clouds: the points falling in the same cubic voxel are replaced
+ * by their centroid, and by their mean color for colored points.
+ * The voxels are found in an open addressing hash table keyed by their integer coordinates. Their
+ * accumulators are stored in an arena in first insertion order, so that the output order follows
+ * the input order and does not depend on the hash table layout.
+ */
+
+typedef struct {
+    guint64 key;   // packed voxel coordinates
+    guint32 slot;   // position in the hash table, to clear it on reset
+    guint32 count;
+    gfloat sum[3];
+    guint32 rgb_sum[3];
+} GstZedVoxel;
+
+typedef struct {
+    gfloat inv_size;
+    guint32 *table;   // index + 1 of the voxel in `voxels`, 0 for an empty slot
+    guint table_bits;
+    GstZedVoxel *voxels;
+    guint count;
+    guint capacity;   // of `voxels`, half of the table size
+} GstZedVoxelGrid;
+
+void gst_zed_voxel_grid_init(GstZedVoxelGrid *grid);
+
+/* Empty the grid and prepare it for up to `max_points` points in voxels of `voxel_size`. */
+void gst_zed_voxel_grid_reset(GstZedVoxelGrid *grid, gfloat voxel_size, guint max_points);
+
+/* Add `count` points of `stride` floats: x, y, z and, when `color` is TRUE, a 0x00RRGGBB color
+ * stored in the bits of the fourth float. Returns the number of points dropped because the grid
+ * is full.
+ */
+guint gst_zed_voxel_grid_add(GstZedVoxelGrid *grid, const gfloat *points, guint count,
+                             guint stride, gboolean color);
+
+/* Write one point per voxel to `out`, with the same layout as the added points. Returns the number
+ * of points written.
+ */
+guint gst_zed_voxel_grid_write(const GstZedVoxelGrid *grid, gfloat *out, guint stride,
+                               gboolean color);
+
+void gst_zed_voxel_grid_clear(GstZedVoxelGrid *grid);
+
+G_END_DECLS
+
+#endif   // GST_ZED_VOXEL_GRID_H
@@ -32,6 +32,8 @@
 #endif
 
 #include "gst-zed-meta/gstzedmeta.h"
+#include "gst-zed-meta/gstzedsensors.h"
+#include "gst-zed-meta/gstzedtimingmeta.h"
 #include "gstzedsrc.h"
 
 // AI Module
@@ -45,9 +47,8 @@ GST_DEBUG_CATEGORY_STATIC(gst_zedsrc_debug);
 GST_DEBUG_CATEGORY_STATIC(gst_zedsrc_tracking_debug);
 GST_DEBUG_CATEGORY_STATIC(gst_zedsrc_od_debug);
 GST_DEBUG_CATEGORY_STATIC(gst_zedsrc_controls_debug);
+GST_DEBUG_CATEGORY_STATIC(gst_zedsrc_sensors_debug);
 
-// Magic number constants
-#define GST_ZEDSRC_MAX_OBJECTS 256
 /* prototypes */
 static void gst_zedsrc_set_property(GObject *object, guint property_id, const GValue *value,
                                     GParamSpec *pspec);
@@ -197,6 +198,16 @@ static void stereo_sbs_wrapped_buffer_destroy_notify(gpointer data) {
 
 static gboolean gst_zedsrc_query(GstBaseSrc *src, GstQuery *query);
 
+static GstPad *gst_zedsrc_request_new_pad(GstElement *element, GstPadTemplate *templ,
+                                          const gchar *name, const GstCaps *caps);
+static void gst_zedsrc_release_pad(GstElement *element, GstPad *pad);
+static gboolean gst_zedsrc_sensors_activate_mode(GstPad *pad, GstObject *parent, GstPadMode mode,
+                                                 gboolean active);
+static void gst_zedsrc_sensors_stop(GstZedSrc *src);
+static void gst_zedsrc_sensors_loop(gpointer user_data);
+static GstFlowReturn gst_zedsrc_push_request_pads(GstZedSrc *src, GstBuffer *buf,
+                                                  sl::Mat *right_img, sl::Mat *depth_img);
+
 enum {
     PROP_0,
     PROP_CAM_RES,
@@ -312,6 +323,8 @@ enum {
     PROP_SVO_REC_ENABLE,
     PROP_SVO_REC_FILENAME,
     PROP_SVO_REC_COMPRESSION,
+    PROP_TIMING_META,
+    PROP_SENSORS_BATCH_SIZE,
     N_PROPERTIES
 };
 
@@ -350,8 +363,10 @@ typedef enum {
 #ifdef SL_ENABLE_ADVANCED_CAPTURE_API
     GST_ZEDSRC_RAW_NV12 = 6,          // Zero-copy NV12 raw buffer (GMSL cameras only)
     GST_ZEDSRC_RAW_NV12_STEREO = 7,   // Zero-copy NV12 stereo (left + right)
-    GST_ZEDSRC_RAW_NV12_RIGHT = 8     // Zero-copy NV12 right eye only (GMSL cameras only)
+    GST_ZEDSRC_RAW_NV12_RIGHT = 8,    // Zero-copy NV12 right eye only (GMSL cameras only)
 #endif
+    GST_ZEDSRC_DEPTH_32F = 9,    // Float depth in millimeters [GST_ZEDSRC_MEASURE_CAPS_NAME]
+    GST_ZEDSRC_CONFIDENCE = 10   // Float confidence map [GST_ZEDSRC_MEASURE_CAPS_NAME]
 } GstZedSrcStreamType;
 
 typedef enum {
@@ -534,6 +549,8 @@ typedef enum {
 #define DEFAULT_PROP_SVO_REC_ENABLE FALSE
 #define DEFAULT_PROP_SVO_REC_FILENAME ""
 #define DEFAULT_PROP_SVO_REC_COMPRESSION GST_ZEDSRC_SVO_COMPRESSION_H265
+#define DEFAULT_PROP_TIMING_META FALSE
+#define DEFAULT_PROP_SENSORS_BATCH_SIZE 20
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 typedef enum {
@@ -689,6 +706,10 @@ static GType gst_zedsrc_stream_type_get_type(void) {
             {GST_ZEDSRC_RAW_NV12_RIGHT, "Zero-copy NV12 right eye only (GMSL cameras only)",
              "Raw NV12 right zero-copy [NV12]"},
 #endif
+            {GST_ZEDSRC_DEPTH_32F, "32 bits float depth in millimeters",
+             "Depth map [video/x-zed-measure]"},
+            {GST_ZEDSRC_CONFIDENCE, "32 bits float confidence map",
+             "Confidence map [video/x-zed-measure]"},
             {0, NULL, NULL},
         };
 
@@ -1026,6 +1047,11 @@ static GstStaticPadTemplate gst_zedsrc_src_template = GST_STATIC_PAD_TEMPLATE(
                      "width = (int)960, "
                      "height = (int)600, "
                      "framerate = (fraction) { 15, 30, 60, 120 }"
+                     ";" GST_ZEDSRC_MEASURE_CAPS_NAME ", "   // Float depth and confidence maps
+                     "measure = (string) { depth, confidence }, "
+                     "width = (int)[ 1, 8192 ], "
+                     "height = (int)[ 1, 8192 ], "
+                     "framerate = (fraction)[ 0/1, MAX ]"
 #ifdef SL_ENABLE_ADVANCED_CAPTURE_API
                      ";"
                      "video/x-raw(memory:NVMM), "   // NV12 HD1200 (GMSL2 zero-copy)
@@ -1068,6 +1094,28 @@ static GstStaticPadTemplate gst_zedsrc_src_template = GST_STATIC_PAD_TEMPLATE(
 #endif  // SL_ENABLE_ADVANCED_CAPTURE_API
                      )));
 
+static GstStaticPadTemplate gst_zedsrc_right_template =
+    GST_STATIC_PAD_TEMPLATE("right", GST_PAD_SRC, GST_PAD_REQUEST,
+                            GST_STATIC_CAPS("video/x-raw, "
+                                            "format = (string)BGRA, "
+                                            "width = (int)[ 1, 8192 ], "
+                                            "height = (int)[ 1, 8192 ], "
+                                            "framerate = (fraction)[ 0/1, MAX ]"));
+
+static GstStaticPadTemplate gst_zedsrc_depth_template =
+    GST_STATIC_PAD_TEMPLATE("depth", GST_PAD_SRC, GST_PAD_REQUEST,
+                            GST_STATIC_CAPS("video/x-raw, "
+                                            "format = (string)GRAY16_LE, "
+                                            "width = (int)[ 1, 8192 ], "
+                                            "height = (int)[ 1, 8192 ], "
+                                            "framerate = (fraction)[ 0/1, MAX ]"));
+
+static GstStaticPadTemplate gst_zedsrc_data_template = GST_STATIC_PAD_TEMPLATE(
+    "data", GST_PAD_SRC, GST_PAD_REQUEST, GST_STATIC_CAPS("application/data"));
+
+static GstStaticPadTemplate gst_zedsrc_sensors_template = GST_STATIC_PAD_TEMPLATE(
+    "sensors", GST_PAD_SRC, GST_PAD_REQUEST, GST_STATIC_CAPS(GST_ZED_SENSORS_CAPS_NAME));
+
 /* class initialization */
 G_DEFINE_TYPE(GstZedSrc, gst_zedsrc, GST_TYPE_PUSH_SRC);
 
@@ -1084,6 +1132,14 @@ static void gst_zedsrc_class_init(GstZedSrcClass *klass) {
 
     gst_element_class_add_pad_template(gstelement_class,
                                        gst_static_pad_template_get(&gst_zedsrc_src_template));
+    gst_element_class_add_pad_template(gstelement_class,
+                                       gst_static_pad_template_get(&gst_zedsrc_right_template));
+    gst_element_class_add_pad_template(gstelement_class,
+                                       gst_static_pad_template_get(&gst_zedsrc_depth_template));
+    gst_element_class_add_pad_template(gstelement_class,
+                                       gst_static_pad_template_get(&gst_zedsrc_data_template));
+    gst_element_class_add_pad_template(gstelement_class,
+                                       gst_static_pad_template_get(&gst_zedsrc_sensors_template));
 
     gst_element_class_set_static_metadata(gstelement_class, "ZED Camera Source", "Source/Video",
                                           "Stereolabs ZED Camera source",
@@ -1098,6 +1154,9 @@ static void gst_zedsrc_class_init(GstZedSrcClass *klass) {
     gstbasesrc_class->unlock_stop = GST_DEBUG_FUNCPTR(gst_zedsrc_unlock_stop);
     gstbasesrc_class->query = GST_DEBUG_FUNCPTR(gst_zedsrc_query);
 
+    gstelement_class->request_new_pad = GST_DEBUG_FUNCPTR(gst_zedsrc_request_new_pad);
+    gstelement_class->release_pad = GST_DEBUG_FUNCPTR(gst_zedsrc_release_pad);
+
     gstpushsrc_class->fill = GST_DEBUG_FUNCPTR(gst_zedsrc_fill);
 #ifdef SL_ENABLE_ADVANCED_CAPTURE_API
     gstpushsrc_class->create = GST_DEBUG_FUNCPTR(gst_zedsrc_create);
@@ -1729,6 +1788,21 @@ static void gst_zedsrc_class_init(GstZedSrcClass *klass) {
                           DEFAULT_PROP_SVO_REC_COMPRESSION,
                           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
+    g_object_class_install_property(
+        gobject_class, PROP_TIMING_META,
+        g_param_spec_boolean("timing-meta", "Timing metadata",
+                             "Attach a GstZedTimingMeta with the duration of each processing "
+                             "stage to every buffer",
+                             DEFAULT_PROP_TIMING_META,
+                             (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_SENSORS_BATCH_SIZE,
+        g_param_spec_uint("sensors-batch-size", "Sensors batch size",
+                          "Number of IMU samples per buffer of the 'sensors' request pad", 1, 1000,
+                          DEFAULT_PROP_SENSORS_BATCH_SIZE,
+                          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
     g_object_class_install_property(
         gobject_class, PROP_SVO_REAL_TIME,
         g_param_spec_boolean("svo-real-time-mode", "SVO Real Time Mode", "SVO Real Time Mode",
@@ -1996,9 +2070,24 @@ static void gst_zedsrc_init(GstZedSrc *src) {
     src->svo_rec_filename = g_string_new(DEFAULT_PROP_SVO_REC_FILENAME);
     src->svo_rec_compression = DEFAULT_PROP_SVO_REC_COMPRESSION;
     src->svo_rec_active = FALSE;
+    src->timing_meta = DEFAULT_PROP_TIMING_META;
+    src->sensors_batch_size = DEFAULT_PROP_SENSORS_BATCH_SIZE;
     // <---- Parameters initialization
 
     src->stop_requested = FALSE;
+
+    src->right_pad = NULL;
+    src->depth_pad = NULL;
+    src->data_pad = NULL;
+    src->sensors_pad = NULL;
+    src->eos_probe = 0;
+    src->sensors_running = 0;
+    src->sensors_eos = 0;
+    src->sensors_started = FALSE;
+    src->sensors_last_imu_ts = 0;
+    src->sensors_last_mag_ts = 0;
+    src->sensors_last_baro_ts = 0;
+    src->sensors_offset = 0;
     src->caps = NULL;
 
 #if defined(SL_ENABLE_ADVANCED_CAPTURE_API) && defined(HAVE_NVBUFSURFTRANSFORM)
@@ -2352,6 +2441,12 @@ void gst_zedsrc_set_property(GObject *object, guint property_id, const GValue *v
     case PROP_SVO_REC_COMPRESSION:
         src->svo_rec_compression = g_value_get_enum(value);
         break;
+    case PROP_TIMING_META:
+        src->timing_meta = g_value_get_boolean(value);
+        break;
+    case PROP_SENSORS_BATCH_SIZE:
+        src->sensors_batch_size = g_value_get_uint(value);
+        break;
     case PROP_SVO_REAL_TIME:
         src->svo_real_time = g_value_get_boolean(value);
         break;
@@ -2706,6 +2801,12 @@ void gst_zedsrc_get_property(GObject *object, guint property_id, GValue *value,
     case PROP_SVO_REC_COMPRESSION:
         g_value_set_enum(value, src->svo_rec_compression);
         break;
+    case PROP_TIMING_META:
+        g_value_set_boolean(value, src->timing_meta);
+        break;
+    case PROP_SENSORS_BATCH_SIZE:
+        g_value_set_uint(value, src->sensors_batch_size);
+        break;
     case PROP_SVO_REAL_TIME:
         g_value_set_boolean(value, src->svo_real_time);
         break;
@@ -2920,6 +3021,8 @@ static gboolean gst_zedsrc_calculate_caps(GstZedSrc *src) {
 
     if (stream_type == GST_ZEDSRC_DEPTH_16) {
         format = GST_VIDEO_FORMAT_GRAY16_LE;
+    } else if (stream_type == GST_ZEDSRC_DEPTH_32F || stream_type == GST_ZEDSRC_CONFIDENCE) {
+        format = GST_VIDEO_FORMAT_UNKNOWN;   // no float gray format in GstVideoFormat
     }
 #ifdef SL_ENABLE_ADVANCED_CAPTURE_API
     else if (stream_type == GST_ZEDSRC_RAW_NV12 || stream_type == GST_ZEDSRC_RAW_NV12_STEREO ||
@@ -2972,6 +3075,18 @@ static gboolean gst_zedsrc_calculate_caps(GstZedSrc *src) {
             GST_INFO_OBJECT(src, "Added memory:NVMM feature for zero-copy");
         }
 #endif
+    } else {
+        // Tightly packed float32 rows, as retrieved from the SDK
+        if (src->caps) {
+            gst_caps_unref(src->caps);
+            src->caps = NULL;
+        }
+        src->out_framesize = width * height * sizeof(gfloat);
+        src->caps = gst_caps_new_simple(
+            GST_ZEDSRC_MEASURE_CAPS_NAME, "measure", G_TYPE_STRING,
+            (stream_type == GST_ZEDSRC_CONFIDENCE) ? "confidence" : "depth", "width", G_TYPE_INT,
+            (gint) width, "height", G_TYPE_INT, (gint) height, "framerate", GST_TYPE_FRACTION, fps,
+            1, NULL);
     }
 
     gst_base_src_set_blocksize(GST_BASE_SRC(src), src->out_framesize);
@@ -3057,7 +3172,8 @@ static gboolean gst_zedsrc_start(GstBaseSrc *bsrc) {
             src,
             "Positional tracking requires DEPTH_MODE!=NONE. Depth mode value forced to NEURAL");
     }
-    if ((src->stream_type == GST_ZEDSRC_LEFT_DEPTH || src->stream_type == GST_ZEDSRC_DEPTH_16) &&
+    if ((src->stream_type == GST_ZEDSRC_LEFT_DEPTH || src->stream_type == GST_ZEDSRC_DEPTH_16 ||
+         src->stream_type == GST_ZEDSRC_DEPTH_32F || src->stream_type == GST_ZEDSRC_CONFIDENCE) &&
         init_params.depth_mode == sl::DEPTH_MODE::NONE) {
         init_params.depth_mode = sl::DEPTH_MODE::NEURAL;
         src->depth_mode = static_cast<gint>(init_params.depth_mode);
@@ -3450,6 +3566,9 @@ static gboolean gst_zedsrc_stop(GstBaseSrc *bsrc) {
         GST_INFO_OBJECT(src, "SVO recording stopped on pipeline stop");
     }
 
+    // The sensors task polls the camera, stop it before closing the camera
+    gst_zedsrc_sensors_stop(src);
+
     gst_zedsrc_reset(src);
 
     return TRUE;
@@ -3626,14 +3745,16 @@ static void gst_zedsrc_setup_runtime_parameters(GstZedSrc *src,
     }
 }
 
-static void gst_zedsrc_attach_metadata(GstZedSrc *src, GstBuffer *buf, GstClockTime clock_time) {
+static void gst_zedsrc_attach_metadata(GstZedSrc *src, GstBuffer *buf, GstClockTime clock_time,
+                                       ZedTiming *timing) {
+    gst_zed_timing_begin(timing, GST_ZED_TIMING_METADATA);
+
     ZedInfo info;
     ZedPose pose;
     ZedSensors sens;
-    ZedObjectData *obj_data = new ZedObjectData[GST_ZEDSRC_MAX_OBJECTS];
-    memset(obj_data, 0, GST_ZEDSRC_MAX_OBJECTS * sizeof(ZedObjectData));
+    std::vector<ZedObjectData> od_data;
+    std::vector<ZedObjectData> bt_data;
 
-    guint8 obj_count = 0;
     guint64 offset = 0;
     sl::ERROR_CODE ret;
 
@@ -3769,55 +3890,55 @@ static void gst_zedsrc_attach_metadata(GstZedSrc *src, GstBuffer *buf, GstClockT
         class_det_conf[sl::OBJECT_CLASS::SPORT] = src->od_sport_conf;
         od_rt_params.object_class_detection_confidence_threshold = class_det_conf;
 
+        gst_zed_timing_begin(timing, GST_ZED_TIMING_OBJECTS);
         ret = src->zed.retrieveObjects(det_objs, od_rt_params, OD_INSTANCE_MODULE_ID);
+        gst_zed_timing_end(timing, GST_ZED_TIMING_OBJECTS);
 
         if (ret == sl::ERROR_CODE::SUCCESS) {
             if (det_objs.is_new) {
                 GST_LOG_OBJECT(src, "OD new data");
 
-                obj_count = det_objs.object_list.size();
-                if (obj_count > 255)
-                    obj_count = 255;
+                od_data.resize(det_objs.object_list.size());
 
-                GST_LOG_OBJECT(src, "Number of detected objects (clamped): %d", obj_count);
+                GST_LOG_OBJECT(src, "Number of detected objects: %zu", od_data.size());
 
-                uint8_t idx = 0;
-                for (auto i = det_objs.object_list.begin();
-                     i != det_objs.object_list.end() && idx < obj_count; ++i, ++idx) {
+                size_t idx = 0;
+                for (auto i = det_objs.object_list.begin(); i != det_objs.object_list.end();
+                     ++i, ++idx) {
                     sl::ObjectData obj = *i;
 
-                    obj_data[idx].skeletons_avail = FALSE;
-                    obj_data[idx].id = obj.id;
+                    od_data[idx].skeletons_avail = FALSE;
+                    od_data[idx].id = obj.id;
 
-                    obj_data[idx].label = static_cast<OBJECT_CLASS>(obj.label);
-                    obj_data[idx].sublabel = static_cast<OBJECT_SUBCLASS>(obj.sublabel);
+                    od_data[idx].label = static_cast<OBJECT_CLASS>(obj.label);
+                    od_data[idx].sublabel = static_cast<OBJECT_SUBCLASS>(obj.sublabel);
 
-                    obj_data[idx].tracking_state =
+                    od_data[idx].tracking_state =
                         static_cast<OBJECT_TRACKING_STATE>(obj.tracking_state);
-                    obj_data[idx].action_state = static_cast<OBJECT_ACTION_STATE>(obj.action_state);
+                    od_data[idx].action_state = static_cast<OBJECT_ACTION_STATE>(obj.action_state);
 
-                    obj_data[idx].confidence = obj.confidence;
+                    od_data[idx].confidence = obj.confidence;
 
-                    memcpy(obj_data[idx].position, (void *) obj.position.ptr(), 3 * sizeof(float));
-                    memcpy(obj_data[idx].position_covariance, (void *) obj.position_covariance,
+                    memcpy(od_data[idx].position, (void *) obj.position.ptr(), 3 * sizeof(float));
+                    memcpy(od_data[idx].position_covariance, (void *) obj.position_covariance,
                            6 * sizeof(float));
-                    memcpy(obj_data[idx].velocity, (void *) obj.velocity.ptr(), 3 * sizeof(float));
+                    memcpy(od_data[idx].velocity, (void *) obj.velocity.ptr(), 3 * sizeof(float));
 
                     if (obj.bounding_box_2d.size() > 0) {
-                        memcpy((uint8_t *) obj_data[idx].bounding_box_2d,
+                        memcpy((uint8_t *) od_data[idx].bounding_box_2d,
                                (uint8_t *) obj.bounding_box_2d.data(),
                                obj.bounding_box_2d.size() * 2 * sizeof(unsigned int));
                     }
                     if (obj.bounding_box.size() > 0) {
-                        memcpy(obj_data[idx].bounding_box_3d, (void *) obj.bounding_box.data(),
+                        memcpy(od_data[idx].bounding_box_3d, (void *) obj.bounding_box.data(),
                                24 * sizeof(float));
                     }
 
-                    memcpy(obj_data[idx].dimensions, (void *) obj.dimensions.ptr(),
+                    memcpy(od_data[idx].dimensions, (void *) obj.dimensions.ptr(),
                            3 * sizeof(float));
                 }
             } else {
-                obj_count = 0;
+                od_data.clear();
             }
         } else {
             GST_WARNING_OBJECT(src, "Object detection problem: '%s' - %s",
@@ -3828,96 +3949,95 @@ static void gst_zedsrc_attach_metadata(GstZedSrc *src, GstBuffer *buf, GstClockT
 
     // ----> Body Tracking metadata
     if (src->body_tracking) {
-        guint8 b_idx = obj_count;
-
         GST_LOG_OBJECT(src, "Body Tracking enabled");
 
         bt_rt_params.detection_confidence_threshold = src->bt_rt_det_conf;
         bt_rt_params.minimum_keypoints_threshold = src->bt_rt_min_kp_thresh;
         bt_rt_params.skeleton_smoothing = src->bt_rt_skel_smoothing;
 
+        gst_zed_timing_begin(timing, GST_ZED_TIMING_BODIES);
         ret = src->zed.retrieveBodies(bodies, bt_rt_params, BT_INSTANCE_MODULE_ID);
+        gst_zed_timing_end(timing, GST_ZED_TIMING_BODIES);
 
         if (ret == sl::ERROR_CODE::SUCCESS) {
             if (bodies.is_new) {
                 GST_LOG_OBJECT(src, "BT new data");
 
-                int bodies_count = bodies.body_list.size();
-                GST_LOG_OBJECT(src, "Number of detected bodies: %d", bodies_count);
+                bt_data.resize(bodies.body_list.size());
+                GST_LOG_OBJECT(src, "Number of detected bodies: %zu", bt_data.size());
 
-                for (auto i = bodies.body_list.begin(); i != bodies.body_list.end() && b_idx < 256;
+                size_t b_idx = 0;
+                for (auto i = bodies.body_list.begin(); i != bodies.body_list.end();
                      ++i, ++b_idx) {
                     sl::BodyData obj = *i;
 
-                    obj_data[b_idx].skeletons_avail = TRUE;
-                    obj_data[b_idx].id = obj.id;
-                    obj_data[b_idx].label = OBJECT_CLASS::PERSON;
-                    obj_data[b_idx].sublabel = OBJECT_SUBCLASS::PERSON;
+                    bt_data[b_idx].skeletons_avail = TRUE;
+                    bt_data[b_idx].id = obj.id;
+                    bt_data[b_idx].label = OBJECT_CLASS::PERSON;
+                    bt_data[b_idx].sublabel = OBJECT_SUBCLASS::PERSON;
 
-                    obj_data[b_idx].tracking_state =
+                    bt_data[b_idx].tracking_state =
                         static_cast<OBJECT_TRACKING_STATE>(obj.tracking_state);
-                    obj_data[b_idx].action_state =
+                    bt_data[b_idx].action_state =
                         static_cast<OBJECT_ACTION_STATE>(obj.action_state);
 
-                    obj_data[b_idx].confidence = obj.confidence;
+                    bt_data[b_idx].confidence = obj.confidence;
 
-                    memcpy(obj_data[b_idx].position, (void *) obj.position.ptr(),
+                    memcpy(bt_data[b_idx].position, (void *) obj.position.ptr(),
                            3 * sizeof(float));
-                    memcpy(obj_data[b_idx].position_covariance, (void *) obj.position_covariance,
+                    memcpy(bt_data[b_idx].position_covariance, (void *) obj.position_covariance,
                            6 * sizeof(float));
-                    memcpy(obj_data[b_idx].velocity, (void *) obj.velocity.ptr(),
+                    memcpy(bt_data[b_idx].velocity, (void *) obj.velocity.ptr(),
                            3 * sizeof(float));
 
                     if (obj.bounding_box_2d.size() > 0) {
-                        memcpy((uint8_t *) obj_data[b_idx].bounding_box_2d,
+                        memcpy((uint8_t *) bt_data[b_idx].bounding_box_2d,
                                (uint8_t *) obj.bounding_box_2d.data(),
                                obj.bounding_box_2d.size() * 2 * sizeof(unsigned int));
                     }
                     if (obj.bounding_box.size() > 0) {
-                        memcpy(obj_data[b_idx].bounding_box_3d, (void *) obj.bounding_box.data(),
+                        memcpy(bt_data[b_idx].bounding_box_3d, (void *) obj.bounding_box.data(),
                                24 * sizeof(float));
                     }
 
-                    memcpy(obj_data[b_idx].dimensions, (void *) obj.dimensions.ptr(),
+                    memcpy(bt_data[b_idx].dimensions, (void *) obj.dimensions.ptr(),
                            3 * sizeof(float));
 
                     switch (static_cast<sl::BODY_FORMAT>(src->bt_format)) {
                     case sl::BODY_FORMAT::BODY_18:
-                        obj_data[b_idx].skel_format = 18;
+                        bt_data[b_idx].skel_format = 18;
                         break;
                     case sl::BODY_FORMAT::BODY_34:
-                        obj_data[b_idx].skel_format = 34;
+                        bt_data[b_idx].skel_format = 34;
                         break;
                     case sl::BODY_FORMAT::BODY_38:
-                        obj_data[b_idx].skel_format = 38;
+                        bt_data[b_idx].skel_format = 38;
                         break;
                     default:
-                        obj_data[b_idx].skel_format = 0;
+                        bt_data[b_idx].skel_format = 0;
                         break;
                     }
 
-                    if (obj.keypoint_2d.size() > 0 && obj_data[b_idx].skel_format > 0) {
-                        memcpy(obj_data[b_idx].keypoint_2d, (void *) obj.keypoint_2d.data(),
-                               2 * obj_data[b_idx].skel_format * sizeof(float));
+                    if (obj.keypoint_2d.size() > 0 && bt_data[b_idx].skel_format > 0) {
+                        memcpy(bt_data[b_idx].keypoint_2d, (void *) obj.keypoint_2d.data(),
+                               2 * bt_data[b_idx].skel_format * sizeof(float));
                     }
-                    if (obj.keypoint.size() > 0 && obj_data[b_idx].skel_format > 0) {
-                        memcpy(obj_data[b_idx].keypoint_3d, (void *) obj.keypoint.data(),
-                               3 * obj_data[b_idx].skel_format * sizeof(float));
+                    if (obj.keypoint.size() > 0 && bt_data[b_idx].skel_format > 0) {
+                        memcpy(bt_data[b_idx].keypoint_3d, (void *) obj.keypoint.data(),
+                               3 * bt_data[b_idx].skel_format * sizeof(float));
                     }
 
                     if (obj.head_bounding_box_2d.size() > 0) {
-                        memcpy(obj_data[b_idx].head_bounding_box_2d,
+                        memcpy(bt_data[b_idx].head_bounding_box_2d,
                                (void *) obj.head_bounding_box_2d.data(), 8 * sizeof(unsigned int));
                     }
                     if (obj.head_bounding_box.size() > 0) {
-                        memcpy(obj_data[b_idx].head_bounding_box_3d,
+                        memcpy(bt_data[b_idx].head_bounding_box_3d,
                                (void *) obj.head_bounding_box.data(), 24 * sizeof(float));
                     }
-                    memcpy(obj_data[b_idx].head_position, (void *) obj.head_position.ptr(),
+                    memcpy(bt_data[b_idx].head_position, (void *) obj.head_position.ptr(),
                            3 * sizeof(float));
                 }
-
-                obj_count = b_idx;
             }
         } else {
             GST_WARNING_OBJECT(src, "Body Tracking problem: '%s' - %s", sl::toString(ret).c_str(),
@@ -3934,10 +4054,19 @@ static void gst_zedsrc_attach_metadata(GstZedSrc *src, GstBuffer *buf, GstClockT
     // <---- Timestamp meta-data
 
     offset = GST_BUFFER_OFFSET(buf);
-    gst_buffer_add_zed_src_meta(buf, info, pose, sens, src->object_detection | src->body_tracking,
-                                obj_count, obj_data, offset);
-
-    delete[] obj_data;
+    gst_buffer_add_zed_src_meta_full(buf, info, pose, sens,
+                                     src->object_detection | src->body_tracking, od_data.size(),
+                                     od_data.data(), bt_data.size(), bt_data.data(), offset);
+
+    // ----> Timing metadata
+    if (timing) {
+        gst_zed_timing_end(timing, GST_ZED_TIMING_METADATA);
+        timing->frame_id = offset;
+        timing->camera_timestamp =
+            src->zed.getTimestamp(sl::TIME_REFERENCE::IMAGE).getNanoseconds();
+        gst_buffer_add_zed_timing_meta(buf, timing);
+    }
+    // <---- Timing metadata
 }
 
 static GstFlowReturn gst_zedsrc_fill(GstPushSrc *psrc, GstBuffer *buf) {
@@ -3954,11 +4083,12 @@ static GstFlowReturn gst_zedsrc_fill(GstPushSrc *psrc, GstBuffer *buf) {
     GstFlowReturn flow_ret = GST_FLOW_OK;
 
     // objects we use later, but must be declared before any goto
-    ZedObjectData obj_data[GST_ZEDSRC_MAX_OBJECTS] = {0};
-    guint8 obj_count = 0;
     guint64 offset = 0;
     GstZedSrcMeta *meta = nullptr;
 
+    ZedTiming timing_data;
+    ZedTiming *timing = nullptr;
+
     sl::RuntimeParameters zedRtParams;
     CUcontext zctx;
 
@@ -3992,6 +4122,11 @@ static GstFlowReturn gst_zedsrc_fill(GstPushSrc *psrc, GstBuffer *buf) {
         src->is_started = TRUE;
     }
 
+    if (src->timing_meta) {
+        timing = &timing_data;
+        gst_zed_timing_reset(timing);
+    }
+
     // ----> Set runtime parameters
     gst_zedsrc_setup_runtime_parameters(src, zedRtParams);
     // <---- Set runtime parameters
@@ -4022,7 +4157,9 @@ static GstFlowReturn gst_zedsrc_fill(GstPushSrc *psrc, GstBuffer *buf) {
     } while (0)
 
     // ----> ZED grab
+    gst_zed_timing_begin(timing, GST_ZED_TIMING_GRAB);
     ret = src->zed.grab(zedRtParams);
+    gst_zed_timing_end(timing, GST_ZED_TIMING_GRAB);
     if (ret > sl::ERROR_CODE::SUCCESS) {
         GST_ELEMENT_ERROR(src, RESOURCE, FAILED,
                           ("Grabbing failed with error: '%s' - %s", sl::toString(ret).c_str(),
@@ -4054,6 +4191,7 @@ static GstFlowReturn gst_zedsrc_fill(GstPushSrc *psrc, GstBuffer *buf) {
     // NOTE: NV12 zero-copy modes (GST_ZEDSRC_RAW_NV12, GST_ZEDSRC_RAW_NV12_RIGHT,
     // GST_ZEDSRC_RAW_NV12_STEREO) are handled by gst_zedsrc_create() which wraps NvBufSurface
     // directly without memcpy. This fill() function only handles non-NVMM stream types.
+    gst_zed_timing_begin(timing, GST_ZED_TIMING_RETRIEVE);
     if (stream_type == GST_ZEDSRC_ONLY_LEFT) {
         CHECK_RET_OR_GOTO(src->zed.retrieveImage(left_img, sl::VIEW::LEFT, sl::MEM::CPU));
     } else if (stream_type == GST_ZEDSRC_ONLY_RIGHT) {
@@ -4066,14 +4204,35 @@ static GstFlowReturn gst_zedsrc_fill(GstPushSrc *psrc, GstBuffer *buf) {
     } else if (stream_type == GST_ZEDSRC_DEPTH_16) {
         CHECK_RET_OR_GOTO(
             src->zed.retrieveMeasure(depth_data, sl::MEASURE::DEPTH_U16_MM, sl::MEM::CPU));
+    } else if (stream_type == GST_ZEDSRC_DEPTH_32F) {
+        CHECK_RET_OR_GOTO(src->zed.retrieveMeasure(depth_data, sl::MEASURE::DEPTH, sl::MEM::CPU));
+    } else if (stream_type == GST_ZEDSRC_CONFIDENCE) {
+        CHECK_RET_OR_GOTO(
+            src->zed.retrieveMeasure(depth_data, sl::MEASURE::CONFIDENCE, sl::MEM::CPU));
     } else if (stream_type == GST_ZEDSRC_LEFT_DEPTH) {
         CHECK_RET_OR_GOTO(src->zed.retrieveImage(left_img, sl::VIEW::LEFT, sl::MEM::CPU));
         CHECK_RET_OR_GOTO(src->zed.retrieveMeasure(depth_data, sl::MEASURE::DEPTH, sl::MEM::CPU));
     }
+    gst_zed_timing_end(timing, GST_ZED_TIMING_RETRIEVE);
 
     /* --- Memory copy into GstBuffer ------------------------------------ */
+    gst_zed_timing_begin(timing, GST_ZED_TIMING_COPY);
     if (stream_type == GST_ZEDSRC_DEPTH_16) {
         memcpy(minfo.data, depth_data.getPtr<sl::ushort1>(), minfo.size);
+    } else if (stream_type == GST_ZEDSRC_DEPTH_32F || stream_type == GST_ZEDSRC_CONFIDENCE) {
+        /* The SDK may pad the measure rows, the buffer rows are tightly packed */
+        gsize height = depth_data.getHeight();
+        gsize stride = minfo.size / height;
+        gsize row_size = MIN(depth_data.getWidthBytes(), stride);
+        gsize step = depth_data.getStepBytes();
+        const guint8 *data = depth_data.getPtr<sl::uchar1>(sl::MEM::CPU);
+        if (step == stride && row_size == stride) {
+            memcpy(minfo.data, data, minfo.size);
+        } else {
+            for (gsize y = 0; y < height; y++) {
+                memcpy(minfo.data + y * stride, data + y * step, row_size);
+            }
+        }
     } else if (stream_type == GST_ZEDSRC_LEFT_RIGHT) {
         /* Left RGB data on half top */
         memcpy(minfo.data, left_img.getPtr<sl::uchar4>(), minfo.size / 2);
@@ -4095,9 +4254,26 @@ static GstFlowReturn gst_zedsrc_fill(GstPushSrc *psrc, GstBuffer *buf) {
     } else {
         memcpy(minfo.data, left_img.getPtr<sl::uchar4>(), minfo.size);
     }
+    gst_zed_timing_end(timing, GST_ZED_TIMING_COPY);
     // <---- Memory copy
 
-    gst_zedsrc_attach_metadata(src, buf, clock_time);
+    gst_zedsrc_attach_metadata(src, buf, clock_time, timing);
+
+    // ----> Request pads
+    // The views already retrieved for the video pad are not retrieved again
+    {
+        sl::Mat *right_view = nullptr;
+        sl::Mat *depth_view = nullptr;
+        if (stream_type == GST_ZEDSRC_LEFT_RIGHT) {
+            right_view = &right_img;
+        } else if (stream_type == GST_ZEDSRC_ONLY_RIGHT) {
+            right_view = &left_img;
+        } else if (stream_type == GST_ZEDSRC_DEPTH_16) {
+            depth_view = &depth_data;
+        }
+        flow_ret = gst_zedsrc_push_request_pads(src, buf, right_view, depth_view);
+    }
+    // <---- Request pads
 
 out:
     if (mapped)
@@ -4187,6 +4363,13 @@ static GstFlowReturn gst_zedsrc_create(GstPushSrc *psrc, GstBuffer **outbuf) {
     GstClockTime clock_time = GST_CLOCK_TIME_NONE;
     CUcontext zctx;
 
+    ZedTiming timing_data;
+    ZedTiming *timing = nullptr;
+    if (src->timing_meta) {
+        timing = &timing_data;
+        gst_zed_timing_reset(timing);
+    }
+
     // Acquisition start time
     if (!src->is_started) {
         GstClock *start_clock = gst_element_get_clock(GST_ELEMENT(src));
@@ -4207,7 +4390,9 @@ static GstFlowReturn gst_zedsrc_create(GstPushSrc *psrc, GstBuffer **outbuf) {
         return GST_FLOW_ERROR;
     }
 
+    gst_zed_timing_begin(timing, GST_ZED_TIMING_GRAB);
     ret = src->zed.grab(zedRtParams);
+    gst_zed_timing_end(timing, GST_ZED_TIMING_GRAB);
     if (ret == sl::ERROR_CODE::END_OF_SVOFILE_REACHED) {
         GST_INFO_OBJECT(src, "End of SVO file");
         cuCtxPopCurrent_v2(NULL);
@@ -4227,7 +4412,9 @@ static GstFlowReturn gst_zedsrc_create(GstPushSrc *psrc, GstBuffer **outbuf) {
 
     // Retrieve RawBuffer - allocate on heap for GstBuffer lifecycle
     sl::RawBuffer *raw_buffer = new sl::RawBuffer();
+    gst_zed_timing_begin(timing, GST_ZED_TIMING_RETRIEVE);
     ret = src->zed.retrieveImage(*raw_buffer);
+    gst_zed_timing_end(timing, GST_ZED_TIMING_RETRIEVE);
     if (ret != sl::ERROR_CODE::SUCCESS) {
         GST_ELEMENT_ERROR(src, RESOURCE, FAILED,
                           ("Failed to retrieve RawBuffer: '%s'", sl::toString(ret).c_str()),
@@ -4471,10 +4658,18 @@ static GstFlowReturn gst_zedsrc_create(GstPushSrc *psrc, GstBuffer **outbuf) {
     }
 
     // Attach Unified Metadata
-    gst_zedsrc_attach_metadata(src, buf, clock_time);
+    gst_zedsrc_attach_metadata(src, buf, clock_time, timing);
+
+    // Views of the request pads
+    flow_ret = gst_zedsrc_push_request_pads(src, buf, NULL, NULL);
 
     cuCtxPopCurrent_v2(NULL);
 
+    if (flow_ret != GST_FLOW_OK) {
+        gst_buffer_unref(buf);
+        return flow_ret;
+    }
+
     if (src->stop_requested) {
         gst_buffer_unref(buf);
         return GST_FLOW_FLUSHING;
@@ -4485,6 +4680,570 @@ static GstFlowReturn gst_zedsrc_create(GstPushSrc *psrc, GstBuffer **outbuf) {
 }
 #endif   // SL_ENABLE_ADVANCED_CAPTURE_API
 
+// ----> Request pads
+// TRUE once the stream-start event of the request `pad` has been pushed
+static gboolean gst_zedsrc_request_pad_started(GstPad *pad) {
+    GstEvent *stream_start = gst_pad_get_sticky_event(pad, GST_EVENT_STREAM_START, 0);
+    if (!stream_start) {
+        return FALSE;
+    }
+    gst_event_unref(stream_start);
+    return TRUE;
+}
+
+static GstPadProbeReturn gst_zedsrc_eos_probe(GstPad *pad, GstPadProbeInfo *info,
+                                              gpointer user_data) {
+    GstZedSrc *src = GST_ZED_SRC(user_data);
+    GstEvent *event = GST_PAD_PROBE_INFO_EVENT(info);
+    GstEventType type = GST_EVENT_TYPE(event);
+
+    // The request pads end and flush with the video stream (num-buffers, end of SVO, seeks)
+    if (type != GST_EVENT_EOS && type != GST_EVENT_FLUSH_START && type != GST_EVENT_FLUSH_STOP) {
+        return GST_PAD_PROBE_OK;
+    }
+
+    GstPad *pads[3];
+    GST_OBJECT_LOCK(src);
+    pads[0] = src->right_pad ? GST_PAD(gst_object_ref(src->right_pad)) : NULL;
+    pads[1] = src->depth_pad ? GST_PAD(gst_object_ref(src->depth_pad)) : NULL;
+    pads[2] = src->data_pad ? GST_PAD(gst_object_ref(src->data_pad)) : NULL;
+    GstPad *sensors_pad = src->sensors_pad ? GST_PAD(gst_object_ref(src->sensors_pad)) : NULL;
+    GST_OBJECT_UNLOCK(src);
+
+    GstSegment segment;
+    gst_segment_init(&segment, GST_FORMAT_TIME);
+
+    switch (type) {
+    case GST_EVENT_EOS:
+        // The sensors task pushes its own EOS once its last batch is sent
+        g_atomic_int_set(&src->sensors_eos, 1);
+        for (guint i = 0; i < G_N_ELEMENTS(pads); i++) {
+            if (pads[i] && gst_zedsrc_request_pad_started(pads[i])) {
+                gst_pad_push_event(pads[i], gst_event_new_eos());
+            }
+        }
+        break;
+    case GST_EVENT_FLUSH_START:
+        for (guint i = 0; i < G_N_ELEMENTS(pads); i++) {
+            if (pads[i]) {
+                gst_pad_push_event(pads[i], gst_event_ref(event));
+            }
+        }
+        if (sensors_pad && GST_PAD_IS_ACTIVE(sensors_pad)) {
+            // Unblock the polling and the downstream push before waiting for the task
+            g_atomic_int_set(&src->sensors_running, 0);
+            gst_pad_push_event(sensors_pad, gst_event_ref(event));
+            gst_pad_pause_task(sensors_pad);
+        }
+        break;
+    case GST_EVENT_FLUSH_STOP:
+        // The flush drops the segment, the caps stay set on the pads
+        for (guint i = 0; i < G_N_ELEMENTS(pads); i++) {
+            if (pads[i]) {
+                gst_pad_push_event(pads[i], gst_event_ref(event));
+                if (gst_zedsrc_request_pad_started(pads[i])) {
+                    gst_pad_push_event(pads[i], gst_event_new_segment(&segment));
+                }
+            }
+        }
+        if (sensors_pad && GST_PAD_IS_ACTIVE(sensors_pad)) {
+            gst_pad_push_event(sensors_pad, gst_event_ref(event));
+            // The task is paused: restart the stream as on activation
+            src->sensors_started = FALSE;
+            g_atomic_int_set(&src->sensors_eos, 0);
+            g_atomic_int_set(&src->sensors_running, 1);
+            gst_pad_start_task(sensors_pad, gst_zedsrc_sensors_loop, sensors_pad, NULL);
+        }
+        break;
+    default:
+        break;
+    }
+
+    for (guint i = 0; i < G_N_ELEMENTS(pads); i++) {
+        if (pads[i]) {
+            gst_object_unref(pads[i]);
+        }
+    }
+    if (sensors_pad) {
+        gst_object_unref(sensors_pad);
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+// Field of the request pad created from the template `name`
+static GstPad **gst_zedsrc_request_pad_field(GstZedSrc *src, const gchar *name) {
+    if (g_strcmp0(name, "right") == 0) {
+        return &src->right_pad;
+    } else if (g_strcmp0(name, "depth") == 0) {
+        return &src->depth_pad;
+    } else if (g_strcmp0(name, "data") == 0) {
+        return &src->data_pad;
+    } else if (g_strcmp0(name, "sensors") == 0) {
+        return &src->sensors_pad;
+    }
+    return NULL;
+}
+
+static GstPad *gst_zedsrc_request_new_pad(GstElement *element, GstPadTemplate *templ,
+                                          const gchar *name, const GstCaps *caps) {
+    GstZedSrc *src = GST_ZED_SRC(element);
+    const gchar *templ_name = GST_PAD_TEMPLATE_NAME_TEMPLATE(templ);
+
+    GST_OBJECT_LOCK(src);
+    GstPad **field = gst_zedsrc_request_pad_field(src, templ_name);
+    if (!field || *field) {
+        GST_OBJECT_UNLOCK(src);
+        GST_WARNING_OBJECT(src, "The '%s' pad is already requested", templ_name);
+        return NULL;
+    }
+    GstPad *pad = gst_pad_new_from_template(templ, templ_name);
+    *field = pad;
+    gboolean add_probe = src->eos_probe == 0;
+    GST_OBJECT_UNLOCK(src);
+
+    // The sensors are pushed by their own task, the other pads by the video streaming thread
+    if (field == &src->sensors_pad) {
+        gst_pad_set_activatemode_function(pad,
+                                          GST_DEBUG_FUNCPTR(gst_zedsrc_sensors_activate_mode));
+    }
+    gst_pad_use_fixed_caps(pad);
+
+    if (add_probe) {
+        src->eos_probe = gst_pad_add_probe(GST_BASE_SRC_PAD(src),
+                                           (GstPadProbeType) (GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM |
+                                                              GST_PAD_PROBE_TYPE_EVENT_FLUSH),
+                                           gst_zedsrc_eos_probe, src, NULL);
+    }
+
+    // Activated here when the element is already running
+    gst_element_add_pad(element, pad);
+
+    GST_INFO_OBJECT(src, "'%s' pad created", templ_name);
+    return pad;
+}
+
+static void gst_zedsrc_release_pad(GstElement *element, GstPad *pad) {
+    GstZedSrc *src = GST_ZED_SRC(element);
+
+    GST_OBJECT_LOCK(src);
+    GstPad **field = gst_zedsrc_request_pad_field(src, GST_PAD_NAME(pad));
+    if (!field || *field != pad) {
+        GST_OBJECT_UNLOCK(src);
+        return;
+    }
+    *field = NULL;
+    gulong probe = 0;
+    if (!src->right_pad && !src->depth_pad && !src->data_pad && !src->sensors_pad) {
+        probe = src->eos_probe;
+        src->eos_probe = 0;
+    }
+    GST_OBJECT_UNLOCK(src);
+
+    if (probe) {
+        gst_pad_remove_probe(GST_BASE_SRC_PAD(src), probe);
+    }
+
+    gst_pad_set_active(pad, FALSE);
+    gst_element_remove_pad(element, pad);
+}
+
+/* Push the stream-start, caps and segment events starting the stream of a request pad. */
+static gboolean gst_zedsrc_request_pad_start(GstZedSrc *src, GstPad *pad, GstCaps *caps) {
+    gchar *stream_id = gst_pad_create_stream_id(pad, GST_ELEMENT(src), GST_PAD_NAME(pad));
+    gst_pad_push_event(pad, gst_event_new_stream_start(stream_id));
+    g_free(stream_id);
+
+    if (!gst_pad_set_caps(pad, caps)) {
+        GST_ELEMENT_ERROR(src, CORE, NEGOTIATION,
+                          ("Failed to set the '%s' pad caps", GST_PAD_NAME(pad)), (NULL));
+        return FALSE;
+    }
+
+    GstSegment segment;
+    gst_segment_init(&segment, GST_FORMAT_TIME);
+    gst_pad_push_event(pad, gst_event_new_segment(&segment));
+    return TRUE;
+}
+
+static GstCaps *gst_zedsrc_request_pad_video_caps(GstZedSrc *src, GstVideoFormat format) {
+    sl::CameraInformation cam_info = src->zed.getCameraInformation();
+    GstVideoInfo vinfo;
+
+    gst_video_info_init(&vinfo);
+    gst_video_info_set_format(&vinfo, format, cam_info.camera_configuration.resolution.width,
+                              cam_info.camera_configuration.resolution.height);
+    vinfo.fps_n = static_cast<gint>(cam_info.camera_configuration.fps);
+    vinfo.fps_d = 1;
+    return gst_video_info_to_caps(&vinfo);
+}
+
+/* Copy `mat` into a new buffer with the timestamps and the metadata of the video buffer `ref`,
+ * and push it on `pad`.
+ */
+static GstFlowReturn gst_zedsrc_push_mat(GstZedSrc *src, GstPad *pad, GstBuffer *ref,
+                                         sl::Mat &mat, GstVideoFormat format) {
+    if (!gst_pad_has_current_caps(pad)) {
+        GstCaps *caps = gst_zedsrc_request_pad_video_caps(src, format);
+        gboolean ok = gst_zedsrc_request_pad_start(src, pad, caps);
+        gst_caps_unref(caps);
+        if (!ok) {
+            return GST_FLOW_NOT_NEGOTIATED;
+        }
+    }
+
+    gsize row_size = mat.getWidthBytes();
+    gsize step = mat.getStepBytes();
+    gsize height = mat.getHeight();
+    GstBuffer *buf = gst_buffer_new_allocate(NULL, row_size * height, NULL);
+    GstMapInfo minfo;
+    if (!gst_buffer_map(buf, &minfo, GST_MAP_WRITE)) {
+        GST_ELEMENT_ERROR(src, RESOURCE, FAILED,
+                          ("Failed to map the '%s' buffer for writing", GST_PAD_NAME(pad)),
+                          (NULL));
+        gst_buffer_unref(buf);
+        return GST_FLOW_ERROR;
+    }
+
+    const guint8 *data = mat.getPtr<sl::uchar1>(sl::MEM::CPU);
+    if (step == row_size) {
+        memcpy(minfo.data, data, minfo.size);
+    } else {
+        for (gsize y = 0; y < height; y++) {
+            memcpy(minfo.data + y * row_size, data + y * step, row_size);
+        }
+    }
+    gst_buffer_unmap(buf, &minfo);
+
+    gst_buffer_copy_into(buf, ref, GST_BUFFER_COPY_METADATA, 0, -1);
+    return gst_pad_push(pad, buf);
+}
+
+static GstFlowReturn gst_zedsrc_push_data(GstZedSrc *src, GstPad *pad, GstBuffer *ref) {
+    GstZedSrcMeta *meta = gst_buffer_get_zed_src_meta(ref);
+    if (!meta) {
+        return GST_FLOW_OK;
+    }
+
+    if (!gst_pad_has_current_caps(pad)) {
+        GstCaps *caps = gst_caps_new_empty_simple("application/data");
+        gboolean ok = gst_zedsrc_request_pad_start(src, pad, caps);
+        gst_caps_unref(caps);
+        if (!ok) {
+            return GST_FLOW_NOT_NEGOTIATED;
+        }
+    }
+
+    GstBuffer *buf = gst_buffer_new_allocate(NULL, gst_zed_src_meta_record_size(meta), NULL);
+    GstMapInfo minfo;
+    if (!gst_buffer_map(buf, &minfo, GST_MAP_WRITE)) {
+        GST_ELEMENT_ERROR(src, RESOURCE, FAILED, ("Failed to map the data buffer for writing"),
+                          (NULL));
+        gst_buffer_unref(buf);
+        return GST_FLOW_ERROR;
+    }
+    gst_zed_src_meta_write_record(meta, minfo.data, minfo.size);
+    gst_buffer_unmap(buf, &minfo);
+
+    gst_buffer_copy_into(buf, ref, GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+    return gst_pad_push(pad, buf);
+}
+
+// Unlinked or ended request pads do not stop the video stream
+static GstFlowReturn gst_zedsrc_combine_flow(GstFlowReturn ret, GstFlowReturn pad_ret) {
+    if (ret != GST_FLOW_OK || pad_ret == GST_FLOW_NOT_LINKED || pad_ret == GST_FLOW_EOS) {
+        return ret;
+    }
+    return pad_ret;
+}
+
+/* Push the views of the `right`, `depth` and `data` request pads for the frame of the video
+ * buffer `buf`. Each view is retrieved once and copied once; `right_img` and `depth_img` are the
+ * views already retrieved for the video pad, or NULL.
+ */
+static GstFlowReturn gst_zedsrc_push_request_pads(GstZedSrc *src, GstBuffer *buf,
+                                                  sl::Mat *right_img, sl::Mat *depth_img) {
+    GST_OBJECT_LOCK(src);
+    GstPad *right_pad = src->right_pad ? GST_PAD(gst_object_ref(src->right_pad)) : NULL;
+    GstPad *depth_pad = src->depth_pad ? GST_PAD(gst_object_ref(src->depth_pad)) : NULL;
+    GstPad *data_pad = src->data_pad ? GST_PAD(gst_object_ref(src->data_pad)) : NULL;
+    GST_OBJECT_UNLOCK(src);
+
+    GstFlowReturn ret = GST_FLOW_OK;
+    sl::ERROR_CODE err;
+    sl::Mat right;
+    sl::Mat depth;
+
+    if (right_pad) {
+        if (!right_img) {
+            err = src->zed.retrieveImage(right, sl::VIEW::RIGHT, sl::MEM::CPU);
+            if (err != sl::ERROR_CODE::SUCCESS) {
+                GST_ELEMENT_ERROR(src, RESOURCE, FAILED,
+                                  ("Failed to retrieve the right image: '%s'",
+                                   sl::toString(err).c_str()),
+                                  (NULL));
+                ret = GST_FLOW_ERROR;
+                goto out;
+            }
+            right_img = &right;
+        }
+        ret = gst_zedsrc_combine_flow(
+            ret, gst_zedsrc_push_mat(src, right_pad, buf, *right_img, GST_VIDEO_FORMAT_BGRA));
+    }
+
+    if (depth_pad && ret == GST_FLOW_OK) {
+        if (!depth_img) {
+            if (src->depth_mode == static_cast<gint>(sl::DEPTH_MODE::NONE)) {
+                GST_ELEMENT_ERROR(src, RESOURCE, SETTINGS,
+                                  ("The 'depth' pad requires a depth mode other than NONE"),
+                                  (NULL));
+                ret = GST_FLOW_ERROR;
+                goto out;
+            }
+            err = src->zed.retrieveMeasure(depth, sl::MEASURE::DEPTH_U16_MM, sl::MEM::CPU);
+            if (err != sl::ERROR_CODE::SUCCESS) {
+                GST_ELEMENT_ERROR(src, RESOURCE, FAILED,
+                                  ("Failed to retrieve the depth map: '%s'",
+                                   sl::toString(err).c_str()),
+                                  (NULL));
+                ret = GST_FLOW_ERROR;
+                goto out;
+            }
+            depth_img = &depth;
+        }
+        ret = gst_zedsrc_combine_flow(ret, gst_zedsrc_push_mat(src, depth_pad, buf, *depth_img,
+                                                               GST_VIDEO_FORMAT_GRAY16_LE));
+    }
+
+    if (data_pad && ret == GST_FLOW_OK) {
+        ret = gst_zedsrc_combine_flow(ret, gst_zedsrc_push_data(src, data_pad, buf));
+    }
+
+out:
+    if (right_pad)
+        gst_object_unref(right_pad);
+    if (depth_pad)
+        gst_object_unref(depth_pad);
+    if (data_pad)
+        gst_object_unref(data_pad);
+
+    return ret;
+}
+// <---- Request pads
+
+// ----> Sensors pad
+// Polling period of the sensors, well below the 2.5 ms period of the 400 Hz IMU
+#define GST_ZEDSRC_SENSORS_POLL_US 1000
+// Polling period while waiting for the first grab
+#define GST_ZEDSRC_SENSORS_WAIT_US 10000
+
+static void gst_zedsrc_sensors_stop(GstZedSrc *src) {
+    GST_OBJECT_LOCK(src);
+    GstPad *pad = src->sensors_pad ? GST_PAD(gst_object_ref(src->sensors_pad)) : NULL;
+    GST_OBJECT_UNLOCK(src);
+
+    if (pad) {
+        g_atomic_int_set(&src->sensors_running, 0);
+        gst_pad_stop_task(pad);
+        gst_object_unref(pad);
+    }
+}
+
+    GstSegment segment;
+    gst_segment_init(&segment, GST_FORMAT_TIME);
+    gst_pad_push_event(pad, gst_event_new_segment(&segment));
+    return TRUE;
+}
+
+/* Fill `samples` with up to `max_count` new IMU samples, polling the latest sensors data of the
+ * camera. Returns early when the task is stopped or the video stream ends.
+ */
+static guint gst_zedsrc_sensors_collect(GstZedSrc *src, GstZedSensorsSample *samples,
+                                        guint max_count) {
+    guint count = 0;
+
+    while (count < max_count && g_atomic_int_get(&src->sensors_running) &&
+           !g_atomic_int_get(&src->sensors_eos)) {
+        sl::SensorsData data;
+        if (src->zed.getSensorsData(data, sl::TIME_REFERENCE::CURRENT) !=
+            sl::ERROR_CODE::SUCCESS) {
+            g_usleep(GST_ZEDSRC_SENSORS_POLL_US);
+            continue;
+        }
+
+        guint64 imu_ts = data.imu.timestamp.getNanoseconds();
+        if (!data.imu.is_available || imu_ts == src->sensors_last_imu_ts) {
+            g_usleep(GST_ZEDSRC_SENSORS_POLL_US);
+            continue;
+        }
+        src->sensors_last_imu_ts = imu_ts;
+
+        // Age of the sample on the SDK clock, applied to the pipeline clock
+        GstClockTime running_time = 0;
+        GstClock *clock = gst_element_get_clock(GST_ELEMENT(src));
+        if (clock) {
+            GstClockTime now = gst_clock_get_time(clock);
+            GstClockTime base_time = gst_element_get_base_time(GST_ELEMENT(src));
+            guint64 sdk_now =
+                src->zed.getTimestamp(sl::TIME_REFERENCE::CURRENT).getNanoseconds();
+            guint64 age = sdk_now > imu_ts ? sdk_now - imu_ts : 0;
+            running_time = now > base_time + age ? now - base_time - age : 0;
+            gst_object_unref(clock);
+        }
+
+        GstZedSensorsSample *sample = &samples[count++];
+        memset(sample, 0, sizeof(GstZedSensorsSample));
+        sample->timestamp = imu_ts;
+        sample->running_time = running_time;
+        sample->acc[0] = data.imu.linear_acceleration.x;
+        sample->acc[1] = data.imu.linear_acceleration.y;
+        sample->acc[2] = data.imu.linear_acceleration.z;
+        sample->gyro[0] = data.imu.angular_velocity.x;
+        sample->gyro[1] = data.imu.angular_velocity.y;
+        sample->gyro[2] = data.imu.angular_velocity.z;
+        sample->flags = GST_ZED_SENSORS_IMU;
+
+        if (data.magnetometer.is_available) {
+            sample->mag[0] = data.magnetometer.magnetic_field_calibrated.x;
+            sample->mag[1] = data.magnetometer.magnetic_field_calibrated.y;
+            sample->mag[2] = data.magnetometer.magnetic_field_calibrated.z;
+            guint64 mag_ts = data.magnetometer.timestamp.getNanoseconds();
+            if (mag_ts != src->sensors_last_mag_ts) {
+                src->sensors_last_mag_ts = mag_ts;
+                sample->flags |= GST_ZED_SENSORS_MAG;
+            }
+        }
+        if (data.barometer.is_available) {
+            sample->pressure = data.barometer.pressure;
+            guint64 baro_ts = data.barometer.timestamp.getNanoseconds();
+            if (baro_ts != src->sensors_last_baro_ts) {
+                src->sensors_last_baro_ts = baro_ts;
+                sample->flags |= GST_ZED_SENSORS_BARO;
+            }
+        }
+    }
+
+    return count;
+}
+
+static void gst_zedsrc_sensors_loop(gpointer user_data) {
+    GstPad *pad = GST_PAD(user_data);
+    GstZedSrc *src = GST_ZED_SRC(GST_PAD_PARENT(pad));
+
+    // ----> Stream start
+    if (!src->sensors_started) {
+        // The camera is open and the clock is running after the first grab
+        if (!src->is_started) {
+            if (g_atomic_int_get(&src->sensors_eos)) {
+                gst_pad_push_event(pad, gst_event_new_eos());
+                gst_pad_pause_task(pad);
+            } else {
+                g_usleep(GST_ZEDSRC_SENSORS_WAIT_US);
+            }
+            return;
+        }
+
+        GstCaps *caps = gst_caps_new_empty_simple(GST_ZED_SENSORS_CAPS_NAME);
+        gboolean ok = gst_zedsrc_request_pad_start(src, pad, caps);
+        gst_caps_unref(caps);
+        if (!ok) {
+            gst_pad_pause_task(pad);
+            return;
+        }
+        src->sensors_started = TRUE;
+
+        if (src->svo_file->len != 0 ||
+            src->zed.getCameraInformation().camera_model == sl::MODEL::ZED) {
+            GST_ELEMENT_WARNING(src, RESOURCE, READ,
+                                ("No high rate sensors data with SVO inputs and ZED cameras"),
+                                (NULL));
+            gst_pad_push_event(pad, gst_event_new_eos());
+            gst_pad_pause_task(pad);
+            return;
+        }
+    }
+    // <---- Stream start
+
+    // ----> Batch
+    guint batch_size = src->sensors_batch_size;
+    GstBuffer *buf =
+        gst_buffer_new_allocate(NULL, batch_size * sizeof(GstZedSensorsSample), NULL);
+    GstMapInfo map;
+    if (!gst_buffer_map(buf, &map, GST_MAP_WRITE)) {
+        gst_buffer_unref(buf);
+        GST_ELEMENT_ERROR(src, RESOURCE, FAILED, ("Failed to map sensors buffer"), (NULL));
+        gst_pad_push_event(pad, gst_event_new_eos());
+        gst_pad_pause_task(pad);
+        return;
+    }
+    GstZedSensorsSample *samples = (GstZedSensorsSample *) map.data;
+    guint count = gst_zedsrc_sensors_collect(src, samples, batch_size);
+    GstClockTime first = count > 0 ? samples[0].running_time : 0;
+    GstClockTime last = count > 0 ? samples[count - 1].running_time : 0;
+    gst_buffer_unmap(buf, &map);
+    // <---- Batch
+
+    if (count > 0) {
+        gst_buffer_set_size(buf, count * sizeof(GstZedSensorsSample));
+        GST_BUFFER_PTS(buf) = first;
+        GST_BUFFER_DTS(buf) = first;
+        GST_BUFFER_DURATION(buf) = last - first;
+        GST_BUFFER_OFFSET(buf) = src->sensors_offset;
+        GST_BUFFER_OFFSET_END(buf) = src->sensors_offset + count;
+        src->sensors_offset += count;
+
+        GST_CAT_LOG_OBJECT(gst_zedsrc_sensors_debug, src,
+                           "%u samples, %" GST_TIME_FORMAT " - %" GST_TIME_FORMAT, count,
+                           GST_TIME_ARGS(first), GST_TIME_ARGS(last));
+
+        GstFlowReturn ret = gst_pad_push(pad, buf);
+        if (ret == GST_FLOW_FLUSHING) {
+            gst_pad_pause_task(pad);
+            return;
+        } else if (ret == GST_FLOW_EOS || ret < GST_FLOW_EOS) {
+            if (ret < GST_FLOW_EOS) {
+                GST_ELEMENT_FLOW_ERROR(src, ret);
+            }
+            gst_pad_push_event(pad, gst_event_new_eos());
+            gst_pad_pause_task(pad);
+            return;
+        }
+        // GST_FLOW_NOT_LINKED: the samples are dropped, keep polling
+    } else {
+        gst_buffer_unref(buf);
+    }
+
+    if (g_atomic_int_get(&src->sensors_eos)) {
+        GST_CAT_DEBUG_OBJECT(gst_zedsrc_sensors_debug, src,
+                             "Video EOS, %" G_GUINT64_FORMAT " samples sent", src->sensors_offset);
+        gst_pad_push_event(pad, gst_event_new_eos());
+        gst_pad_pause_task(pad);
+    }
+}
+
+static gboolean gst_zedsrc_sensors_activate_mode(GstPad *pad, GstObject *parent, GstPadMode mode,
+                                                 gboolean active) {
+    GstZedSrc *src = GST_ZED_SRC(parent);
+
+    if (mode != GST_PAD_MODE_PUSH) {
+        return FALSE;
+    }
+
+    if (!active) {
+        g_atomic_int_set(&src->sensors_running, 0);
+        return gst_pad_stop_task(pad);
+    }
+
+    src->sensors_started = FALSE;
+    src->sensors_last_imu_ts = 0;
+    src->sensors_last_mag_ts = 0;
+    src->sensors_last_baro_ts = 0;
+    src->sensors_offset = 0;
+    g_atomic_int_set(&src->sensors_eos, 0);
+    g_atomic_int_set(&src->sensors_running, 1);
+    return gst_pad_start_task(pad, gst_zedsrc_sensors_loop, pad, NULL);
+}
+// <---- Sensors pad
+
 static gboolean plugin_init(GstPlugin *plugin) {
     GST_DEBUG_CATEGORY_INIT(gst_zedsrc_debug, "zedsrc", 0, "debug category for zedsrc element");
     GST_DEBUG_CATEGORY_INIT(gst_zedsrc_tracking_debug, "zedsrc-tracking", 0,
@@ -4492,6 +5251,8 @@ static gboolean plugin_init(GstPlugin *plugin) {
     GST_DEBUG_CATEGORY_INIT(gst_zedsrc_od_debug, "zedsrc-od", 0, "zedsrc object detection debug");
     GST_DEBUG_CATEGORY_INIT(gst_zedsrc_controls_debug, "zedsrc-controls", 0,
                             "zedsrc camera controls debug");
+    GST_DEBUG_CATEGORY_INIT(gst_zedsrc_sensors_debug, "zedsrc-sensors", 0,
+                            "zedsrc high rate sensors debug");
     gst_element_register(plugin, "zedsrc", GST_RANK_NONE, gst_zedsrc_get_type());
 
     return TRUE;
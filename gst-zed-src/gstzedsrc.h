@@ -35,6 +35,12 @@ G_BEGIN_DECLS
 #define GST_IS_ZED_SRC(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_ZED_SRC))
 #define GST_IS_ZED_SRC_CLASS(obj) (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_ZED_SRC))
 
+/* Float maps of the `Depth map` and `Confidence map` stream types: `height` tightly packed rows of
+ * `width` native endian float32, as retrieved from the SDK. The `measure` field tells the content:
+ * `depth` in millimeters (NaN or +/-inf where it is not measured) or `confidence` in [1, 100].
+ */
+#define GST_ZEDSRC_MEASURE_CAPS_NAME "video/x-zed-measure"
+
 typedef struct _GstZedSrc GstZedSrc;
 typedef struct _GstZedSrcClass GstZedSrcClass;
 
@@ -175,6 +181,9 @@ struct _GstZedSrc {
     GString *svo_rec_filename;
     gint svo_rec_compression;
     gboolean svo_rec_active;   // Internal state: is recording currently active
+
+    gboolean timing_meta;
+    guint sensors_batch_size;
     // <---- Properties
 
     GstClockTime acq_start_time;
@@ -187,6 +196,24 @@ struct _GstZedSrc {
 
     gboolean stop_requested;
 
+    // ----> Request pads, NULL when not requested
+    GstPad *right_pad;     // right image [BGRA]
+    GstPad *depth_pad;     // depth [GRAY16_LE]
+    GstPad *data_pad;      // GstZedSrcMeta records
+    GstPad *sensors_pad;   // high rate sensors samples
+    gulong eos_probe;      // EOS and flush probe on the video pad, forwarded to the request pads
+    // <---- Request pads
+
+    // ----> Sensors pad
+    gint sensors_running;       // polling task allowed to run [atomic]
+    gint sensors_eos;           // video pad reached EOS [atomic]
+    gboolean sensors_started;   // stream-start, caps and segment pushed
+    guint64 sensors_last_imu_ts;
+    guint64 sensors_last_mag_ts;
+    guint64 sensors_last_baro_ts;
+    guint64 sensors_offset;   // samples pushed since the start
+    // <---- Sensors pad
+
 #if defined(SL_ENABLE_ADVANCED_CAPTURE_API) && defined(HAVE_NVBUFSURFTRANSFORM)
     // Reusable destination surfaces for NV12 stereo side-by-side composition
 #define GST_ZEDSRC_STEREO_SBS_POOL_SIZE 4
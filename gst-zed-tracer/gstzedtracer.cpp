@@ -0,0 +1,421 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+/**
+ * The `zedtracer` tracer measures the ZED pipelines without debug logging:
+ *  - processing time of the ZED elements, i.e. time between the arrival of a frame on the sink
+ *    pad and its departure from the source pad
+ *  - queueing delay in `queue`, `queue2` and `multiqueue` elements
+ *  - end-to-end latency from the ZED source to each sink
+ *  - buffer rate and size of the GstZedSrcMeta carried by the buffers
+ *  - processing stages of the ZED sources, if `timing-meta` is enabled
+ * Frames are correlated by their `frame_id` (or buffer offset) and the statistics are logged
+ * periodically as structured tracer records:
+ *
+ *   GST_TRACERS="zedtracer(period=1000)" GST_DEBUG="GST_TRACER:7" gst-launch-1.0 ...
+ */
+
+#include "gstzedtracer.h"
+
+#include <string>
+
+#include "gst-zed-meta/gstzedmeta.h"
+#include "gst-zed-meta/gstzedtimingmeta.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_zed_tracer_debug);
+#define GST_CAT_DEFAULT gst_zed_tracer_debug
+
+#define DEFAULT_PERIOD_MS 1000
+// Bounds of the frame maps: frames dropped or aggregated by an element never leave it
+#define MAX_PENDING_FRAMES 64
+#define MAX_SOURCE_FRAMES 256
+
+typedef enum {
+    ZED_TRACER_UNTRACKED = 0,
+    ZED_TRACER_SOURCE,
+    ZED_TRACER_FILTER,
+    ZED_TRACER_QUEUE,
+    ZED_TRACER_SINK,
+} ZedTracerKind;
+
+static const gchar *kind_names[] = {"untracked", "source", "filter", "queue", "sink"};
+
+struct ZedTracerElementStats {
+    std::string name;
+    ZedTracerKind kind = ZED_TRACER_UNTRACKED;
+
+    // Arrival time of the frames being processed by the element
+    std::unordered_map<guint64, GstClockTime> pending;
+
+    // Counters of the current period
+    guint64 buffers = 0;
+    guint64 time_count = 0;
+    GstClockTime time_sum = 0;
+    GstClockTime time_max = 0;
+    guint64 meta_bytes_sum = 0;
+    guint64 meta_bytes_max = 0;
+    guint64 stage_count[GST_ZED_TIMING_STAGE_COUNT] = {};
+    GstClockTime stage_sum[GST_ZED_TIMING_STAGE_COUNT] = {};
+};
+
+static GstTracerRecord *tr_element;
+static GstTracerRecord *tr_stages;
+
+#define gst_zed_tracer_parent_class parent_class
+G_DEFINE_TYPE(GstZedTracer, gst_zed_tracer, GST_TYPE_TRACER);
+
+// ----> Helpers
+static GstStructure *value_desc(GType type, const gchar *description) {
+    return gst_structure_new("value", "type", G_TYPE_GTYPE, type, "description", G_TYPE_STRING,
+                             description, "related-to", GST_TYPE_TRACER_VALUE_SCOPE,
+                             GST_TRACER_VALUE_SCOPE_ELEMENT, NULL);
+}
+
+static ZedTracerKind element_kind(GstElement *element) {
+    if (GST_IS_BIN(element)) {
+        return ZED_TRACER_UNTRACKED;
+    }
+
+    GstElementFactory *factory = gst_element_get_factory(element);
+    const gchar *name = factory ? gst_plugin_feature_get_name(GST_PLUGIN_FEATURE(factory)) : "";
+    gboolean zed = g_str_has_prefix(name, "zed");
+
+    if (GST_OBJECT_FLAG_IS_SET(element, GST_ELEMENT_FLAG_SINK)) {
+        return ZED_TRACER_SINK;
+    }
+    if (!g_strcmp0(name, "queue") || !g_strcmp0(name, "queue2") ||
+        !g_strcmp0(name, "multiqueue")) {
+        return ZED_TRACER_QUEUE;
+    }
+    if (!zed) {
+        return ZED_TRACER_UNTRACKED;
+    }
+    if (GST_OBJECT_FLAG_IS_SET(element, GST_ELEMENT_FLAG_SOURCE)) {
+        return ZED_TRACER_SOURCE;
+    }
+    return ZED_TRACER_FILTER;
+}
+
+// The entry of a destroyed element is removed, so that a new element allocated at the same
+// address does not inherit its name, kind and pending frames
+static void element_destroyed(gpointer data, GObject *where_the_object_was) {
+    GstZedTracer *self = GST_ZED_TRACER(data);
+
+    g_mutex_lock(&self->lock);
+    self->elements->erase(reinterpret_cast<GstElement *>(where_the_object_was));
+    g_mutex_unlock(&self->lock);
+}
+
+static ZedTracerElementStats *get_stats(GstZedTracer *self, GstElement *element) {
+    auto it = self->elements->find(element);
+    if (it != self->elements->end()) {
+        return &it->second;
+    }
+
+    ZedTracerElementStats &stats = (*self->elements)[element];
+    stats.kind = element_kind(element);
+    stats.name = GST_OBJECT_NAME(element) ? GST_OBJECT_NAME(element) : "";
+    g_object_weak_ref(G_OBJECT(element), element_destroyed, self);
+    return &stats;
+}
+
+// Element owning the pad, NULL for ghost and proxy pads
+static GstElement *pad_element(GstPad *pad) {
+    GstObject *parent = pad ? GST_OBJECT_PARENT(pad) : NULL;
+    if (!parent || !GST_IS_ELEMENT(parent) || GST_IS_BIN(parent)) {
+        return NULL;
+    }
+    return GST_ELEMENT_CAST(parent);
+}
+
+static guint64 frame_key(GstBuffer *buffer) {
+    GstZedSrcMeta *meta = gst_buffer_get_zed_src_meta(buffer);
+    if (meta) {
+        return meta->frame_id;
+    }
+    if (GST_BUFFER_OFFSET_IS_VALID(buffer)) {
+        return GST_BUFFER_OFFSET(buffer);
+    }
+    return GST_BUFFER_PTS(buffer);
+}
+
+static void add_time(ZedTracerElementStats *stats, GstClockTime t) {
+    stats->time_count++;
+    stats->time_sum += t;
+    stats->time_max = MAX(stats->time_max, t);
+}
+
+static void add_buffer(ZedTracerElementStats *stats, GstZedSrcMeta *meta) {
+    guint64 bytes =
+        meta ? sizeof(GstZedSrcMeta) + (guint64) meta->obj_count * sizeof(ZedObjectData) : 0;
+    stats->buffers++;
+    stats->meta_bytes_sum += bytes;
+    stats->meta_bytes_max = MAX(stats->meta_bytes_max, bytes);
+}
+
+static void add_stages(ZedTracerElementStats *stats, GstBuffer *buffer) {
+    GstZedTimingMeta *tmeta = gst_buffer_get_zed_timing_meta(buffer);
+    if (!tmeta) {
+        return;
+    }
+
+    for (int s = 0; s < GST_ZED_TIMING_STAGE_COUNT; s++) {
+        GstClockTime d = gst_zed_timing_duration(&tmeta->timing, (GstZedTimingStage) s);
+        if (GST_CLOCK_TIME_IS_VALID(d)) {
+            stats->stage_count[s]++;
+            stats->stage_sum[s] += d;
+        }
+    }
+}
+
+static guint64 stage_avg(const ZedTracerElementStats &stats, int stage) {
+    return stats.stage_count[stage] ? stats.stage_sum[stage] / stats.stage_count[stage] : 0;
+}
+// <---- Helpers
+
+static void report(GstZedTracer *self, GstClockTime ts) {
+    gdouble elapsed = (gdouble) (ts - self->last_report) / GST_SECOND;
+    self->last_report = ts;
+
+    for (auto &it : *self->elements) {
+        ZedTracerElementStats &stats = it.second;
+        if (stats.kind == ZED_TRACER_UNTRACKED || stats.buffers == 0) {
+            continue;
+        }
+
+        gst_tracer_record_log(tr_element, stats.name.c_str(), kind_names[stats.kind],
+                              stats.buffers, stats.buffers / elapsed,
+                              stats.time_count ? stats.time_sum / stats.time_count : 0,
+                              stats.time_max, stats.meta_bytes_sum / stats.buffers,
+                              stats.meta_bytes_max);
+
+        if (stats.stage_count[GST_ZED_TIMING_METADATA] > 0) {
+            gst_tracer_record_log(tr_stages, stats.name.c_str(),
+                                  stage_avg(stats, GST_ZED_TIMING_GRAB),
+                                  stage_avg(stats, GST_ZED_TIMING_RETRIEVE),
+                                  stage_avg(stats, GST_ZED_TIMING_COPY),
+                                  stage_avg(stats, GST_ZED_TIMING_OBJECTS),
+                                  stage_avg(stats, GST_ZED_TIMING_BODIES),
+                                  stage_avg(stats, GST_ZED_TIMING_METADATA));
+        }
+
+        stats.buffers = 0;
+        stats.time_count = 0;
+        stats.time_sum = 0;
+        stats.time_max = 0;
+        stats.meta_bytes_sum = 0;
+        stats.meta_bytes_max = 0;
+        for (int s = 0; s < GST_ZED_TIMING_STAGE_COUNT; s++) {
+            stats.stage_count[s] = 0;
+            stats.stage_sum[s] = 0;
+        }
+    }
+}
+
+static void do_push_buffer(GstZedTracer *self, GstClockTime ts, GstPad *pad, GstBuffer *buffer) {
+    GstElement *element = pad_element(pad);
+    GstPad *peer = gst_pad_get_peer(pad);
+    GstElement *peer_element = pad_element(peer);
+
+    GstZedSrcMeta *meta = gst_buffer_get_zed_src_meta(buffer);
+    guint64 key = frame_key(buffer);
+
+    g_mutex_lock(&self->lock);
+
+    // ----> Frame leaving an element
+    if (element) {
+        ZedTracerElementStats *stats = get_stats(self, element);
+
+        if (stats->kind != ZED_TRACER_UNTRACKED) {
+            add_buffer(stats, meta);
+
+            auto it = stats->pending.find(key);
+            if (it != stats->pending.end()) {
+                add_time(stats, ts - it->second);
+                stats->pending.erase(it);
+            }
+        }
+
+        if (stats->kind == ZED_TRACER_SOURCE) {
+            if (self->source_times->size() >= MAX_SOURCE_FRAMES) {
+                self->source_times->clear();
+            }
+            (*self->source_times)[key] = ts;
+            add_stages(stats, buffer);
+        }
+    }
+    // <---- Frame leaving an element
+
+    // ----> Frame entering an element
+    if (peer_element) {
+        ZedTracerElementStats *stats = get_stats(self, peer_element);
+
+        if (stats->kind == ZED_TRACER_SINK) {
+            add_buffer(stats, meta);
+
+            auto it = self->source_times->find(key);
+            if (it != self->source_times->end()) {
+                add_time(stats, ts - it->second);
+            }
+        } else if (stats->kind != ZED_TRACER_UNTRACKED) {
+            if (stats->pending.size() >= MAX_PENDING_FRAMES) {
+                stats->pending.clear();
+            }
+            stats->pending[key] = ts;
+        }
+    }
+    // <---- Frame entering an element
+
+    if (!GST_CLOCK_TIME_IS_VALID(self->last_report)) {
+        self->last_report = ts;
+    } else if (ts - self->last_report >= self->period) {
+        report(self, ts);
+    }
+
+    g_mutex_unlock(&self->lock);
+
+    if (peer) {
+        gst_object_unref(peer);
+    }
+}
+
+static void do_push_buffer_pre(GstZedTracer *self, GstClockTime ts, GstPad *pad,
+                               GstBuffer *buffer) {
+    do_push_buffer(self, ts, pad, buffer);
+}
+
+static void do_push_buffer_list_pre(GstZedTracer *self, GstClockTime ts, GstPad *pad,
+                                    GstBufferList *list) {
+    guint len = gst_buffer_list_length(list);
+    for (guint i = 0; i < len; i++) {
+        do_push_buffer(self, ts, pad, gst_buffer_list_get(list, i));
+    }
+}
+
+// Frames entered in a removed element never leave it
+static void do_bin_remove_post(GstZedTracer *self, GstClockTime ts, GstBin *bin,
+                               GstElement *element, gboolean success) {
+    if (!success) {
+        return;
+    }
+
+    g_mutex_lock(&self->lock);
+    auto it = self->elements->find(element);
+    if (it != self->elements->end()) {
+        it->second.pending.clear();
+    }
+    g_mutex_unlock(&self->lock);
+}
+
+static void gst_zed_tracer_constructed(GObject *object) {
+    GstZedTracer *self = GST_ZED_TRACER(object);
+    gchar *params = NULL;
+
+    G_OBJECT_CLASS(parent_class)->constructed(object);
+
+    g_object_get(self, "params", &params, NULL);
+    if (!params) {
+        return;
+    }
+
+    gchar *str = g_strdup_printf("zedtracer,%s", params);
+    GstStructure *s = gst_structure_from_string(str, NULL);
+    if (s) {
+        gint period_ms;
+        if (gst_structure_get_int(s, "period", &period_ms) && period_ms > 0) {
+            self->period = period_ms * GST_MSECOND;
+        }
+        gst_structure_free(s);
+    } else {
+        GST_WARNING_OBJECT(self, "Cannot parse tracer parameters '%s'", params);
+    }
+
+    g_free(str);
+    g_free(params);
+}
+
+static void gst_zed_tracer_finalize(GObject *object) {
+    GstZedTracer *self = GST_ZED_TRACER(object);
+
+    for (auto &it : *self->elements) {
+        g_object_weak_unref(G_OBJECT(it.first), element_destroyed, self);
+    }
+    delete self->elements;
+    delete self->source_times;
+    g_mutex_clear(&self->lock);
+
+    G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
+static void gst_zed_tracer_class_init(GstZedTracerClass *klass) {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->constructed = gst_zed_tracer_constructed;
+    gobject_class->finalize = gst_zed_tracer_finalize;
+
+    tr_element = gst_tracer_record_new(
+        "zed-element.class", "element", value_desc(G_TYPE_STRING, "name of the element"), "kind",
+        value_desc(G_TYPE_STRING, "source, filter, queue or sink"), "buffers",
+        value_desc(G_TYPE_UINT64, "buffers pushed (received by sinks) during the period"), "fps",
+        value_desc(G_TYPE_DOUBLE, "buffer rate [Hz]"), "time-avg",
+        value_desc(G_TYPE_UINT64, "average processing time, queueing delay for queues, "
+                                  "latency from the ZED source for sinks [ns]"),
+        "time-max", value_desc(G_TYPE_UINT64, "maximum of the measured times over the period [ns]"),
+        "meta-bytes-avg", value_desc(G_TYPE_UINT64, "average size of the GstZedSrcMeta [bytes]"),
+        "meta-bytes-max", value_desc(G_TYPE_UINT64, "maximum size of the GstZedSrcMeta [bytes]"),
+        NULL);
+    GST_OBJECT_FLAG_SET(tr_element, GST_OBJECT_FLAG_MAY_BE_LEAKED);
+
+    tr_stages = gst_tracer_record_new(
+        "zed-source-stages.class", "element", value_desc(G_TYPE_STRING, "name of the source"),
+        "grab", value_desc(G_TYPE_UINT64, "average grab time [ns]"), "retrieve",
+        value_desc(G_TYPE_UINT64, "average retrieval time [ns]"), "copy",
+        value_desc(G_TYPE_UINT64, "average copy time [ns]"), "objects",
+        value_desc(G_TYPE_UINT64, "average object detection time [ns]"), "bodies",
+        value_desc(G_TYPE_UINT64, "average body tracking time [ns]"), "metadata",
+        value_desc(G_TYPE_UINT64, "average metadata time [ns]"), NULL);
+    GST_OBJECT_FLAG_SET(tr_stages, GST_OBJECT_FLAG_MAY_BE_LEAKED);
+}
+
+static void gst_zed_tracer_init(GstZedTracer *self) {
+    GstTracer *tracer = GST_TRACER(self);
+
+    g_mutex_init(&self->lock);
+    self->elements = new std::unordered_map<GstElement *, ZedTracerElementStats>();
+    self->source_times = new std::unordered_map<guint64, GstClockTime>();
+    self->last_report = GST_CLOCK_TIME_NONE;
+    self->period = DEFAULT_PERIOD_MS * GST_MSECOND;
+
+    gst_tracing_register_hook(tracer, "pad-push-pre", G_CALLBACK(do_push_buffer_pre));
+    gst_tracing_register_hook(tracer, "pad-push-list-pre", G_CALLBACK(do_push_buffer_list_pre));
+    gst_tracing_register_hook(tracer, "bin-remove-post", G_CALLBACK(do_bin_remove_post));
+}
+
+static gboolean plugin_init(GstPlugin *plugin) {
+    GST_DEBUG_CATEGORY_INIT(gst_zed_tracer_debug, "zedtracer", 0,
+                            "debug category for zedtracer tracer");
+
+    return gst_tracer_register(plugin, "zedtracer", gst_zed_tracer_get_type());
+}
+
+GST_PLUGIN_DEFINE(GST_VERSION_MAJOR, GST_VERSION_MINOR, zedtracer,
+                  "ZED pipelines latency and throughput tracer", plugin_init, GST_PACKAGE_VERSION,
+                  GST_PACKAGE_LICENSE, GST_PACKAGE_NAME, GST_PACKAGE_ORIGIN)
@@ -0,0 +1,68 @@
+// /////////////////////////////////////////////////////////////////////////
+
+//
+// Copyright (c) 2024, STEREOLABS.
+//
+// All rights reserved.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// /////////////////////////////////////////////////////////////////////////
+
+#ifndef _GST_ZED_TRACER_H
+#define _GST_ZED_TRACER_H
+
+#include <gst/gst.h>
+
+#include <unordered_map>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_ZED_TRACER (gst_zed_tracer_get_type())
+#define GST_ZED_TRACER(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_ZED_TRACER, GstZedTracer))
+#define GST_ZED_TRACER_CLASS(klass)                                                                \
+    (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_ZED_TRACER, GstZedTracerClass))
+#define GST_IS_ZED_TRACER(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_ZED_TRACER))
+#define GST_IS_ZED_TRACER_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_ZED_TRACER))
+#define GST_ZED_TRACER_CAST(obj) ((GstZedTracer *) (obj))
+
+typedef struct _GstZedTracer GstZedTracer;
+typedef struct _GstZedTracerClass GstZedTracerClass;
+
+struct ZedTracerElementStats;
+
+struct _GstZedTracer {
+    GstTracer parent;
+
+    GMutex lock;
+
+    // Statistics of the elements seen in the pipeline, untracked elements included
+    std::unordered_map<GstElement *, ZedTracerElementStats> *elements;
+    // Time at which each frame left a ZED source, for the end-to-end latency
+    std::unordered_map<guint64, GstClockTime> *source_times;
+
+    GstClockTime last_report;
+
+    // Parameters
+    GstClockTime period;
+};
+
+struct _GstZedTracerClass {
+    GstTracerClass parent_class;
+};
+
+G_GNUC_INTERNAL GType gst_zed_tracer_get_type(void);
+
+G_END_DECLS
+
+#endif   // #ifndef _GST_ZED_TRACER_H